@@ -11,6 +11,8 @@
 #include "utils.h"
 #include "appmultiitem.h"
 #include "quicksettingcontroller.h"
+#include "spantracer.h"
+#include "entrypropertycache.h"
 
 #include <QDebug>
 #include <QGSettings>
@@ -27,11 +29,16 @@ DockItemManager::DockItemManager(QObject *parent)
     , m_appInter(new DockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus(), this))
     , m_loadFinished(false)
 {
+    DOCK_TRACE_SCOPE("DockItemManager::DockItemManager");
+
     //固定区域：启动器
     m_itemList.append(new LauncherItem);
 
-    // 应用区域
-    for (auto entry : m_appInter->entries()) {
+    // 应用区域，先一次性获取所有应用的属性，创建应用时不再逐个同步读取
+    const QList<QDBusObjectPath> &entries = m_appInter->entries();
+    EntryPropertyCache::instance()->prefetch(entries);
+    for (auto entry : entries) {
+        DOCK_TRACE_SCOPE_ARG("DockItemManager::loadEntry", entry.path());
         AppItem *it = new AppItem(m_appInter, m_appSettings, m_activeSettings, m_dockedSettings, entry);
         manageItem(it);
 
@@ -255,7 +262,9 @@ void DockItemManager::reloadAppItems()
             appItemRemoved(static_cast<AppItem *>(item.data()));
 
     // append new item
-    for (auto path : m_appInter->entries())
+    const QList<QDBusObjectPath> &entries = m_appInter->entries();
+    EntryPropertyCache::instance()->prefetch(entries);
+    for (auto path : entries)
         appItemAdded(path, -1);
 }
 
@@ -352,6 +361,7 @@ void DockItemManager::onPluginUpdate(PluginsItemInterface *itemInter)
 
 void DockItemManager::onPluginLoadFinished()
 {
+    SpanTracer::instance()->addInstant("pluginLoaderFinished");
     updatePluginsItemOrderKey();
     m_loadFinished = true;
 }
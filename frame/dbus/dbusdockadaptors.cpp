@@ -27,6 +27,10 @@
 #include "pluginsitem.h"
 #include "settingconfig.h"
 #include "customevent.h"
+#include "spantracer.h"
+#include "paintprofiler.h"
+#include "dbusstatistics.h"
+#include "pluginloader.h"
 
 #include <DGuiApplicationHelper>
 
@@ -280,6 +284,64 @@ void DBusDockAdaptors::setItemOnDock(const QString settingKey, const QString &it
     SETTINGCONFIG->setValue(settingKey, settings);
 }
 
+void DBusDockAdaptors::setTraceEnabled(bool enabled)
+{
+    SpanTracer::instance()->setEnabled(enabled);
+    DBusStatistics::instance()->onTraceEnabledChanged(enabled);
+}
+
+/**
+ * @brief DBusDockAdaptors::dumpTrace 将耗时跟踪记录导出为Chrome trace格式
+ * @param fileName 导出的文件路径
+ * @return 是否导出成功
+ */
+bool DBusDockAdaptors::dumpTrace(const QString &fileName)
+{
+    return SpanTracer::instance()->dump(fileName);
+}
+
+/**
+ * @brief DBusDockAdaptors::paintProfile 获取各个图标的绘制耗时、重绘次数和布局次数
+ * @return JSON格式的统计结果，按照重绘次数从多到少排序
+ */
+QString DBusDockAdaptors::paintProfile()
+{
+    return PaintProfiler::instance()->report();
+}
+
+void DBusDockAdaptors::resetPaintProfile()
+{
+    PaintProfiler::instance()->reset();
+}
+
+/**
+ * @brief DBusDockAdaptors::dbusStatistics 获取任务栏发出的DBus调用和收到的信号的统计
+ * @return JSON格式的统计结果，按照调用和信号的总次数从多到少排序
+ */
+QString DBusDockAdaptors::dbusStatistics()
+{
+    return DBusStatistics::instance()->report();
+}
+
+void DBusDockAdaptors::dumpDBusStatistics()
+{
+    DBusStatistics::instance()->dumpToLog();
+}
+
+void DBusDockAdaptors::resetDBusStatistics()
+{
+    DBusStatistics::instance()->reset();
+}
+
+/**
+ * @brief DBusDockAdaptors::pluginTimings 获取各个插件动态库的加载耗时和初始化耗时
+ * @return JSON格式的统计结果
+ */
+QString DBusDockAdaptors::pluginTimings()
+{
+    return PluginLoader::timingReport();
+}
+
 QRect DBusDockAdaptors::geometry() const
 {
     return m_windowManager->geometry();
@@ -95,6 +95,25 @@ class DBusDockAdaptors: public QDBusAbstractAdaptor
                                        "        <arg name=\"itemKey\" type=\"s\" direction=\"in\"/>"
                                        "        <arg name=\"visible\" type=\"b\" direction=\"in\"/>"
                                        "    </method>"
+                                       "    <method name=\"setTraceEnabled\">"
+                                       "        <arg name=\"enabled\" type=\"b\" direction=\"in\"/>"
+                                       "    </method>"
+                                       "    <method name=\"dumpTrace\">"
+                                       "        <arg name=\"fileName\" type=\"s\" direction=\"in\"/>"
+                                       "        <arg name=\"success\" type=\"b\" direction=\"out\"/>"
+                                       "    </method>"
+                                       "    <method name=\"paintProfile\">"
+                                       "        <arg name=\"report\" type=\"s\" direction=\"out\"/>"
+                                       "    </method>"
+                                       "    <method name=\"resetPaintProfile\"/>"
+                                       "    <method name=\"dbusStatistics\">"
+                                       "        <arg name=\"report\" type=\"s\" direction=\"out\"/>"
+                                       "    </method>"
+                                       "    <method name=\"dumpDBusStatistics\"/>"
+                                       "    <method name=\"resetDBusStatistics\"/>"
+                                       "    <method name=\"pluginTimings\">"
+                                       "        <arg name=\"report\" type=\"s\" direction=\"out\"/>"
+                                       "    </method>"
                                        "    <signal name=\"pluginVisibleChanged\">"
                                        "        <arg type=\"s\"/>"
                                        "        <arg type=\"b\"/>"
@@ -123,6 +142,18 @@ public Q_SLOTS: // METHODS
     void setPluginVisible(const QString &pluginName, bool visible);
     void setItemOnDock(const QString settingKey, const QString &itemKey, bool visible);
 
+    void setTraceEnabled(bool enabled);
+    bool dumpTrace(const QString &fileName);
+
+    QString paintProfile();
+    void resetPaintProfile();
+
+    QString dbusStatistics();
+    void dumpDBusStatistics();
+    void resetDBusStatistics();
+
+    QString pluginTimings();
+
 public: // PROPERTIES
     QRect geometry() const;
 
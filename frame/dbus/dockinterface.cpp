@@ -20,6 +20,7 @@
  */
 
 #include "dockinterface.h"
+#include "dockpropertystore.h"
 
 #include "org_deepin_dde_daemon_dock1.h"
 
@@ -89,14 +90,14 @@ public Q_SLOTS: // METHODS
 
     inline QDBusPendingReply<> CancelPreviewWindow()
     {
-        return asyncCallWithArgumentList(QStringLiteral("CancelPreviewWindow"), QList<QVariant>());
+        return DBusStatistics::asyncCall(this, QStringLiteral("CancelPreviewWindow"), QList<QVariant>());
     }
 
     inline QDBusPendingReply<> PreviewWindow(uint in0)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("PreviewWindow"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("PreviewWindow"), argumentList);
     }
 
 private:
@@ -118,11 +119,9 @@ Dde_Dock::Dde_Dock(const QString &service, const QString &path, const QDBusConne
     , d_ptr(new DockPrivate)
     , m_wm(new WM("com.deepin.wm", "/com/deepin/wm", QDBusConnection::sessionBus(), this))
 {
-    QDBusConnection::sessionBus().connect(this->service(), this->path(),
-                                          "org.freedesktop.DBus.Properties",
-                                          "PropertiesChanged","sa{sv}as",
-                                          this,
-                                          SLOT(onPropertyChanged(const QDBusMessage &)));
+    // 属性统一由DockPropertyStore缓存，所有实例共用一次GetAll，之后的读取不再访问后端
+    connect(DockPropertyStore::instance(), &DockPropertyStore::propertyChanged, this, &Dde_Dock::onPropertyChanged);
+    DBusStatistics::watchSignals(this);
 
     if (QMetaType::type("DockRect") == QMetaType::UnknownType)
         registerDockRectMetaType();
@@ -134,156 +133,161 @@ Dde_Dock::~Dde_Dock()
     delete d_ptr;
 }
 
-void Dde_Dock::onPropertyChanged(const QDBusMessage& msg)
+/**
+ * @brief Dde_Dock::onPropertyChanged 缓存中的属性变化后，发出属性对应的带参数的通知信号
+ */
+void Dde_Dock::onPropertyChanged(const QString &name, const QVariant &value)
 {
-    QList<QVariant> arguments = msg.arguments();
-    if (3 != arguments.count())
+    const QMetaObject *self = metaObject();
+    const int index = self->indexOfProperty(name.toLatin1().constData());
+    if (index < self->propertyOffset())
         return;
 
-    QString interfaceName = msg.arguments().at(0).toString();
-    if (interfaceName != staticInterfaceName())
+    const QMetaProperty p = self->property(index);
+    if (!p.hasNotifySignal())
         return;
 
-    QVariantMap changedProps = qdbus_cast<QVariantMap>(arguments.at(1).value<QDBusArgument>());
-    QStringList keys = changedProps.keys();
-    foreach(const QString &prop, keys) {
-    const QMetaObject* self = metaObject();
-        for (int i=self->propertyOffset(); i < self->propertyCount(); ++i) {
-            QMetaProperty p = self->property(i);
-            if (p.name() == prop)
-                Q_EMIT p.notifySignal().invoke(this);
-        }
+    const QMetaMethod notifySignal = p.notifySignal();
+    if (notifySignal.parameterCount() == 0) {
+        notifySignal.invoke(this);
+        return;
     }
+
+    QVariant argument = value;
+    if (argument.userType() != p.userType())
+        argument.convert(p.userType());
+
+    notifySignal.invoke(this, QGenericArgument(argument.typeName(), argument.constData()));
 }
 
 int Dde_Dock::displayMode()
 {
-    return qvariant_cast<int>(property("DisplayMode"));
+    return qvariant_cast<int>(DockPropertyStore::instance()->value("DisplayMode"));
 }
 
 void Dde_Dock::setDisplayMode(int value)
 {
-    setProperty("DisplayMode", QVariant::fromValue(value));
+    DockPropertyStore::instance()->setValue(this, "DisplayMode", QVariant::fromValue(value));
 }
 
 QStringList Dde_Dock::dockedApps()
 {
-    return qvariant_cast<QStringList>(property("DockedApps"));
+    return qvariant_cast<QStringList>(DockPropertyStore::instance()->value("DockedApps"));
 }
 
 QList<QDBusObjectPath> Dde_Dock::entries()
 {
-    return qvariant_cast<QList<QDBusObjectPath>>(property("Entries"));
+    return qvariant_cast<QList<QDBusObjectPath>>(DockPropertyStore::instance()->value("Entries"));
 }
 
 DockRect Dde_Dock::frontendWindowRect()
 {
-    return qvariant_cast<DockRect>(property("FrontendWindowRect"));
+    return qvariant_cast<DockRect>(DockPropertyStore::instance()->value("FrontendWindowRect"));
 }
 
 int Dde_Dock::hideMode()
 {
-    return qvariant_cast<int>(property("HideMode"));
+    return qvariant_cast<int>(DockPropertyStore::instance()->value("HideMode"));
 }
 
 void Dde_Dock::setHideMode(int value)
 {
-   internalPropSet("HideMode", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "HideMode", QVariant::fromValue(value));
 }
 
 int Dde_Dock::hideState()
 {
-    return qvariant_cast<int>(property("HideState"));
+    return qvariant_cast<int>(DockPropertyStore::instance()->value("HideState"));
 }
 
 uint Dde_Dock::hideTimeout()
 {
-    return qvariant_cast<uint>(property("HideTimeout"));
+    return qvariant_cast<uint>(DockPropertyStore::instance()->value("HideTimeout"));
 }
 
 void Dde_Dock::setHideTimeout(uint value)
 {
-   setProperty("HideTimeout", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "HideTimeout", QVariant::fromValue(value));
 }
 
 uint Dde_Dock::iconSize()
 {
-    return qvariant_cast<uint>(property("IconSize"));
+    return qvariant_cast<uint>(DockPropertyStore::instance()->value("IconSize"));
 }
 
 void Dde_Dock::setIconSize(uint value)
 {
-   setProperty("IconSize", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "IconSize", QVariant::fromValue(value));
 }
 
 double Dde_Dock::opacity()
 {
-    return qvariant_cast<double>(property("Opacity"));
+    return qvariant_cast<double>(DockPropertyStore::instance()->value("Opacity"));
 }
 
 void Dde_Dock::setOpacity(double value)
 {
-   setProperty("Opacity", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "Opacity", QVariant::fromValue(value));
 }
 
 int Dde_Dock::position()
 {
-    return qvariant_cast<int>(property("Position"));
+    return qvariant_cast<int>(DockPropertyStore::instance()->value("Position"));
 }
 
 void Dde_Dock::setPosition(int value)
 {
-   setProperty("Position", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "Position", QVariant::fromValue(value));
 }
 
 uint Dde_Dock::showTimeout()
 {
-    return qvariant_cast<uint>(property("ShowTimeout"));
+    return qvariant_cast<uint>(DockPropertyStore::instance()->value("ShowTimeout"));
 }
 
 void Dde_Dock::setShowTimeout(uint value)
 {
-   setProperty("ShowTimeout", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "ShowTimeout", QVariant::fromValue(value));
 }
 
 uint Dde_Dock::windowSize()
 {
-    return qvariant_cast<uint>(property("WindowSize"));
+    return qvariant_cast<uint>(DockPropertyStore::instance()->value("WindowSize"));
 }
 
 void Dde_Dock::setWindowSize(uint value)
 {
-   setProperty("WindowSize", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "WindowSize", QVariant::fromValue(value));
 }
 
 uint Dde_Dock::windowSizeEfficient()
 {
-    return qvariant_cast<uint>(property("WindowSizeEfficient"));
+    return qvariant_cast<uint>(DockPropertyStore::instance()->value("WindowSizeEfficient"));
 }
 
 void Dde_Dock::setWindowSizeEfficient(uint value)
 {
-   setProperty("WindowSizeEfficient", QVariant::fromValue(value));
+   DockPropertyStore::instance()->setValue(this, "WindowSizeEfficient", QVariant::fromValue(value));
 }
 
 uint Dde_Dock::windowSizeFashion()
 {
-    return qvariant_cast<uint>(property("WindowSizeFashion"));
+    return qvariant_cast<uint>(DockPropertyStore::instance()->value("WindowSizeFashion"));
 }
 
 void Dde_Dock::setWindowSizeFashion(uint value)
 {
-    setProperty("WindowSizeFashion", QVariant::fromValue(value));
+    DockPropertyStore::instance()->setValue(this, "WindowSizeFashion", QVariant::fromValue(value));
 }
 
 bool Dde_Dock::showRecent() const
 {
-    return qvariant_cast<bool>(property("ShowRecent"));
+    return qvariant_cast<bool>(DockPropertyStore::instance()->value("ShowRecent"));
 }
 
 bool Dde_Dock::showMultiWindow() const
 {
-    return qvariant_cast<bool>(property("ShowMultiWindow"));
+    return qvariant_cast<bool>(DockPropertyStore::instance()->value("ShowMultiWindow"));
 }
 
 QDBusPendingReply<> Dde_Dock::ActivateWindow(uint in0)
@@ -316,7 +320,7 @@ void Dde_Dock::CallQueued(const QString &callName, const QList<QVariant> &args)
     if (d_ptr->m_processingCalls.contains(callName)) {
         d_ptr->m_waittingCalls.insert(callName, args);
     } else {
-        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(asyncCallWithArgumentList(callName, args));
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusStatistics::asyncCall(this, callName, args));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, &Dde_Dock::onPendingCallFinished);
         d_ptr->m_processingCalls.insert(callName, watcher);
     }
@@ -23,6 +23,7 @@
 #define DOCK_INTERFACE
 
 #include "types/dockrect.h"
+#include "dbusstatistics.h"
 
 #include <QObject>
 #include <QByteArray>
@@ -133,7 +134,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("CloseWindow"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("CloseWindow"), argumentList);
     }
 
     inline void CloseWindowQueued(uint in0)
@@ -147,40 +148,40 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<QStringList> GetDockedAppsDesktopFiles()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("GetDockedAppsDesktopFiles"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("GetDockedAppsDesktopFiles"), argumentList);
     }
 
     inline QDBusPendingReply<QStringList> GetEntryIDs()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("GetEntryIDs"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("GetEntryIDs"), argumentList);
     }
 
     inline QDBusPendingReply<QString> GetPluginSettings()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("GetPluginSettings"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("GetPluginSettings"), argumentList);
     }
 
     inline QDBusPendingReply<bool> IsDocked(const QString &in0)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("IsDocked"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("IsDocked"), argumentList);
     }
 
     inline QDBusPendingReply<bool> IsOnDock(const QString &in0)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("IsOnDock"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("IsOnDock"), argumentList);
     }
 
     inline QDBusPendingReply<> MergePluginSettings(const QString &in0)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("MergePluginSettings"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("MergePluginSettings"), argumentList);
     }
 
     inline void MergePluginSettingsQueued(const QString &in0)
@@ -195,7 +196,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1);
-        return asyncCallWithArgumentList(QStringLiteral("MoveEntry"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("MoveEntry"), argumentList);
     }
 
     inline void MoveEntryQueued(int in0, int in1)
@@ -218,14 +219,14 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("QueryWindowIdentifyMethod"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("QueryWindowIdentifyMethod"), argumentList);
     }
 
     inline QDBusPendingReply<> RemovePluginSettings(const QString &in0, const QStringList &in1)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1);
-        return asyncCallWithArgumentList(QStringLiteral("RemovePluginSettings"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RemovePluginSettings"), argumentList);
     }
 
     inline void RemovePluginSettingsQueued(const QString &in0, const QStringList &in1)
@@ -240,14 +241,14 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1);
-        return asyncCallWithArgumentList(QStringLiteral("RequestDock"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RequestDock"), argumentList);
     }
 
     inline QDBusPendingReply<bool> RequestUndock(const QString &in0)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("RequestUndock"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RequestUndock"), argumentList);
     }
 
     inline void SetShowRecent(bool in0)
@@ -262,7 +263,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1) << QVariant::fromValue(in2) << QVariant::fromValue(in3);
-        return asyncCallWithArgumentList(QStringLiteral("SetFrontendWindowRect"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("SetFrontendWindowRect"), argumentList);
     }
 
     inline void SetFrontendWindowRectQueued(int in0, int in1, uint in2, uint in3)
@@ -277,7 +278,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("SetPluginSettings"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("SetPluginSettings"), argumentList);
     }
 
     inline void SetPluginSettingsQueued(const QString &in0)
@@ -317,7 +318,7 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void onPendingCallFinished(QDBusPendingCallWatcher *w);
-    void onPropertyChanged(const QDBusMessage& msg);
+    void onPropertyChanged(const QString &name, const QVariant &value);
 
 private:
     DockPrivate *d_ptr;
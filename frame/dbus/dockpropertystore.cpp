@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dockpropertystore.h"
+#include "dbusutil.h"
+#include "sharedinstance.h"
+
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+
+#define PROPERTIES_INTERFACE "org.freedesktop.DBus.Properties"
+#define DOCK_PROPERTY_STORE_PROPERTY "_dock_property_store"
+
+DockPropertyStore::DockPropertyStore(QObject *parent)
+    : QObject(parent)
+    , m_loaded(false)
+    , m_loadWatcher(nullptr)
+{
+    if (QMetaType::type("DockRect") == QMetaType::UnknownType)
+        registerDockRectMetaType();
+
+    QDBusConnection::sessionBus().connect(dockServiceName(), dockServicePath(), PROPERTIES_INTERFACE, "PropertiesChanged",
+                                          this, SLOT(onPropertiesChanged(const QDBusMessage &)));
+
+    // 后端重启后属性可能已经变化，重新获取一次
+    QDBusServiceWatcher *serviceWatcher = new QDBusServiceWatcher(dockServiceName(), QDBusConnection::sessionBus(),
+                                                                  QDBusServiceWatcher::WatchForRegistration, this);
+    connect(serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this, &DockPropertyStore::load);
+
+    load();
+}
+
+DockPropertyStore *DockPropertyStore::instance()
+{
+    static DockPropertyStore *store = Utils::sharedInstance<DockPropertyStore>(DOCK_PROPERTY_STORE_PROPERTY, [] { return new DockPropertyStore(qApp); });
+
+    return store;
+}
+
+/**
+ * @brief DockPropertyStore::value 获取属性的值，只读取缓存，属性还没有获取到时返回无效值(转换后为默认值)
+ */
+QVariant DockPropertyStore::value(const QString &name)
+{
+    return m_properties.value(name);
+}
+
+/**
+ * @brief DockPropertyStore::setValue 设置后端的属性，设置成功后立即更新缓存，
+ * 后端发出的PropertiesChanged信号中的值相同，不会再次通知
+ */
+bool DockPropertyStore::setValue(QDBusAbstractInterface *inter, const char *name, const QVariant &value)
+{
+    if (!DBusStatistics::setProperty(inter, name, value))
+        return false;
+
+    update({ { QString::fromLatin1(name), value } });
+    return true;
+}
+
+/**
+ * @brief DockPropertyStore::load 异步获取所有属性，获取完成后通知发生变化的属性
+ */
+void DockPropertyStore::load()
+{
+    // 后端重启时之前的调用已经没有意义，以新的调用为准
+    delete m_loadWatcher;
+
+    QDBusMessage message = QDBusMessage::createMethodCall(dockServiceName(), dockServicePath(), PROPERTIES_INTERFACE, "GetAll");
+    message << dockServiceName();
+
+    m_loadWatcher = new QDBusPendingCallWatcher(DBusStatistics::watch(QDBusConnection::sessionBus().asyncCall(message), dockServiceName(), "GetAll"), this);
+    connect(m_loadWatcher, &QDBusPendingCallWatcher::finished, this, &DockPropertyStore::onLoadFinished);
+}
+
+void DockPropertyStore::onLoadFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+    m_loadWatcher = nullptr;
+
+    QDBusPendingReply<QVariantMap> reply = *watcher;
+    if (reply.isError()) {
+        // 获取失败时继续使用当前的值，等后端重新注册后再获取
+        qWarning() << "get dock properties failed:" << reply.error().message();
+        return;
+    }
+
+    m_loaded = true;
+    update(reply.value());
+}
+
+/**
+ * @brief DockPropertyStore::update 更新缓存，只通知值发生变化的属性
+ */
+void DockPropertyStore::update(const QVariantMap &properties)
+{
+    for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+        const QVariant &value = demarshall(it.key(), it.value());
+        auto cached = m_properties.find(it.key());
+        if (cached != m_properties.end() && cached.value() == value)
+            continue;
+
+        m_properties.insert(it.key(), value);
+        Q_EMIT propertyChanged(it.key(), value);
+    }
+}
+
+/**
+ * @brief DockPropertyStore::demarshall 自定义类型的属性在返回的QVariantMap中是QDBusArgument，转换为实际的类型
+ */
+QVariant DockPropertyStore::demarshall(const QString &name, const QVariant &value)
+{
+    if (value.userType() != qMetaTypeId<QDBusArgument>())
+        return value;
+
+    if (name == "FrontendWindowRect")
+        return QVariant::fromValue(qdbus_cast<DockRect>(value));
+
+    if (name == "Entries")
+        return QVariant::fromValue(qdbus_cast<QList<QDBusObjectPath>>(value));
+
+    return value;
+}
+
+void DockPropertyStore::onPropertiesChanged(const QDBusMessage &message)
+{
+    const QList<QVariant> &arguments = message.arguments();
+    if (arguments.size() != 3 || arguments.at(0).toString() != dockServiceName())
+        return;
+
+    DBusStatistics::instance()->recordSignal(dockServiceName(), "PropertiesChanged");
+
+    // 信号中是最新的值，GetAll还没有返回时也先更新
+    update(qdbus_cast<QVariantMap>(arguments.at(1)));
+}
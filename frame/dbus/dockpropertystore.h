@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DOCKPROPERTYSTORE_H
+#define DOCKPROPERTYSTORE_H
+
+#include <QObject>
+#include <QVariantMap>
+
+class QDBusAbstractInterface;
+class QDBusMessage;
+class QDBusPendingCallWatcher;
+
+/**
+ * @brief The DockPropertyStore class
+ * 后端Dock1服务属性的进程内缓存，创建时(以及后端重启时)异步调用一次GetAll获取所有属性，之后根据PropertiesChanged信号更新，
+ * 所有Dde_Dock代理的属性读取都直接返回缓存，获取完成之前返回默认值，绘制和布局过程中不会等待后端
+ */
+class DockPropertyStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DockPropertyStore *instance();
+
+    QVariant value(const QString &name);
+    bool setValue(QDBusAbstractInterface *inter, const char *name, const QVariant &value);
+
+Q_SIGNALS:
+    void propertyChanged(const QString &name, const QVariant &value) const;
+
+private:
+    explicit DockPropertyStore(QObject *parent = nullptr);
+
+    void load();
+    void update(const QVariantMap &properties);
+    static QVariant demarshall(const QString &name, const QVariant &value);
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QDBusMessage &message);
+    void onLoadFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    QVariantMap m_properties;
+    bool m_loaded;
+    QDBusPendingCallWatcher *m_loadWatcher;     // 正在进行的GetAll调用
+
+};
+
+#endif // DOCKPROPERTYSTORE_H
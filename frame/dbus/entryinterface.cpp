@@ -20,6 +20,7 @@
  */
 
 #include "entryinterface.h"
+#include "entrypropertycache.h"
 
 /*
  * Implementation of interface class __Entry
@@ -108,24 +109,38 @@ Dock_Entry::Dock_Entry(const QString &service, const QString &path, const QDBusC
     : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
     , d_ptr(new EntryPrivate)
 {
-    QDBusConnection::sessionBus().connect(this->service(), this->path(),
-                                          "org.freedesktop.DBus.Properties",
-                                          "PropertiesChanged","sa{sv}as",
-                                          this,
-                                          SLOT(onPropertyChanged(const QDBusMessage &)));
-
     if (QMetaType::type("WindowList") == QMetaType::UnknownType)
         registerWindowListMetaType();
     if (QMetaType::type("WindowInfoMap") == QMetaType::UnknownType)
         registerWindowInfoMapMetaType();
+
+    // 属性从共用的缓存中读取，缓存根据PropertiesChanged信号更新后再通知这里
+    const QVariantMap &properties = EntryPropertyCache::instance()->acquire(this);
+    d_ptr->CurrentWindow = qvariant_cast<uint>(properties.value("CurrentWindow"));
+    d_ptr->DesktopFile = qvariant_cast<QString>(properties.value("DesktopFile"));
+    d_ptr->Icon = qvariant_cast<QString>(properties.value("Icon"));
+    d_ptr->Id = qvariant_cast<QString>(properties.value("Id"));
+    d_ptr->IsActive = qvariant_cast<bool>(properties.value("IsActive"));
+    d_ptr->IsDocked = qvariant_cast<bool>(properties.value("IsDocked"));
+    d_ptr->Menu = qvariant_cast<QString>(properties.value("Menu"));
+    d_ptr->Name = qvariant_cast<QString>(properties.value("Name"));
+    d_ptr->WindowInfos = qvariant_cast<WindowInfoMap>(properties.value("WindowInfos"));
+    d_ptr->mode = qvariant_cast<int>(properties.value("Mode"));
 }
 
 Dock_Entry::~Dock_Entry()
 {
+    EntryPropertyCache::instance()->release(this);
     qDeleteAll(d_ptr->m_processingCalls.values());
     delete d_ptr;
 }
 
+void Dock_Entry::onPropertiesChanged(const QVariantMap &changedProperties)
+{
+    for (auto it = changedProperties.constBegin(); it != changedProperties.constEnd(); ++it)
+        onPropertyChanged(it.key(), it.value());
+}
+
 void Dock_Entry::onPropertyChanged(const QString &propName, const QVariant &value)
 {
     if (propName == QStringLiteral("CurrentWindow")) {
@@ -207,6 +222,7 @@ void Dock_Entry::onPropertyChanged(const QString &propName, const QVariant &valu
             d_ptr->mode = mode;
             Q_EMIT ModeChanged(d_ptr->mode);
         }
+        return;
     }
 
     qWarning() << "property not handle: " << propName;
@@ -215,52 +231,52 @@ void Dock_Entry::onPropertyChanged(const QString &propName, const QVariant &valu
 
 uint Dock_Entry::currentWindow()
 {
-    return qvariant_cast<uint>(property("CurrentWindow"));
+    return d_ptr->CurrentWindow;
 }
 
 QString Dock_Entry::desktopFile()
 {
-    return qvariant_cast<QString>(property("DesktopFile"));
+    return d_ptr->DesktopFile;
 }
 
 QString Dock_Entry::icon()
 {
-    return qvariant_cast<QString>(property("Icon"));
+    return d_ptr->Icon;
 }
 
 QString Dock_Entry::id()
 {
-    return qvariant_cast<QString>(property("Id"));
+    return d_ptr->Id;
 }
 
 bool Dock_Entry::isActive()
 {
-    return qvariant_cast<bool>(property("IsActive"));
+    return d_ptr->IsActive;
 }
 
 bool Dock_Entry::isDocked()
 {
-    return qvariant_cast<bool>(property("IsDocked"));
+    return d_ptr->IsDocked;
 }
 
 int Dock_Entry::mode() const
 {
-    return qvariant_cast<int>(property("Mode"));
+    return d_ptr->mode;
 }
 
 QString Dock_Entry::menu()
 {
-    return qvariant_cast<QString>(property("Menu"));
+    return d_ptr->Menu;
 }
 
 QString Dock_Entry::name()
 {
-    return qvariant_cast<QString>(property("Name"));
+    return d_ptr->Name;
 }
 
 WindowInfoMap Dock_Entry::windowInfos()
 {
-    return qvariant_cast<WindowInfoMap>(property("WindowInfos"));
+    return d_ptr->WindowInfos;
 }
 
 void Dock_Entry::CallQueued(const QString &callName, const QList<QVariant> &args)
@@ -272,7 +288,7 @@ void Dock_Entry::CallQueued(const QString &callName, const QList<QVariant> &args
     if (d_ptr->m_processingCalls.contains(callName)) {
         d_ptr->m_waittingCalls.insert(callName, args);
     } else {
-        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(asyncCallWithArgumentList(callName, args));
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusStatistics::asyncCall(this, callName, args));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, &Dock_Entry::onPendingCallFinished);
         d_ptr->m_processingCalls.insert(callName, watcher);
     }
@@ -25,6 +25,8 @@
 #define WINDOWLIST_H
 #define WINDOWINFOLIST_H
 
+#include "dbusstatistics.h"
+
 #include <QObject>
 #include <QByteArray>
 #include <QList>
@@ -71,6 +73,8 @@ class Dock_Entry : public QDBusAbstractInterface
 {
     Q_OBJECT
 
+    friend class EntryPropertyCache;
+
 public:
     static inline const char *staticInterfaceName()
     { return "org.deepin.dde.daemon.Dock1.Entry"; }
@@ -115,7 +119,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("Activate"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("Activate"), argumentList);
     }
 
     inline void ActivateQueued(uint in0)
@@ -128,7 +132,7 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> Check()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("Check"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("Check"), argumentList);
     }
 
     inline void CheckQueued()
@@ -140,14 +144,14 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> ForceQuit()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("ForceQuit"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("ForceQuit"), argumentList);
     }
 
     inline QDBusPendingReply<> ActiveWindow(quint32 in0)
     {
         QList<QVariant> argumentList;
         argumentList << in0;
-        return asyncCallWithArgumentList(QStringLiteral("ActiveWindow"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("ActiveWindow"), argumentList);
     }
 
     inline void ForceQuitQueued()
@@ -159,14 +163,14 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<WindowList> GetAllowedCloseWindows()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("GetAllowedCloseWindows"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("GetAllowedCloseWindows"), argumentList);
     }
 
     inline QDBusPendingReply<> HandleDragDrop(uint in0, const QStringList &in1)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1);
-        return asyncCallWithArgumentList(QStringLiteral("HandleDragDrop"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("HandleDragDrop"), argumentList);
     }
 
     inline void HandleDragDropQueued(uint in0, const QStringList &in1)
@@ -180,7 +184,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1);
-        return asyncCallWithArgumentList(QStringLiteral("HandleMenuItem"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("HandleMenuItem"), argumentList);
     }
 
     inline void HandleMenuItemQueued(uint in0, const QString &in1)
@@ -194,7 +198,7 @@ public Q_SLOTS: // METHODS
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("NewInstance"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("NewInstance"), argumentList);
     }
 
     inline void NewInstanceQueued(uint in0)
@@ -207,7 +211,7 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> PresentWindows()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("PresentWindows"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("PresentWindows"), argumentList);
     }
 
     inline void PresentWindowsQueued()
@@ -219,7 +223,7 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> RequestDock()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("RequestDock"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RequestDock"), argumentList);
     }
 
     inline void RequestDockQueued()
@@ -231,7 +235,7 @@ public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> RequestUndock()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("RequestUndock"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RequestUndock"), argumentList);
     }
 
     inline void RequestUndockQueued()
@@ -261,6 +265,7 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void onPendingCallFinished(QDBusPendingCallWatcher *w);
+    void onPropertiesChanged(const QVariantMap &changedProperties);
     void onPropertyChanged(const QString &propName, const QVariant &value);
 
 private:
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "entrypropertycache.h"
+#include "dbusutil.h"
+
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusReply>
+#include <QDBusPendingCallWatcher>
+#include <QTimer>
+
+#define PROPERTIES_INTERFACE "org.freedesktop.DBus.Properties"
+// 获取属性失败时的重试次数和间隔(毫秒)，EntryAdded时应用的对象可能还没有导出
+#define GET_ALL_RETRY_TIMES 3
+#define GET_ALL_RETRY_MSEC 500
+
+EntryPropertyCache::EntryPropertyCache(QObject *parent)
+    : QObject(parent)
+{
+    // 路径为空时监听服务下所有对象的信号，在获取属性之前连接，保证不会漏掉获取过程中的变化
+    QDBusConnection::sessionBus().connect(dockServiceName(), QString(), PROPERTIES_INTERFACE, "PropertiesChanged",
+                                          this, SLOT(onPropertiesChanged(const QDBusMessage &)));
+    // 预先获取后没有被使用的应用，在应用被移除时删除缓存
+    QDBusConnection::sessionBus().connect(dockServiceName(), dockServicePath(), DockInter::staticInterfaceName(), "EntryRemoved",
+                                          this, SLOT(evictUnused()));
+
+    if (QMetaType::type("WindowInfoMap") == QMetaType::UnknownType)
+        registerWindowInfoMapMetaType();
+}
+
+EntryPropertyCache *EntryPropertyCache::instance()
+{
+    static EntryPropertyCache *cache = new EntryPropertyCache(qApp);
+    return cache;
+}
+
+/**
+ * @brief EntryPropertyCache::prefetch 同时发出所有应用的GetAll请求，再统一等待返回
+ * @param paths 应用Entry的对象路径，已经缓存的不再获取
+ */
+void EntryPropertyCache::prefetch(const QList<QDBusObjectPath> &paths)
+{
+    QHash<QString, QDBusPendingCall> calls;
+    for (const QDBusObjectPath &path : paths) {
+        if (!m_properties.contains(path.path()) && !calls.contains(path.path()))
+            calls.insert(path.path(), getAll(path.path()));
+    }
+
+    for (auto it = calls.begin(); it != calls.end(); ++it) {
+        QDBusReply<QVariantMap> reply(it.value());
+        if (reply.isValid()) {
+            m_properties.insert(it.key(), demarshall(reply.value()));
+            m_prefetched.insert(it.key());
+        } else
+            qWarning() << "get entry properties failed:" << it.key() << reply.error().message();
+    }
+}
+
+/**
+ * @brief EntryPropertyCache::acquire 获取应用的属性，没有预先获取时同步获取一次，
+ * 调用后缓存一直保留，并且属性变化时通知entry，直到entry调用release
+ */
+QVariantMap EntryPropertyCache::acquire(Dock_Entry *entry)
+{
+    const QString &path = entry->path();
+    m_entries.insert(path, entry);
+    m_prefetched.remove(path);
+
+    auto it = m_properties.constFind(path);
+    if (it != m_properties.constEnd())
+        return it.value();
+
+    QDBusReply<QVariantMap> reply(getAll(path));
+    if (!reply.isValid()) {
+        // 先缓存空的属性，保证之后的属性变化可以更新，同时异步重新获取
+        qWarning() << "get entry properties failed:" << path << reply.error().message();
+        m_properties.insert(path, QVariantMap());
+        retry(path, GET_ALL_RETRY_TIMES);
+        return QVariantMap();
+    }
+
+    const QVariantMap &properties = demarshall(reply.value());
+    m_properties.insert(path, properties);
+    return properties;
+}
+
+void EntryPropertyCache::release(Dock_Entry *entry)
+{
+    const QString &path = entry->path();
+    m_entries.remove(path, entry);
+
+    if (!m_entries.contains(path)) {
+        m_properties.remove(path);
+        // 延后处理，避免批量创建应用的过程中删除还没有被使用的预先获取结果
+        QMetaObject::invokeMethod(this, "evictUnused", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief EntryPropertyCache::evictUnused 删除预先获取后一直没有Dock_Entry使用的应用属性
+ */
+void EntryPropertyCache::evictUnused()
+{
+    for (const QString &path : m_prefetched) {
+        if (!m_entries.contains(path))
+            m_properties.remove(path);
+    }
+
+    m_prefetched.clear();
+}
+
+/**
+ * @brief EntryPropertyCache::retry 延时后重新获取应用的属性，获取到后作为属性变化通知Dock_Entry
+ * @param retryTimes 剩余的重试次数
+ */
+void EntryPropertyCache::retry(const QString &path, int retryTimes)
+{
+    if (retryTimes <= 0)
+        return;
+
+    QTimer::singleShot(GET_ALL_RETRY_MSEC, this, [ = ] {
+        // 应用已经被移除
+        if (!m_properties.contains(path))
+            return;
+
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(getAll(path), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+            watcher->deleteLater();
+
+            QDBusReply<QVariantMap> reply(*watcher);
+            if (!reply.isValid()) {
+                qWarning() << "retry getting entry properties failed:" << path << reply.error().message();
+                retry(path, retryTimes - 1);
+                return;
+            }
+
+            if (m_properties.contains(path))
+                update(path, demarshall(reply.value()));
+        });
+    });
+}
+
+QDBusPendingCall EntryPropertyCache::getAll(const QString &path) const
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(dockServiceName(), path, PROPERTIES_INTERFACE, "GetAll");
+    message << QString(DockEntryInter::staticInterfaceName());
+    return DBusStatistics::watch(QDBusConnection::sessionBus().asyncCall(message), dockServiceName(), "GetAll");
+}
+
+/**
+ * @brief EntryPropertyCache::demarshall 自定义类型的属性在返回的QVariantMap中是QDBusArgument，转换为实际的类型
+ */
+QVariantMap EntryPropertyCache::demarshall(const QVariantMap &properties)
+{
+    QVariantMap result = properties;
+    auto it = result.find("WindowInfos");
+    if (it != result.end() && it.value().userType() == qMetaTypeId<QDBusArgument>())
+        it.value() = QVariant::fromValue(qdbus_cast<WindowInfoMap>(it.value().value<QDBusArgument>()));
+
+    return result;
+}
+
+void EntryPropertyCache::onPropertiesChanged(const QDBusMessage &message)
+{
+    const QList<QVariant> &arguments = message.arguments();
+    if (arguments.size() != 3 || arguments.at(0).toString() != DockEntryInter::staticInterfaceName())
+        return;
+
+    DBusStatistics::instance()->recordSignal(dockServiceName(), "Entry.PropertiesChanged");
+
+    // 没有被使用的应用不需要缓存，使用时会重新获取
+    if (!m_properties.contains(message.path()))
+        return;
+
+    // 失效的属性没有携带新的值，从缓存中删除，之后创建的Dock_Entry不会读到旧的值
+    QVariantMap &properties = m_properties[message.path()];
+    for (const QString &invalidated : qdbus_cast<QStringList>(arguments.at(2)))
+        properties.remove(invalidated);
+
+    update(message.path(), demarshall(qdbus_cast<QVariantMap>(arguments.at(1))));
+}
+
+/**
+ * @brief EntryPropertyCache::update 更新缓存，并且只通知使用这个应用的Dock_Entry
+ */
+void EntryPropertyCache::update(const QString &path, const QVariantMap &changedProperties)
+{
+    QVariantMap &properties = m_properties[path];
+    for (auto changed = changedProperties.constBegin(); changed != changedProperties.constEnd(); ++changed)
+        properties.insert(changed.key(), changed.value());
+
+    // 通知过程中可能有Dock_Entry被销毁，通知前确认仍在使用缓存
+    for (Dock_Entry *entry : m_entries.values(path)) {
+        if (m_entries.contains(path, entry))
+            entry->onPropertiesChanged(changedProperties);
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ENTRYPROPERTYCACHE_H
+#define ENTRYPROPERTYCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QVariantMap>
+#include <QDBusObjectPath>
+#include <QDBusPendingCall>
+
+class QDBusMessage;
+class Dock_Entry;
+
+/**
+ * @brief The EntryPropertyCache class
+ * 所有应用Entry的属性缓存，启动时用一批并发的GetAll获取所有应用的属性，之后只根据
+ * PropertiesChanged信号更新，Dock_Entry的属性读取直接返回缓存，不再有同步的DBus调用。
+ * 属性变化按照对象路径直接分发给对应的Dock_Entry
+ */
+class EntryPropertyCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static EntryPropertyCache *instance();
+
+    void prefetch(const QList<QDBusObjectPath> &paths);
+    QVariantMap acquire(Dock_Entry *entry);
+    void release(Dock_Entry *entry);
+
+private:
+    explicit EntryPropertyCache(QObject *parent = nullptr);
+
+    QDBusPendingCall getAll(const QString &path) const;
+    void retry(const QString &path, int retryTimes);
+    void update(const QString &path, const QVariantMap &changedProperties);
+    static QVariantMap demarshall(const QVariantMap &properties);
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QDBusMessage &message);
+    void evictUnused();
+
+private:
+    QHash<QString, QVariantMap> m_properties;
+    QMultiHash<QString, Dock_Entry *> m_entries;    // 使用缓存的Dock_Entry，都销毁后删除缓存
+    QSet<QString> m_prefetched;                     // 预先获取后还没有Dock_Entry使用的应用
+};
+
+#endif // ENTRYPROPERTYCACHE_H
@@ -18,6 +18,7 @@
 StatusNotifierWatcherInterface::StatusNotifierWatcherInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent)
     : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
 {
+    DBusStatistics::watchSignals(this, true);
 }
 
 StatusNotifierWatcherInterface::~StatusNotifierWatcherInterface()
@@ -11,6 +11,8 @@
 #ifndef STATUSNOTIFIERWATCHERPROXY_H
 #define STATUSNOTIFIERWATCHERPROXY_H
 
+#include "dbusstatistics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -37,29 +39,29 @@ public:
 
     Q_PROPERTY(bool IsStatusNotifierHostRegistered READ isStatusNotifierHostRegistered)
     inline bool isStatusNotifierHostRegistered() const
-    { return qvariant_cast< bool >(property("IsStatusNotifierHostRegistered")); }
+    { return qvariant_cast< bool >(DBusStatistics::property(this, "IsStatusNotifierHostRegistered")); }
 
     Q_PROPERTY(int ProtocolVersion READ protocolVersion)
     inline int protocolVersion() const
-    { return qvariant_cast< int >(property("ProtocolVersion")); }
+    { return qvariant_cast< int >(DBusStatistics::property(this, "ProtocolVersion")); }
 
     Q_PROPERTY(QStringList RegisteredStatusNotifierItems READ registeredStatusNotifierItems)
     inline QStringList registeredStatusNotifierItems() const
-    { return qvariant_cast< QStringList >(property("RegisteredStatusNotifierItems")); }
+    { return qvariant_cast< QStringList >(DBusStatistics::property(this, "RegisteredStatusNotifierItems")); }
 
 public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> RegisterStatusNotifierHost(const QString &service)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(service);
-        return asyncCallWithArgumentList(QStringLiteral("RegisterStatusNotifierHost"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RegisterStatusNotifierHost"), argumentList);
     }
 
     inline QDBusPendingReply<> RegisterStatusNotifierItem(const QString &service)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(service);
-        return asyncCallWithArgumentList(QStringLiteral("RegisterStatusNotifierItem"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RegisterStatusNotifierItem"), argumentList);
     }
 
 Q_SIGNALS: // SIGNALS
@@ -5,8 +5,12 @@
 
 #include "appitem.h"
 #include "themeappicon.h"
+#include "appiconresolver.h"
+#include "indicatoratlas.h"
 #include "xcb_misc.h"
 #include "appswingeffectbuilder.h"
+#include "animationclock.h"
+#include "clockservice.h"
 #include "utils.h"
 #include "screenspliter.h"
 
@@ -18,13 +22,10 @@
 #include <QMouseEvent>
 #include <QApplication>
 #include <QHBoxLayout>
-#include <QGraphicsScene>
-#include <QTimeLine>
 #include <QX11Info>
 #include <QGSettings>
 
 #include <DGuiApplicationHelper>
-#include <DPlatformTheme>
 #include <DConfig>
 
 DGUI_USE_NAMESPACE
@@ -41,18 +42,15 @@ AppItem::AppItem(DockInter *dockInter, const QGSettings *appSettings, const QGSe
     , m_dockedAppSettings(dockedAppSettings)
     , m_appPreviewTips(nullptr)
     , m_itemEntryInter(new DockEntryInter(dockServiceName(), entry.path(), QDBusConnection::sessionBus(), this))
-    , m_swingEffectView(nullptr)
-    , m_itemAnimation(nullptr)
     , m_wmHelper(DWindowManagerHelper::instance())
     , m_drag(nullptr)
     , m_retryTimes(0)
     , m_iconValid(true)
     , m_lastclickTimes(0)
     , m_appIcon(QPixmap())
-    , m_activeColor(DGuiApplicationHelper::instance()->systemTheme()->activeColor())
-    , m_updateIconGeometryTimer(new QTimer(this))
-    , m_retryObtainIconTimer(new QTimer(this))
-    , m_refershIconTimer(new QTimer(this))
+    , m_updateIconGeometryTimer(this, 500, [ this ] { updateWindowIconGeometries(); })
+    , m_retryObtainIconTimer(this, 3000, [ this ] { refreshIcon(); })
+    , m_refreshIconTimer(this, 60 * 1000, [ this ] { refreshIcon(); })
     , m_themeType(DGuiApplicationHelper::instance()->themeType())
     , m_createMSecs(QDateTime::currentMSecsSinceEpoch())
     , m_screenSpliter(ScreenSpliterFactory::createScreenSpliter(this, m_itemEntryInter))
@@ -69,22 +67,11 @@ AppItem::AppItem(DockInter *dockInter, const QGSettings *appSettings, const QGSe
     m_id = m_itemEntryInter->id();
     m_active = m_itemEntryInter->isActive();
 
-    m_updateIconGeometryTimer->setInterval(500);
-    m_updateIconGeometryTimer->setSingleShot(true);
-
-    m_retryObtainIconTimer->setInterval(3000);
-    m_retryObtainIconTimer->setSingleShot(true);
-
-    m_refershIconTimer->setInterval(1000);
-    m_refershIconTimer->setSingleShot(false);
-
     connect(m_itemEntryInter, &DockEntryInter::IsActiveChanged, this, &AppItem::activeChanged);
     connect(m_itemEntryInter, &DockEntryInter::IsActiveChanged, this, static_cast<void (AppItem::*)()>(&AppItem::update));
     connect(m_itemEntryInter, &DockEntryInter::WindowInfosChanged, this, &AppItem::updateWindowInfos, Qt::QueuedConnection);
     connect(m_itemEntryInter, &DockEntryInter::IconChanged, this, &AppItem::refreshIcon);
     connect(m_itemEntryInter, &DockEntryInter::ModeChanged, this, &AppItem::modeChanged);
-    connect(m_updateIconGeometryTimer, &QTimer::timeout, this, &AppItem::updateWindowIconGeometries, Qt::QueuedConnection);
-    connect(m_retryObtainIconTimer, &QTimer::timeout, this, &AppItem::refreshIcon, Qt::QueuedConnection);
 
     connect(this, &AppItem::requestUpdateEntryGeometries, this, &AppItem::updateWindowIconGeometries);
 
@@ -98,11 +85,17 @@ AppItem::AppItem(DockInter *dockInter, const QGSettings *appSettings, const QGSe
         connect(m_activeAppSettings, &QGSettings::changed, this, &AppItem::onGSettingsChanged);
 
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &AppItem::onThemeTypeChanged);
-    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::activeColorChanged, this,
-            [this](const auto &color) { m_activeColor = color; });
+    connect(IndicatorAtlas::instance(), &IndicatorAtlas::indicatorChanged, this, static_cast<void (AppItem::*)()>(&AppItem::update));
+    connect(AnimationClock::instance(), &AnimationClock::finished, this, [ this ](QWidget *target) {
+        if (target == this)
+            checkAttentionEffect();
+    });
 
-    /** 日历 1S定时判断是否刷新icon的处理 */
-    connect(m_refershIconTimer, &QTimer::timeout, this, &AppItem::onRefreshIcon);
+    // 图标在工作线程中查找完成后，替换当前的占位图标
+    connect(AppIconResolver::instance(), &AppIconResolver::iconResolved, this, [ this ](const QString &name, bool found) {
+        if (found && !m_iconValid && name == m_itemEntryInter->icon())
+            refreshIcon();
+    });
 }
 
 /**将属于同一个应用的窗口合并到同一个应用图标
@@ -118,6 +111,11 @@ const QString AppItem::appId() const
     return m_id;
 }
 
+QString AppItem::profileKey() const
+{
+    return QString("AppItem/%1").arg(m_id);
+}
+
 QString AppItem::name() const
 {
     return m_itemEntryInter->name();
@@ -248,14 +246,14 @@ void AppItem::moveEvent(QMoveEvent *e)
         m_drag->appDragWidget()->setOriginPos(mapToGlobal(appIconPosition()));
     }
 
-    m_updateIconGeometryTimer->start();
+    m_updateIconGeometryTimer.start();
 }
 
 void AppItem::paintEvent(QPaintEvent *e)
 {
     DockItem::paintEvent(e);
 
-    if (isDragging() || (m_swingEffectView != nullptr && DockDisplayMode != Fashion))
+    if (isDragging())
         return;
 
     QPainter painter(this);
@@ -294,62 +292,48 @@ void AppItem::paintEvent(QPaintEvent *e)
         }
     } else {
         if (!m_windowInfos.isEmpty()) {
-            QPoint p;
-            QPixmap pixmap;
-            QPixmap activePixmap;
-            if (DGuiApplicationHelper::DarkType == m_themeType) {
-                m_horizontalIndicator = QPixmap(":/indicator/resources/indicator_dark.svg");
-                m_verticalIndicator = QPixmap(":/indicator/resources/indicator_dark_ver.svg");
-            } else {
-                m_horizontalIndicator = QPixmap(":/indicator/resources/indicator.svg");
-                m_verticalIndicator = QPixmap(":/indicator/resources/indicator_ver.svg");
-            }
-            m_activeHorizontalIndicator = QPixmap(":/indicator/resources/indicator_active.svg");
-            m_activeHorizontalIndicator.fill(m_activeColor);
-            m_activeVerticalIndicator = QPixmap(":/indicator/resources/indicator_active_ver.svg");
-            m_activeVerticalIndicator.fill(m_activeColor);
+            const QPixmap &pixmap = IndicatorAtlas::instance()->indicator(m_themeType, DockPosition, m_active, devicePixelRatioF());
+            const QSizeF pixmapSize = QSizeF(pixmap.size()) / pixmap.devicePixelRatioF();
+            QPointF p;
             switch (DockPosition) {
             case Top:
-                pixmap = m_horizontalIndicator;
-                activePixmap = m_activeHorizontalIndicator;
-                p.setX((itemRect.width() - pixmap.width()) / 2);
+                p.setX((itemRect.width() - pixmapSize.width()) / 2);
                 p.setY(1);
                 break;
             case Bottom:
-                pixmap = m_horizontalIndicator;
-                activePixmap = m_activeHorizontalIndicator;
-                p.setX((itemRect.width() - pixmap.width()) / 2);
-                p.setY(itemRect.height() - pixmap.height() - 1);
+                p.setX((itemRect.width() - pixmapSize.width()) / 2);
+                p.setY(itemRect.height() - pixmapSize.height() - 1);
                 break;
             case Left:
-                pixmap = m_verticalIndicator;
-                activePixmap = m_activeVerticalIndicator;
                 p.setX(1);
-                p.setY((itemRect.height() - pixmap.height()) / 2);
+                p.setY((itemRect.height() - pixmapSize.height()) / 2);
                 break;
             case Right:
-                pixmap = m_verticalIndicator;
-                activePixmap = m_activeVerticalIndicator;
-                p.setX(itemRect.width() - pixmap.width() - 1);
-                p.setY((itemRect.height() - pixmap.height()) / 2);
+                p.setX(itemRect.width() - pixmapSize.width() - 1);
+                p.setY((itemRect.height() - pixmapSize.height()) / 2);
                 break;
             }
 
-            if (m_active)
-                painter.drawPixmap(p, activePixmap);
-            else
-                painter.drawPixmap(p, pixmap);
+            painter.drawPixmap(p, pixmap);
         }
     }
 
-    if (m_swingEffectView != nullptr)
-        return;
-
     // icon
     if (m_appIcon.isNull())
         return;
 
-    painter.drawPixmap(appIconPosition(), m_appIcon);
+    const qint64 swingElapsed = AnimationClock::instance()->elapsed(this);
+    if (swingElapsed < 0) {
+        painter.drawPixmap(appIconPosition(), m_appIcon);
+        return;
+    }
+
+    // 摆动时绕图标中心下方的点旋转缓存的图标
+    const QRectF iconRect(appIconPosition(), QSizeF(m_appIcon.size()) / m_appIcon.devicePixelRatioF());
+    const QPointF pivot = iconRect.center() + QPointF(0, SWING_PIVOT_OFFSET);
+    painter.translate(pivot);
+    painter.rotate(SwingRotation(swingElapsed));
+    painter.drawPixmap(iconRect.topLeft() - pivot, m_appIcon);
 }
 
 void AppItem::mouseReleaseEvent(QMouseEvent *e)
@@ -404,7 +388,7 @@ void AppItem::mousePressEvent(QMouseEvent *e)
     if (checkGSettingsControl()) {
         return;
     }
-    m_updateIconGeometryTimer->stop();
+    m_updateIconGeometryTimer.stop();
     hidePopup();
 
     if (e->button() == Qt::LeftButton)
@@ -637,9 +621,10 @@ void AppItem::updateWindowInfos(const WindowInfoMap &info)
         updateMSecs();
 
     m_windowInfos = info;
+    // GetAllowedCloseWindows已经从后端移除，预览中也不再使用，不需要同步等待它的返回
     if (m_appPreviewTips)
-        m_appPreviewTips->setWindowInfos(m_windowInfos, m_itemEntryInter->GetAllowedCloseWindows().value());
-    m_updateIconGeometryTimer->start();
+        m_appPreviewTips->setWindowInfos(m_windowInfos, WindowList());
+    m_updateIconGeometryTimer.start();
 
     // process attention effect
     if (hasAttention()) {
@@ -668,9 +653,9 @@ void AppItem::refreshIcon()
     else
         m_iconValid = ThemeAppIcon::getIcon(m_appIcon, icon, iconSize * 0.8, !m_iconValid);
 
-    if (!m_refershIconTimer->isActive() && m_itemEntryInter->icon() == "dde-calendar") {
-        m_refershIconTimer->start();
-    }
+    // 日历的图标随日期变化，跨天时刷新图标
+    if (icon == "dde-calendar")
+        connect(ClockService::instance(), &ClockService::dateChanged, this, &AppItem::onRefreshIcon, Qt::UniqueConnection);
 
     if (!m_iconValid) {
         if (m_retryTimes < 10) {
@@ -680,11 +665,10 @@ void AppItem::refreshIcon()
             // QIcon::setThemeSearchPaths will force Qt to re-check the gtk cache validity.
             QIcon::setThemeSearchPaths(QIcon::themeSearchPaths());
 
-            m_retryObtainIconTimer->start();
+            m_retryObtainIconTimer.start();
         } else {
             // 如果图标获取失败，一分钟后再自动刷新一次（如果还是显示异常，基本需要应用自身看下为什么了）
-            if (!m_iconValid)
-                QTimer::singleShot(60 * 1000, this, &AppItem::refreshIcon);
+            m_refreshIconTimer.start();
         }
 
         update();
@@ -697,9 +681,12 @@ void AppItem::refreshIcon()
         m_retryTimes = 0;
     }
 
+    m_retryObtainIconTimer.stop();
+    m_refreshIconTimer.stop();
+
     update();
 
-    m_updateIconGeometryTimer->start();
+    m_updateIconGeometryTimer.start();
 }
 
 void AppItem::onRefreshIcon()
@@ -730,7 +717,7 @@ void AppItem::showPreview()
         return;
 
     m_appPreviewTips = new PreviewContainer;
-    m_appPreviewTips->setWindowInfos(m_windowInfos, m_itemEntryInter->GetAllowedCloseWindows().value());
+    m_appPreviewTips->setWindowInfos(m_windowInfos, WindowList());
     m_appPreviewTips->updateLayoutDirection(DockPosition);
 
     connect(m_appPreviewTips, &PreviewContainer::requestActivateWindow, this, &AppItem::requestActivateWindow, Qt::QueuedConnection);
@@ -754,45 +741,19 @@ void AppItem::showPreview()
 void AppItem::playSwingEffect()
 {
     // NOTE(sbw): return if animation view already playing
-    if (m_swingEffectView != nullptr)
+    if (AnimationClock::instance()->isRunning(this))
         return;
 
     if (rect().isEmpty())
         return checkAttentionEffect();
 
-    stopSwingEffect();
-
-    QPair<QGraphicsView *, QGraphicsItemAnimation *> pair =  SwingEffect(
-                this, m_appIcon, rect(), devicePixelRatioF());
-
-    m_swingEffectView = pair.first;
-    m_itemAnimation = pair.second;
-
-    QTimeLine *tl = m_itemAnimation->timeLine();
-    connect(tl, &QTimeLine::stateChanged, this, [ = ](QTimeLine::State newState) {
-        if (newState == QTimeLine::NotRunning) {
-            m_swingEffectView->hide();
-            layout()->removeWidget(m_swingEffectView);
-            m_swingEffectView = nullptr;
-            m_itemAnimation = nullptr;
-            checkAttentionEffect();
-        }
-    });
-
-    layout()->addWidget(m_swingEffectView);
-    tl->start();
+    // 由任务栏共用的动画时钟驱动，在paintEvent中绘制旋转的图标
+    AnimationClock::instance()->start(this, SWING_DURATION);
 }
 
 void AppItem::stopSwingEffect()
 {
-    if (m_swingEffectView == nullptr || m_itemAnimation == nullptr)
-        return;
-
-    // stop swing effect
-    m_swingEffectView->setVisible(false);
-
-    if (m_itemAnimation->timeLine() && m_itemAnimation->timeLine()->state() != QTimeLine::NotRunning)
-        m_itemAnimation->timeLine()->stop();
+    AnimationClock::instance()->stop(this);
 }
 
 void AppItem::checkAttentionEffect()
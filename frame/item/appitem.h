@@ -12,9 +12,6 @@
 #include "../widgets/tipswidget.h"
 #include "dbusutil.h"
 
-#include <QGraphicsView>
-#include <QGraphicsItem>
-#include <QGraphicsItemAnimation>
 #include <DGuiApplicationHelper>
 
 class QGSettings;
@@ -80,6 +77,7 @@ private:
     void invokedMenuItem(const QString &itemId, const bool checked) override;
     const QString contextMenu() const override;
     QWidget *popupTips() override;
+    QString profileKey() const override;
     void startDrag();
     bool hasAttention() const;
 
@@ -108,9 +106,6 @@ private:
     PreviewContainer *m_appPreviewTips;
     DockEntryInter *m_itemEntryInter;
 
-    QGraphicsView *m_swingEffectView;
-    QGraphicsItemAnimation *m_itemAnimation;
-
     DWindowManagerHelper *m_wmHelper;
 
     QPointer<AppDrag> m_drag;
@@ -123,15 +118,10 @@ private:
     WindowInfoMap m_windowInfos;
     QString m_id;
     QPixmap m_appIcon;
-    QPixmap m_horizontalIndicator;
-    QPixmap m_verticalIndicator;
-    QPixmap m_activeHorizontalIndicator;
-    QPixmap m_activeVerticalIndicator;
-    QColor m_activeColor;
-
-    QTimer *m_updateIconGeometryTimer;
-    QTimer *m_retryObtainIconTimer;
-    QTimer *m_refershIconTimer;         // 当APP为日历时定时（1S）检测是否刷新ICON
+
+    WheelTimer m_updateIconGeometryTimer;
+    WheelTimer m_retryObtainIconTimer;
+    WheelTimer m_refreshIconTimer;      // 多次重试仍然获取失败后，定时再刷新一次
 
     QDate m_curDate;                    // 保存当前icon的日期来判断是否需要更新日历APP的ICON
 
@@ -8,9 +8,13 @@
 #include "../widgets/tipswidget.h"
 #include "utils.h"
 #include "imageutil.h"
+#include "windowthumbnailmanager.h"
+#include "xcb_shmcapture.h"
 
 #include <DStyle>
 
+#include <QApplication>
+
 #include <X11/Xlib.h>
 #include <X11/X.h>
 #include <X11/Xutil.h>
@@ -41,6 +45,13 @@ struct SHMInfo {
 
 using namespace Dock;
 
+static DockInter *dockDaemonInter()
+{
+    // 所有预览图共用一个后端代理，不再为每个预览图创建代理和DBus匹配规则
+    static DockInter *inter = new DockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus(), qApp);
+    return inter;
+}
+
 AppSnapshot::AppSnapshot(const WId wid, QWidget *parent)
     : QWidget(parent)
     , m_wid(wid)
@@ -51,7 +62,6 @@ AppSnapshot::AppSnapshot(const WId wid, QWidget *parent)
     , m_waitLeaveTimer(new QTimer(this))
     , m_closeBtn2D(new DIconButton(this))
     , m_wmHelper(DWindowManagerHelper::instance())
-    , m_dockDaemonInter(new DockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus(), this))
 {
     m_closeBtn2D->setFixedSize(SNAP_CLOSE_BTN_WIDTH, SNAP_CLOSE_BTN_WIDTH);
     m_closeBtn2D->setIconSize(QSize(SNAP_CLOSE_BTN_WIDTH, SNAP_CLOSE_BTN_WIDTH));
@@ -73,13 +83,32 @@ AppSnapshot::AppSnapshot(const WId wid, QWidget *parent)
 
     connect(m_closeBtn2D, &DIconButton::clicked, this, &AppSnapshot::closeWindow, Qt::QueuedConnection);
     connect(m_wmHelper, &DWindowManagerHelper::hasCompositeChanged, this, &AppSnapshot::compositeChanged, Qt::QueuedConnection);
+    connect(WindowThumbnailManager::instance(), &WindowThumbnailManager::thumbnailUpdated, this, &AppSnapshot::onThumbnailUpdated);
     QTimer::singleShot(1, this, &AppSnapshot::compositeChanged);
 }
 
+/**
+ * @brief AppSnapshot::bind 将复用的预览图绑定到新的窗口
+ * @note 先显示缓存中该窗口的预览图，截图完成后在onThumbnailUpdated中刷新
+ */
+void AppSnapshot::bind(const WId wid)
+{
+    if (m_wid == wid)
+        return;
+
+    m_wid = wid;
+    m_windowInfo = WindowInfo();
+    m_closeAble = true;
+    m_isWidowHidden = false;
+    m_pixmap = WindowThumbnailManager::instance()->thumbnail(m_wid);
+
+    compositeChanged();
+}
+
 void AppSnapshot::setWindowState()
 {
     if (m_isWidowHidden) {
-        m_dockDaemonInter->MinimizeWindow(m_wid);
+        dockDaemonInter()->MinimizeWindow(m_wid);
     }
 }
 
@@ -130,7 +159,7 @@ void AppSnapshot::setTitleVisible(bool bVisible)
 void AppSnapshot::closeWindow() const
 {
     if (Utils::IS_WAYLAND_DISPLAY) {
-        m_dockDaemonInter->CloseWindow(static_cast<uint>(m_wid));
+        dockDaemonInter()->CloseWindow(static_cast<uint>(m_wid));
     } else {
         const auto display = QX11Info::display();
         if (!display) {
@@ -166,6 +195,10 @@ void AppSnapshot::compositeChanged() const
 
 void AppSnapshot::setWindowInfo(const WindowInfo &info)
 {
+    // 窗口信息变化（如标题变化）时窗口内容一般也发生了变化，标记预览图失效
+    if (!(m_windowInfo == info))
+        WindowThumbnailManager::instance()->invalidate(m_wid);
+
     m_windowInfo = info;
     QFontMetrics fm(m_title->font());
     QString strTtile = m_title->fontMetrics().elidedText(m_windowInfo.title, Qt::ElideRight, SNAP_WIDTH - SNAP_CLOSE_BTN_WIDTH - SNAP_CLOSE_BTN_MARGIN);
@@ -195,14 +228,19 @@ void AppSnapshot::fetchSnapshot()
     uchar *image_data = nullptr;
     XImage *ximage = nullptr;
 
-    // 优先使用窗管进行窗口截图
+    // 优先使用窗管进行窗口截图，先显示缓存中的预览图，截图完成后在onThumbnailUpdated中刷新
     if (isKWinAvailable()) {
+        WindowThumbnailManager *thumbnailManager = WindowThumbnailManager::instance();
+        const QPixmap &pixmap = thumbnailManager->thumbnail(m_wid);
+        if (!pixmap.isNull())
+            m_pixmap = pixmap;
+
         const QString windowInfoId = Utils::IS_WAYLAND_DISPLAY ? m_windowInfo.uuid : QString::number(m_wid);
-        m_pixmap = ImageUtil::loadWindowThumb(windowInfoId);
+        thumbnailManager->requestThumbnail(m_wid, windowInfoId, QSize(SNAP_WIDTH, SNAP_HEIGHT) * devicePixelRatioF());
     } else {
+        QImage qimage;
         do {
             // get window image from shm(only for deepin app)
-            QImage qimage;
             info = getImageDSHM();
             if (info) {
                 qDebug() << "get Image from dxcbplugin SHM...";
@@ -215,24 +253,28 @@ void AppSnapshot::fetchSnapshot()
                 image_data = nullptr;
             }
 
-            if (!image_data || qimage.isNull()) {
-                // get window image from XGetImage(a little slow)
-                qDebug() << "get Image from dxcbplugin SHM failed!";
-                qDebug() << "get Image from Xlib...";
-                // guoyao note：这里会造成内存泄漏，而且是通过demo在X环境经过验证，改用xcb库同样会有内存泄漏，这里暂时未找到解决方案，所以优先使用kwin提供的接口
-                ximage = getImageXlib();
-                if (!ximage) {
-                    qDebug() << "get Image from Xlib failed! giving up...";
-                    emit requestCheckWindow();
-                    return;
-                }
-                qimage = QImage(reinterpret_cast<uchar*>(ximage->data), ximage->width, ximage->height, ximage->bytes_per_line, QImage::Format_RGB32).copy();
+            // get window image from MIT-SHM, the image is written into a pooled shared memory segment without copying
+            qimage = XcbShmCapture::instance()->capture(static_cast<xcb_window_t>(m_wid));
+            if (!qimage.isNull())
+                break;
+
+            // get window image from XGetImage(a little slow)
+            qDebug() << "get Image from MIT-SHM failed!";
+            qDebug() << "get Image from Xlib...";
+            ximage = getImageXlib();
+            if (!ximage) {
+                qDebug() << "get Image from Xlib failed! giving up...";
+                emit requestCheckWindow();
+                return;
             }
+            qimage = QImage(reinterpret_cast<uchar*>(ximage->data), ximage->width, ximage->height, ximage->bytes_per_line, QImage::Format_RGB32);
+        } while (false);
 
-            Q_ASSERT(!qimage.isNull());
+        Q_ASSERT(!qimage.isNull());
 
-            m_pixmap = QPixmap::fromImage(qimage);
-        } while (false);
+        // 图像引用的是共享内存或XImage的数据，缩放到预览图大小后即可释放，不再额外拷贝原图
+        m_pixmap = QPixmap::fromImage(qimage.scaled(QSize(SNAP_WIDTH, SNAP_HEIGHT) * devicePixelRatioF(),
+                                                    Qt::KeepAspectRatio, Qt::SmoothTransformation));
     }
 
     if (image_data) shmdt(image_data);
@@ -242,6 +284,15 @@ void AppSnapshot::fetchSnapshot()
     update();
 }
 
+void AppSnapshot::onThumbnailUpdated(WId wid)
+{
+    if (wid != m_wid)
+        return;
+
+    m_pixmap = WindowThumbnailManager::instance()->thumbnail(m_wid);
+    update();
+}
+
 void AppSnapshot::enterEvent(QEvent *e)
 {
     QWidget::enterEvent(e);
@@ -446,11 +497,5 @@ void AppSnapshot::getWindowState()
 
 bool AppSnapshot::isKWinAvailable()
 {
-    if (QDBusConnection::sessionBus().interface()->isServiceRegistered(QStringLiteral("org.kde.KWin"))) {
-        QDBusInterface interface(QStringLiteral("org.kde.KWin"), QStringLiteral("/Effects"), QStringLiteral("org.kde.kwin.Effects"));
-        QDBusReply<bool> reply = interface.call(QStringLiteral("isEffectLoaded"), "screenshot");
-
-        return reply.value();
-    }
-    return false;
+    return WindowThumbnailManager::instance()->isKWinAvailable();
 }
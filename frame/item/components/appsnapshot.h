@@ -48,6 +48,7 @@ class AppSnapshot : public QWidget
 public:
     explicit AppSnapshot(const WId wid, QWidget *parent = Q_NULLPTR);
 
+    void bind(const WId wid);
     inline WId wid() const { return m_wid; }
     inline bool attentioned() const { return m_windowInfo.attention; }
     inline bool closeAble() const { return m_closeAble; }
@@ -85,8 +86,11 @@ private:
     void getWindowState();
     void updateTitle();
 
+private slots:
+    void onThumbnailUpdated(WId wid);
+
 private:
-    const WId m_wid;
+    WId m_wid;
     WindowInfo m_windowInfo;
 
     bool m_closeAble;
@@ -99,7 +103,6 @@ private:
     QTimer *m_waitLeaveTimer;
     DIconButton *m_closeBtn2D;
     DWindowManagerHelper *m_wmHelper;
-    DockInter *m_dockDaemonInter;
 };
 
 #endif // APPSNAPSHOT_H
@@ -5,10 +5,11 @@
 #ifndef SWINGEFFECT
 #define SWINGEFFECT
 
-#include <QGraphicsView>
-#include <QGraphicsItemAnimation>
-#include <QGraphicsPixmapItem>
-#include <QTimeLine>
+#include <QtGlobal>
+
+// 摆动动画的时长(毫秒)，以及旋转中心在图标中心下方的距离
+#define SWING_DURATION 1200
+#define SWING_PIVOT_OFFSET 18
 
 const static qreal Frames[] = { 0,
                                 0.327013,
@@ -71,66 +72,20 @@ const static qreal Frames[] = { 0,
                                 0,
                               };
 
-static QPair<QGraphicsView *, QGraphicsItemAnimation *> SwingEffect(
-        QWidget *parent, const QPixmap &icon, const QRect & rect, const qreal devicePixelRatio)
+/**
+ * @brief SwingRotation 获取摆动动画播放到某一时刻时图标的旋转角度
+ * @param elapsed 动画已播放的时间(毫秒)
+ * @return 旋转角度，关键帧均匀分布在动画时长内，关键帧之间线性插值
+ */
+static qreal SwingRotation(qint64 elapsed)
 {
-    QGraphicsView *swingEffectView = new QGraphicsView(parent);
-    swingEffectView->viewport()->setAutoFillBackground(false);
-    swingEffectView->setFrameShape(QFrame::NoFrame);
-
-    QGraphicsScene *itemScene = new QGraphicsScene(parent);
-    QGraphicsItemAnimation *itemAnimation = new QGraphicsItemAnimation(parent);
-
-    swingEffectView->setAttribute(Qt::WA_TransparentForMouseEvents);
-    swingEffectView->setScene(itemScene);
-    swingEffectView->setAlignment(Qt::AlignCenter);
-    swingEffectView->setFrameStyle(QFrame::NoFrame);
-    swingEffectView->setContentsMargins(0, 0, 0, 0);
-    swingEffectView->setRenderHints(QPainter::SmoothPixmapTransform);
-    swingEffectView->setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
-    swingEffectView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    swingEffectView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-
-    QTimeLine *tl = itemAnimation->timeLine();
-    if (!tl)
-    {
-        tl = new QTimeLine(1200, parent);
-        tl->setFrameRange(0, 60);
-        tl->setLoopCount(1);
-        tl->setEasingCurve(QEasingCurve::Linear);
-        tl->setStartFrame(0);
-
-        itemAnimation->setTimeLine(tl);
-    }
-
-    QGraphicsPixmapItem *item = itemScene->addPixmap(icon);
-    item->setTransformationMode(Qt::SmoothTransformation);
-    item->setPos(QPointF(rect.center()) - QPointF(icon.rect().center()) / devicePixelRatio);
-
-    itemAnimation->setItem(item);
-    itemScene->setSceneRect(rect);
-    swingEffectView->setSceneRect(rect);
-    swingEffectView->setFixedSize(rect.size());
-
-    const int px = qreal(-icon.rect().center().x()) / devicePixelRatio;
-    const int py = qreal(-icon.rect().center().y()) / devicePixelRatio - 18.;
-    const QPoint pos = rect.center() + QPoint(0, 18);
-    for (int i(0); i != 60; ++i)
-    {
-        itemAnimation->setPosAt(i / 60.0, pos);
-        itemAnimation->setTranslationAt(i / 60.0, px, py);
-        itemAnimation->setRotationAt(i / 60.0, Frames[i]);
-    }
-
-    QObject::connect(tl, &QTimeLine::stateChanged, [=](QTimeLine::State newState) {
-        if (newState == QTimeLine::NotRunning) {
-            itemScene->deleteLater();
-            swingEffectView->deleteLater();
-            itemAnimation->deleteLater();
-        }
-    });
+    const int frameCount = sizeof(Frames) / sizeof(Frames[0]);
+    const qreal frame = qreal(qBound(qint64(0), elapsed, qint64(SWING_DURATION))) * frameCount / SWING_DURATION;
+    const int index = int(frame);
+    if (index >= frameCount - 1)
+        return Frames[frameCount - 1];
 
-    return QPair<QGraphicsView *, QGraphicsItemAnimation *>(swingEffectView, itemAnimation);
+    return Frames[index] + (Frames[index + 1] - Frames[index]) * (frame - index);
 }
 
 #endif /* ifndef SWINGEFFECT */
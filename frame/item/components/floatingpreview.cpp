@@ -86,6 +86,16 @@ void FloatingPreview::trackWindow(AppSnapshot *const snap)
     });
 }
 
+void FloatingPreview::untrackWindow()
+{
+    if (m_tracked.isNull())
+        return;
+
+    m_tracked->removeEventFilter(this);
+    m_tracked = nullptr;
+    update();
+}
+
 void FloatingPreview::paintEvent(QPaintEvent *e)
 {
     QWidget::paintEvent(e);
@@ -28,6 +28,7 @@ public:
 
 public slots:
     void trackWindow(AppSnapshot *const snap);
+    void untrackWindow();
 
 private:
     void paintEvent(QPaintEvent *e) override;
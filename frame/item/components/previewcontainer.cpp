@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "previewcontainer.h"
+#include "snapshotpool.h"
 #include "imageutil.h"
 #include "utils.h"
 
@@ -47,33 +48,35 @@ PreviewContainer::PreviewContainer(QWidget *parent)
     connect(m_waitForShowPreviewTimer, &QTimer::timeout, this, &PreviewContainer::previewFloating);
 }
 
+PreviewContainer::~PreviewContainer()
+{
+    // 预览图回收到池中，下次预览时复用
+    for (AppSnapshot *snap : m_snapshots)
+        releaseSnapWidget(snap);
+}
+
 void PreviewContainer::setWindowInfos(const WindowInfoMap &infos, const WindowList &allowClose)
 {
+    m_windowInfos = infos;
+
     // check removed window
     for (auto it(m_snapshots.begin()); it != m_snapshots.end();) {
         //初始化预览界面边距
         it.value()->setContentsMargins(0, 0, 0, 0);
 
         if (!infos.contains(it.key())) {
-            m_windowListLayout->removeWidget(it.value());
-            it.value()->deleteLater();
+            releaseSnapWidget(it.value());
             it = m_snapshots.erase(it);
         } else {
+            it.value()->setWindowInfo(infos.value(it.key()));
+            // FIXME: "GetAllowedCloseWindows" has remove form dde-daemon
+            // 由于相关接口被移除，暂时无法正确设置 m_closeAble 属性，暂改为默认 true
+            // it.value()->setCloseAble(allowClose.contains(it.key()));
             ++it;
         }
     }
 
-    for (auto it(infos.cbegin()); it != infos.cend(); ++it) {
-        const WId key = it.key();
-        if (!m_snapshots.contains(key))
-            appendSnapWidget(key);
-        m_snapshots[key]->setWindowInfo(it.value());
-        // FIXME: "GetAllowedCloseWindows" has remove form dde-daemon
-        // 由于相关接口被移除，暂时无法正确设置 m_closeAble 属性，暂改为默认 true
-        // m_snapshots[key]->setCloseAble(allowClose.contains(key));
-    }
-
-    if (m_snapshots.isEmpty()) {
+    if (m_windowInfos.isEmpty()) {
         emit requestCancelPreviewWindow();
         emit requestHidePopup();
     }
@@ -134,26 +137,29 @@ void PreviewContainer::prepareHide()
 
 void PreviewContainer::adjustSize(bool composite)
 {
-    int count = m_snapshots.size();
+    int count = m_windowInfos.size();
     const int screenWidth = QDesktopWidget().screenGeometry(this).width();
     const int screenHeight = QDesktopWidget().screenGeometry(this).height();
+    const bool horizontal = m_windowListLayout->direction() == QBoxLayout::LeftToRight;
+
+    //先根据屏幕宽高计算出能预览的最大数量,只为能显示的窗口绑定预览图,然后根据数量计算界面宽高
+    if (composite)
+        count = qMin(count, horizontal ? screenWidth * 2 / SNAP_WIDTH : screenWidth * 2 / SNAP_HEIGHT);
+    else
+        count = qMin(count, screenWidth / SNAP_HEIGHT_WITHOUT_COMPOSITE);
+
+    updateSnapWidgets(count);
 
-    //先根据屏幕宽高计算出能预览的最大数量,然后根据数量计算界面宽高
     if (composite) {
         // 3D
         const int padding = 20;
-        const bool horizontal = m_windowListLayout->direction() == QBoxLayout::LeftToRight;
         if (horizontal) {
-            count = qMin(count, screenWidth * 2 / SNAP_WIDTH);
-
             const int h = SNAP_HEIGHT + MARGIN * 2;
             const int w = SNAP_WIDTH * count + MARGIN * 2 + SPACING * (count - 1);
 
             setFixedHeight(h);
             setFixedWidth(qMin(w, screenWidth - padding));
         } else {
-            count = qMin(count, screenWidth * 2 / SNAP_HEIGHT);
-
             const int w = SNAP_WIDTH + MARGIN * 2;
             const int h = SNAP_HEIGHT * count + MARGIN * 2 + SPACING * (count - 1);
 
@@ -162,7 +168,6 @@ void PreviewContainer::adjustSize(bool composite)
         }
     } else if (m_windowListLayout->count()) {
         // 2D
-        count = qMin(count, screenWidth / SNAP_HEIGHT_WITHOUT_COMPOSITE);
         const int h = SNAP_HEIGHT_WITHOUT_COMPOSITE * count + MARGIN * 2 + SPACING * (count - 1);
 
         auto appSnapshot = static_cast<AppSnapshot *>(m_windowListLayout->itemAt(0)->widget());
@@ -183,23 +188,45 @@ void PreviewContainer::adjustSize(bool composite)
         else
             setFixedSize(SNAP_WIDTH, h);
     }
+}
 
-    //根据计算的数量,将相应的预览界面添加到布局并显示,其他的暂时不添加,减少界面刷新次数
-    int i = 0;
-    for (AppSnapshot *snap : m_snapshots) {
-        if (i < count && m_windowListLayout->indexOf(snap) < 0 ) {
-            m_windowListLayout->addWidget(snap);
+/**
+ * @brief PreviewContainer::updateSnapWidgets 为前count个窗口绑定预览图并按顺序加入布局，其余窗口的预览图回收到池中
+ */
+void PreviewContainer::updateSnapWidgets(int count)
+{
+    SnapshotPool::instance()->reserve(count);
+
+    int index = 0;
+    for (auto it(m_windowInfos.cbegin()); it != m_windowInfos.cend(); ++it, ++index) {
+        AppSnapshot *snap = m_snapshots.value(it.key());
+        if (index >= count) {
+            if (snap) {
+                releaseSnapWidget(snap);
+                m_snapshots.remove(it.key());
+            }
+            continue;
+        }
+
+        if (!snap) {
+            snap = appendSnapWidget(it.key());
+            snap->setWindowInfo(it.value());
+            if (m_wmHelper->hasComposite())
+                snap->setTitleVisible(m_titleMode == AlwaysShow);
         }
-        snap->setVisible(i < count);
-        i++;
+
+        if (m_windowListLayout->indexOf(snap) != index) {
+            m_windowListLayout->removeWidget(snap);
+            m_windowListLayout->insertWidget(index, snap);
+        }
+        snap->setVisible(true);
     }
 }
 
-void PreviewContainer::appendSnapWidget(const WId wid)
+AppSnapshot *PreviewContainer::appendSnapWidget(const WId wid)
 {
-    //创建预览界面,默认不显示,等计算出显示数量后再加入布局并显示
-    AppSnapshot *snap = new AppSnapshot(wid);
-    snap->setVisible(false);
+    //从池中获取预览界面,优先使用之前绑定过此窗口的,可以先显示上次的预览图
+    AppSnapshot *snap = SnapshotPool::instance()->acquire(wid);
 
     connect(snap, &AppSnapshot::clicked, this, &PreviewContainer::onSnapshotClicked, Qt::QueuedConnection);
     connect(snap, &AppSnapshot::entered, this, &PreviewContainer::previewEntered, Qt::QueuedConnection);
@@ -207,6 +234,17 @@ void PreviewContainer::appendSnapWidget(const WId wid)
     connect(snap, &AppSnapshot::requestCloseAppSnapshot, this, &PreviewContainer::onRequestCloseAppSnapshot);
 
     m_snapshots.insert(wid, snap);
+    return snap;
+}
+
+void PreviewContainer::releaseSnapWidget(AppSnapshot *snap)
+{
+    if (m_floatingPreview->trackedWindow() == snap)
+        m_floatingPreview->untrackWindow();
+
+    m_windowListLayout->removeWidget(snap);
+    disconnect(snap, nullptr, this, nullptr);
+    SnapshotPool::instance()->release(snap);
 }
 
 void PreviewContainer::enterEvent(QEvent *e)
@@ -304,7 +342,7 @@ void PreviewContainer::onRequestCloseAppSnapshot()
     if (!m_wmHelper->hasComposite())
         return ;
 
-    if (m_snapshots.keys().isEmpty()) {
+    if (m_windowInfos.isEmpty()) {
         Q_EMIT requestHidePopup();
         Q_EMIT requestCancelPreviewWindow();
     }
@@ -24,6 +24,7 @@ class PreviewContainer : public QWidget
 
 public:
     explicit PreviewContainer(QWidget *parent = 0);
+    ~PreviewContainer() override;
 
     enum TitleDisplayMode {
         HoverShow       = 0,
@@ -49,7 +50,9 @@ public slots:
 
 private:
     void adjustSize(bool composite);
-    void appendSnapWidget(const WId wid);
+    void updateSnapWidgets(int count);
+    AppSnapshot *appendSnapWidget(const WId wid);
+    void releaseSnapWidget(AppSnapshot *snap);
 
     void enterEvent(QEvent *e);
     void leaveEvent(QEvent *e);
@@ -64,7 +67,8 @@ private slots:
 
 private:
     bool m_needActivate;
-    QMap<WId, AppSnapshot *> m_snapshots;
+    WindowInfoMap m_windowInfos;
+    QMap<WId, AppSnapshot *> m_snapshots;       // 当前显示的窗口和绑定的预览图
 
     FloatingPreview *m_floatingPreview;
     QBoxLayout *m_windowListLayout;
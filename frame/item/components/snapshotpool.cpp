@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "snapshotpool.h"
+#include "appsnapshot.h"
+
+#include <QApplication>
+
+SnapshotPool::SnapshotPool(QObject *parent)
+    : QObject(parent)
+    , m_capacity(0)
+{
+    // 空闲的控件没有父对象，需要在qApp析构之前释放
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [ this ] {
+        qDeleteAll(m_idleSnapshots);
+        m_idleSnapshots.clear();
+    });
+}
+
+SnapshotPool *SnapshotPool::instance()
+{
+    static SnapshotPool *pool = new SnapshotPool(qApp);
+    return pool;
+}
+
+/**
+ * @brief SnapshotPool::acquire 获取窗口的预览图控件，优先使用之前绑定过该窗口的控件，可以直接显示上次的预览图
+ */
+AppSnapshot *SnapshotPool::acquire(const WId wid)
+{
+    AppSnapshot *snap = nullptr;
+    for (AppSnapshot *idleSnap : m_idleSnapshots) {
+        if (idleSnap->wid() == wid) {
+            snap = idleSnap;
+            break;
+        }
+    }
+
+    if (!snap && !m_idleSnapshots.isEmpty())
+        snap = m_idleSnapshots.last();
+
+    if (!snap) {
+        snap = new AppSnapshot(wid);
+        snap->setVisible(false);
+        connect(snap, &AppSnapshot::destroyed, this, [ this, snap ] {
+            m_idleSnapshots.removeOne(snap);
+        });
+        return snap;
+    }
+
+    m_idleSnapshots.removeOne(snap);
+    snap->bind(wid);
+    return snap;
+}
+
+/**
+ * @brief SnapshotPool::release 回收不再使用的预览图控件，超过池的容量时释放
+ */
+void SnapshotPool::release(AppSnapshot *snap)
+{
+    if (!snap || m_idleSnapshots.contains(snap))
+        return;
+
+    snap->setVisible(false);
+    snap->setContentsMargins(0, 0, 0, 0);
+    snap->setParent(nullptr);
+
+    m_idleSnapshots.prepend(snap);
+    trim();
+}
+
+/**
+ * @brief SnapshotPool::reserve 池的容量为显示过的最多的预览图个数
+ */
+void SnapshotPool::reserve(int count)
+{
+    m_capacity = qMax(m_capacity, count);
+}
+
+void SnapshotPool::trim()
+{
+    // 最早回收的控件放在最后，优先释放
+    while (m_idleSnapshots.size() > m_capacity)
+        m_idleSnapshots.takeLast()->deleteLater();
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef SNAPSHOTPOOL_H
+#define SNAPSHOTPOOL_H
+
+#include <QObject>
+#include <QList>
+#include <QWidget>
+
+class AppSnapshot;
+
+/**
+ * @brief The SnapshotPool class
+ * 所有应用预览窗口共用的预览图控件池，预览窗口关闭后控件回收到池中，下次预览时重新绑定到窗口，
+ * 池中保留的控件个数和预览窗口能显示的预览图个数一致
+ */
+class SnapshotPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SnapshotPool *instance();
+
+    AppSnapshot *acquire(const WId wid);
+    void release(AppSnapshot *snap);
+    void reserve(int count);
+
+private:
+    explicit SnapshotPool(QObject *parent = nullptr);
+
+    void trim();
+
+private:
+    QList<AppSnapshot *> m_idleSnapshots;
+    int m_capacity;
+};
+
+#endif // SNAPSHOTPOOL_H
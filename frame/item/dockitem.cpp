@@ -6,6 +6,7 @@
 #include "dockitem.h"
 #include "pluginsitem.h"
 #include "utils.h"
+#include "dockapplication.h"
 
 #include <QMouseEvent>
 #include <QJsonObject>
@@ -27,8 +28,9 @@ DockItem::DockItem(QWidget *parent)
     , m_tapAndHold(false)
     , m_draging(false)
     , m_contextMenu(new QMenu(this))
-    , m_popupTipsDelayTimer(new QTimer(this))
-    , m_popupAdjustDelayTimer(new QTimer(this))
+    , m_paintStats(nullptr)
+    , m_popupTipsDelayTimer(this, 500, [ this ] { showHoverTips(); })
+    , m_popupAdjustDelayTimer(this, 10, [ this ] { updatePopupPosition(); })
 {
     if (PopupWindow.isNull()) {
         DockPopupWindow *blurRectangle = new DockPopupWindow(nullptr);
@@ -42,14 +44,6 @@ DockItem::DockItem(QWidget *parent)
         connect(qApp, &QApplication::aboutToQuit, PopupWindow, &DockPopupWindow::deleteLater);
     }
 
-    m_popupTipsDelayTimer->setInterval(500);
-    m_popupTipsDelayTimer->setSingleShot(true);
-
-    m_popupAdjustDelayTimer->setInterval(10);
-    m_popupAdjustDelayTimer->setSingleShot(true);
-
-    connect(m_popupTipsDelayTimer, &QTimer::timeout, this, &DockItem::showHoverTips);
-    connect(m_popupAdjustDelayTimer, &QTimer::timeout, this, &DockItem::updatePopupPosition, Qt::QueuedConnection);
     connect(m_contextMenu, &QMenu::triggered, this, &DockItem::menuActionClicked);
 
     grabGesture(Qt::TapAndHoldGesture);
@@ -105,23 +99,53 @@ bool DockItem::event(QEvent *event)
     if (m_popupShown) {
         switch (event->type()) {
         case QEvent::Paint:
-            if (!m_popupAdjustDelayTimer->isActive())
-                m_popupAdjustDelayTimer->start();
+            if (!m_popupAdjustDelayTimer.isActive())
+                m_popupAdjustDelayTimer.start();
             break;
         default:;
         }
     }
 
-    if (event->type() == QEvent::Gesture)
+    switch (event->type()) {
+    case QEvent::Gesture:
         gestureEvent(static_cast<QGestureEvent *>(event));
+        break;
+    case QEvent::Paint: {
+        // 统计包含子类paintEvent在内的整个绘制耗时
+        PaintScope scope(paintStats());
+        return QWidget::event(event);
+    }
+    case QEvent::Resize:
+    case QEvent::LayoutRequest:
+        // 显示之前的布局不统计，同时避免在子类构造过程中获取profileKey
+        if (isVisible())
+            PaintProfiler::instance()->recordLayout(paintStats());
+        break;
+    default:;
+    }
 
     return QWidget::event(event);
 }
 
-void DockItem::updatePopupPosition()
+/**
+ * @brief DockItem::profileKey 绘制统计中使用的名称，子类可以加上应用或者插件的名称以便区分
+ */
+QString DockItem::profileKey() const
 {
-    Q_ASSERT(sender() == m_popupAdjustDelayTimer);
+    return QString::fromLatin1(metaObject()->className());
+}
+
+PaintProfiler::Stats *DockItem::paintStats()
+{
+    // 构造函数中无法调用子类的profileKey，在第一次使用时再获取
+    if (!m_paintStats)
+        m_paintStats = PaintProfiler::instance()->stats(profileKey());
 
+    return m_paintStats;
+}
+
+void DockItem::updatePopupPosition()
+{
     if (!m_popupShown || !PopupWindow->model())
         return;
 
@@ -139,7 +163,7 @@ void DockItem::paintEvent(QPaintEvent *e)
 
 void DockItem::mousePressEvent(QMouseEvent *e)
 {
-    m_popupTipsDelayTimer->stop();
+    m_popupTipsDelayTimer.stop();
     hideNonModel();
 
     if (e->button() == Qt::RightButton) {
@@ -164,8 +188,8 @@ void DockItem::enterEvent(QEvent *e)
 //    m_hoverEffect->setHighlighting(true);
 
     // 触屏不显示hover效果
-    if (!qApp->property(IS_TOUCH_STATE).toBool()) {
-        m_popupTipsDelayTimer->start();
+    if (!DockApplication::isTouchState()) {
+        m_popupTipsDelayTimer.start();
     }
 
     update();
@@ -180,7 +204,7 @@ void DockItem::leaveEvent(QEvent *e)
     m_hover = false;
     //FIXME: 可能是qt的bug，概率性导致崩溃，待修复
 //    m_hoverEffect->setHighlighting(false);
-    m_popupTipsDelayTimer->stop();
+    m_popupTipsDelayTimer.stop();
 
     // auto hide if popup is not model window
     if (m_popupShown && !PopupWindow->model())
@@ -392,8 +416,8 @@ const QPoint DockItem::topleftPoint() const
 
 void DockItem::hidePopup()
 {
-    m_popupTipsDelayTimer->stop();
-    m_popupAdjustDelayTimer->stop();
+    m_popupTipsDelayTimer.stop();
+    m_popupAdjustDelayTimer.stop();
     m_popupShown = false;
     PopupWindow->hide();
 
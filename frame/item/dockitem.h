@@ -8,6 +8,8 @@
 
 #include "constants.h"
 #include "dockpopupwindow.h"
+#include "paintprofiler.h"
+#include "timerwheel.h"
 
 #include <QFrame>
 #include <QPointer>
@@ -85,6 +87,9 @@ protected:
     bool checkAndResetTapHoldGestureState();
     virtual void gestureEvent(QGestureEvent *event);
 
+    virtual QString profileKey() const;
+    PaintProfiler::Stats *paintStats();
+
 protected slots:
     void showContextMenu();
     void onContextMenuAccepted();
@@ -99,11 +104,12 @@ protected:
     bool m_tapAndHold;
     bool m_draging;
     QMenu *m_contextMenu;
+    PaintProfiler::Stats *m_paintStats;
 
     QPointer<QWidget> m_lastPopupWidget;
 
-    QTimer *m_popupTipsDelayTimer;
-    QTimer *m_popupAdjustDelayTimer;
+    WheelTimer m_popupTipsDelayTimer;
+    WheelTimer m_popupAdjustDelayTimer;
 
     static Position DockPosition;
     static DisplayMode DockDisplayMode;
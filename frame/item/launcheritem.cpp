@@ -8,6 +8,7 @@
 #include "utils.h"
 #include "../widgets/tipswidget.h"
 #include "dbusutil.h"
+#include "dbusstatistics.h"
 
 #include <QPainter>
 #include <QProcess>
@@ -90,9 +91,16 @@ void LauncherItem::mouseReleaseEvent(QMouseEvent *e)
             .path(launcherPath)
             .interface(launcherInterface);
 
-    QDBusPendingReply<bool> visibleReply = dbusSender.property("Visible").get();
-    if (!visibleReply.value())
-       dbusSender.method("Toggle").call();
+    bool visible = false;
+    {
+        DBusCallScope scope(launcherService, "Get.Visible");
+        QDBusPendingReply<bool> visibleReply = dbusSender.property("Visible").get();
+        visible = visibleReply.value();
+        scope.setError(visibleReply.isError());
+    }
+
+    if (!visible)
+       DBusStatistics::watch(dbusSender.method("Toggle").call(), launcherService, "Toggle");
 }
 
 QWidget *LauncherItem::popupTips()
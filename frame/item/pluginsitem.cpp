@@ -28,6 +28,7 @@ PluginsItem::PluginsItem(PluginsItemInterface *const pluginInter, const QString
     , m_jsonData(jsonData)
     , m_itemKey(itemKey)
     , m_dragging(false)
+    , m_widgetPaintStats(PaintProfiler::instance()->stats(QString("PluginsItem/%1/%2/widget").arg(pluginInter->pluginName()).arg(itemKey)))
     , m_gsettings(Utils::ModuleSettingsPtr(pluginInter->pluginName(), QByteArray(), this))
 {
     qDebug() << "load plugins item: " << pluginInter->pluginName() << itemKey << m_centralWidget;
@@ -118,6 +119,11 @@ void PluginsItem::onGSettingsChanged(const QString &key)
     }
 }
 
+QString PluginsItem::profileKey() const
+{
+    return QString("PluginsItem/%1/%2").arg(m_pluginInter->pluginName()).arg(m_itemKey);
+}
+
 QWidget *PluginsItem::centralWidget() const
 {
     return m_centralWidget;
@@ -139,7 +145,7 @@ void PluginsItem::mousePressEvent(QMouseEvent *e)
         MousePressPoint = e->pos();
 
     //handle context menu
-    m_popupTipsDelayTimer->stop();
+    m_popupTipsDelayTimer.stop();
     hideNonModel();
 
     if (e->button() == Qt::RightButton) {
@@ -227,6 +233,12 @@ void PluginsItem::showEvent(QShowEvent *event)
 bool PluginsItem::eventFilter(QObject *watched, QEvent *event)
 {
     if (watched == m_centralWidget) {
+        // 插件控件的绘制在插件内部完成，这里只统计重绘次数
+        if (event->type() == QEvent::Paint)
+            PaintProfiler::instance()->recordRepaint(m_widgetPaintStats);
+        else if (event->type() == QEvent::LayoutRequest)
+            PaintProfiler::instance()->recordLayout(m_widgetPaintStats);
+
         if (event->type() == QEvent::MouseButtonPress ||
                 event->type() == QEvent::MouseButtonRelease) {
             if (checkGSettingsControl()) {
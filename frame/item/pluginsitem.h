@@ -62,6 +62,7 @@ protected:
     const QString contextMenu() const override;
     QWidget *popupTips() override;
     void resizeEvent(QResizeEvent *event) override;
+    QString profileKey() const override;
 
 private:
     void startDrag();
@@ -76,6 +77,7 @@ private:
     QJsonObject m_jsonData;
     const QString m_itemKey;
     bool m_dragging;
+    PaintProfiler::Stats *m_widgetPaintStats;
 
     static QPoint MousePressPoint;
     const QGSettings *m_gsettings;
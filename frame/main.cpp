@@ -11,6 +11,7 @@
 #include "dockapplication.h"
 #include "traymainwindow.h"
 #include "windowmanager.h"
+#include "spantracer.h"
 
 #include <QDir>
 #include <QStandardPaths>
@@ -150,6 +151,8 @@ bool IsSaveMode()
 
 int main(int argc, char *argv[])
 {
+    const qint64 startNs = Utils::monotonicNs();
+
     QString currentDesktop = QString(getenv("XDG_CURRENT_DESKTOP"));
     if (currentDesktop.compare("DDE", Qt::CaseInsensitive) == 0 ||
         currentDesktop.compare("deepin", Qt::CaseInsensitive) == 0) {
@@ -161,6 +164,10 @@ int main(int argc, char *argv[])
     DockApplication::setAttribute(Qt::AA_EnableHighDpiScaling, true);
     DockApplication app(argc, argv);
 
+    // 跟踪器需要在qApp创建后初始化，之前的耗时使用记录的时间补充
+    SpanTracer *tracer = SpanTracer::instance();
+    tracer->addSpan("DockApplication", QByteArray(), startNs, Utils::monotonicNs());
+
     //崩溃信号
     signal(SIGSEGV, sig_crash);
     signal(SIGILL,  sig_crash);
@@ -208,28 +215,40 @@ int main(int argc, char *argv[])
     bool disablePlugin = parser.isSet(disablePlugOption);
     qApp->setProperty("safeMode", (isSafeMode || disablePlugin));
 
+    qint64 beginNs = Utils::monotonicNs();
     MultiScreenWorker multiScreenWorker;
+    tracer->addSpan("MultiScreenWorker", QByteArray(), beginNs, Utils::monotonicNs());
 
+    beginNs = Utils::monotonicNs();
     MainWindow mainWindow(&multiScreenWorker);
+    tracer->addSpan("MainWindow", QByteArray(), beginNs, Utils::monotonicNs());
+
+    beginNs = Utils::monotonicNs();
     TrayMainWindow trayMainWindow(&multiScreenWorker);
+    tracer->addSpan("TrayMainWindow", QByteArray(), beginNs, Utils::monotonicNs());
 
+    beginNs = Utils::monotonicNs();
     WindowManager windowManager(&multiScreenWorker);
+    tracer->addSpan("WindowManager", QByteArray(), beginNs, Utils::monotonicNs());
 
     // 保证添加窗口的先后顺序，先添加的窗口显示在左边，后添加的窗口显示在右边
     windowManager.addWindow(&mainWindow);
     windowManager.addWindow(&trayMainWindow);
 
     // 注册任务栏的DBus服务
+    beginNs = Utils::monotonicNs();
     DBusDockAdaptors adaptor(&windowManager);
 
     QDBusConnection::sessionBus().registerService("org.deepin.dde.Dock1");
     QDBusConnection::sessionBus().registerObject("/org/deepin/dde/Dock1", "org.deepin.dde.Dock1", &windowManager);
+    tracer->addSpan("registerDBusService", QByteArray(), beginNs, Utils::monotonicNs());
 
     // 当任务栏以-r参数启动时，设置CANSHOW未false，之后调用launch不显示任务栏
     qApp->setProperty("CANSHOW", !parser.isSet(runOption));
 
     windowManager.launch();
     mainWindow.setVisible(true);
+    tracer->addInstant("mainWindowVisible");
 
     // 判断是否进入安全模式，是否带有入参 -x
     if (!isSafeMode && !disablePlugin) {
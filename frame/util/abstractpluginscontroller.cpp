@@ -7,7 +7,9 @@
 #include "pluginsiteminterface.h"
 #include "utils.h"
 #include "settingconfig.h"
+#include "spantracer.h"
 #include "pluginmanagerinterface.h"
+#include "plugininitqueue.h"
 
 #include <DNotifySender>
 #include <DSysInfo>
@@ -15,17 +17,11 @@
 #include <QDebug>
 #include <QDir>
 #include <QMapIterator>
-
-static const QStringList CompatiblePluginApiList {
-    "1.1.1",
-    "1.2",
-    "1.2.1",
-    "1.2.2",
-    DOCK_PLUGIN_API_VERSION
-};
+#include <QElapsedTimer>
 
 AbstractPluginsController::AbstractPluginsController(QObject *parent)
     : QObject(parent)
+    , m_initQueue(new PluginInitQueue([ this ](PluginsItemInterface *interface) { initPlugin(interface); }, this))
     , m_pluginManager(nullptr)
 {
     qApp->installEventFilter(this);
@@ -77,20 +73,22 @@ void AbstractPluginsController::positionChanged()
 
 void AbstractPluginsController::loadPlugin(const QString &pluginFile)
 {
+    DOCK_TRACE_SCOPE_ARG("loadPlugin", pluginFile);
     QPluginLoader *pluginLoader = new QPluginLoader(pluginFile, this);
     const QJsonObject &meta = pluginLoader->metaData().value("MetaData").toObject();
     const QString &pluginApi = meta.value("api").toString();
     bool pluginIsValid = true;
-    if (pluginApi.isEmpty() || !CompatiblePluginApiList.contains(pluginApi)) {
+    if (!PluginLoader::isCompatibleApi(pluginApi)) {
         qDebug() << objectName()
-                 << "plugin api version not matched! expect versions:" << CompatiblePluginApiList
+                 << "plugin api version not matched! expect versions:" << PluginLoader::compatibleApiList()
                  << ", got version:" << pluginApi
                  << ", the plugin file is:" << pluginFile;
 
         pluginIsValid = false;
     }
 
-    PluginsItemInterface *interface = qobject_cast<PluginsItemInterface *>(pluginLoader->instance());
+    // api版本不匹配时不再加载动态库
+    PluginsItemInterface *interface = pluginIsValid ? qobject_cast<PluginsItemInterface *>(pluginLoader->instance()) : nullptr;
     if (!interface) {
         qDebug() << objectName() << "load plugin failed!!!" << pluginLoader->errorString() << pluginFile;
 
@@ -138,9 +136,7 @@ void AbstractPluginsController::loadPlugin(const QString &pluginFile)
     // NOTE(justforlxz): 插件的所有初始化工作都在init函数中进行，
     // loadPlugin函数是按队列执行的，initPlugin函数会有可能导致
     // 函数执行被阻塞。
-    QTimer::singleShot(1, this, [ = ] {
-        initPlugin(interface);
-    });
+    m_initQueue->enqueue(interface);
 }
 
 void AbstractPluginsController::initPlugin(PluginsItemInterface *interface)
@@ -149,14 +145,20 @@ void AbstractPluginsController::initPlugin(PluginsItemInterface *interface)
         return;
 
     qDebug() << objectName() << "init plugin: " << interface->pluginName();
+    DOCK_TRACE_SCOPE_ARG("initPlugin", interface->pluginName());
+    QElapsedTimer timer;
+    timer.start();
     interface->init(this);
+    const qint64 initMSecs = timer.elapsed();
 
     for (const auto &pair : m_pluginLoadMap.keys()) {
-        if (pair.second == interface)
+        if (pair.second == interface) {
             m_pluginLoadMap.insert(pair, true);
+            PluginLoader::recordInitTime(pair.first, initMSecs);
+        }
     }
 
-    qDebug() << objectName() << "init plugin finished: " << interface->pluginName();
+    qDebug() << objectName() << "init plugin finished: " << interface->pluginName() << "cost:" << initMSecs << "ms";
 
 }
 
@@ -18,6 +18,7 @@
 class PluginsItemInterface;
 class PluginAdapter;
 class PluginManagerInterface;
+class PluginInitQueue;
 
 class AbstractPluginsController : public QObject, PluginProxyInterface
 {
@@ -59,6 +60,7 @@ private:
 
     // filepath, interface, loaded
     QMap<QPair<QString, PluginsItemInterface *>, bool> m_pluginLoadMap;
+    PluginInitQueue *m_initQueue;
 
     QJsonObject m_pluginSettingsObject;
     PluginManagerInterface *m_pluginManager;
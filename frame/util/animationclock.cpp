@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "animationclock.h"
+
+#include <QApplication>
+#include <QTimer>
+#include <QWidget>
+
+// 每一帧的间隔(毫秒)，与原来QTimeLine默认的更新间隔相同，25帧每秒
+#define FRAME_INTERVAL 40
+
+AnimationClock::AnimationClock(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setInterval(FRAME_INTERVAL);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_clock.start();
+
+    connect(m_timer, &QTimer::timeout, this, &AnimationClock::onTick);
+}
+
+AnimationClock *AnimationClock::instance()
+{
+    static AnimationClock *clock = new AnimationClock(qApp);
+    return clock;
+}
+
+/**
+ * @brief AnimationClock::start 开始播放控件的动画，正在播放时从头开始
+ * @param target 播放动画的控件，每一帧调用它的update()
+ * @param duration 动画时长(毫秒)，结束时发送finished信号
+ */
+void AnimationClock::start(QWidget *target, int duration)
+{
+    if (!target)
+        return;
+
+    m_animations.insert(target, Animation { m_clock.elapsed(), duration });
+    connect(target, &QObject::destroyed, this, &AnimationClock::onTargetDestroyed, Qt::UniqueConnection);
+
+    target->update();
+
+    if (!m_timer->isActive())
+        m_timer->start();
+}
+
+/**
+ * @brief AnimationClock::stop 停止控件的动画，不发送finished信号
+ */
+void AnimationClock::stop(QWidget *target)
+{
+    if (!m_animations.remove(target))
+        return;
+
+    target->update();
+
+    if (m_animations.isEmpty())
+        m_timer->stop();
+}
+
+bool AnimationClock::isRunning(const QWidget *target) const
+{
+    return m_animations.contains(target);
+}
+
+/**
+ * @brief AnimationClock::elapsed
+ * @return 控件的动画已播放的时间(毫秒)，不超过动画时长，没有播放动画时返回-1
+ */
+qint64 AnimationClock::elapsed(const QWidget *target) const
+{
+    auto it = m_animations.constFind(target);
+    if (it == m_animations.constEnd())
+        return -1;
+
+    return qMin(m_clock.elapsed() - it->startTime, qint64(it->duration));
+}
+
+void AnimationClock::onTick()
+{
+    const qint64 now = m_clock.elapsed();
+
+    QList<QWidget *> finishedTargets;
+    for (auto it = m_animations.begin(); it != m_animations.end();) {
+        // 键值只在控件销毁前使用，此时一定是QWidget
+        QWidget *target = static_cast<QWidget *>(const_cast<QObject *>(it.key()));
+        target->update();
+
+        if (now - it->startTime >= it->duration) {
+            finishedTargets << target;
+            it = m_animations.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (m_animations.isEmpty())
+        m_timer->stop();
+
+    // 结束的控件可能在槽函数中重新开始动画，所以在遍历完成后再发送信号
+    for (QWidget *target : finishedTargets)
+        Q_EMIT finished(target);
+}
+
+void AnimationClock::onTargetDestroyed(QObject *target)
+{
+    m_animations.remove(target);
+
+    if (m_animations.isEmpty())
+        m_timer->stop();
+}
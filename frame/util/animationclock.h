@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ANIMATIONCLOCK_H
+#define ANIMATIONCLOCK_H
+
+#include <QObject>
+#include <QHash>
+#include <QElapsedTimer>
+
+class QTimer;
+class QWidget;
+
+/**
+ * @brief The AnimationClock class
+ * 任务栏共用的动画时钟，所有正在播放的动画由同一个定时器驱动，每一帧只刷新对应的控件，
+ * 控件在paintEvent中根据已播放的时间自行绘制，没有动画时定时器停止
+ */
+class AnimationClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AnimationClock *instance();
+
+    void start(QWidget *target, int duration);
+    void stop(QWidget *target);
+    bool isRunning(const QWidget *target) const;
+    qint64 elapsed(const QWidget *target) const;
+
+Q_SIGNALS:
+    void finished(QWidget *target);
+
+private:
+    explicit AnimationClock(QObject *parent = nullptr);
+
+    void onTick();
+    void onTargetDestroyed(QObject *target);
+
+private:
+    struct Animation
+    {
+        qint64 startTime;
+        int duration;
+    };
+
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    QHash<const QObject *, Animation> m_animations;
+};
+
+#endif // ANIMATIONCLOCK_H
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "appiconresolver.h"
+
+#include <QIcon>
+#include <QProcess>
+#include <QApplication>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include <DGuiApplicationHelper>
+#include <DPlatformTheme>
+
+DGUI_USE_NAMESPACE
+
+// 查找图标需要启动子进程，线程数不宜过多
+#define MAX_LOOKUP_THREAD 2
+#define MAX_PIXMAP_CACHE 256
+// 查找失败的图标再次查找的间隔(毫秒)，图标可能在之后才安装
+#define FAILED_RETRY_MSEC (60 * 1000)
+
+bool AppIconKey::operator==(const AppIconKey &other) const
+{
+    return (name == other.name
+            && size == other.size
+            && qFuzzyCompare(ratio, other.ratio)
+            && theme == other.theme);
+}
+
+uint qHash(const AppIconKey &key, uint seed)
+{
+    return qHash(key.name, seed) ^ qHash(key.size, seed) ^ qHash(qRound(key.ratio * 100), seed) ^ qHash(key.theme, seed);
+}
+
+AppIconResolver::AppIconResolver(QObject *parent)
+    : QObject(parent)
+    , m_threadPool(new QThreadPool(this))
+    , m_pixmapCache(MAX_PIXMAP_CACHE)
+{
+    m_threadPool->setMaxThreadCount(MAX_LOOKUP_THREAD);
+    m_clock.start();
+
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, this, &AppIconResolver::onThemeChanged);
+}
+
+AppIconResolver *AppIconResolver::instance()
+{
+    static AppIconResolver *resolver = new AppIconResolver(qApp);
+    return resolver;
+}
+
+/**
+ * @brief AppIconResolver::resolve 在工作线程中查找图标对应的主题图标名称
+ * @param name 图标名
+ * @return 查找结果，如果同名图标正在查找，则返回正在进行的查找
+ * @note 必须在GUI线程中调用，查找完成后会发送iconResolved信号
+ */
+QFuture<QString> AppIconResolver::resolve(const QString &name)
+{
+    const QString key = lookupKey(name);
+    if (m_pendingLookups.contains(key))
+        return m_pendingLookups.value(key);
+
+    QFuture<QString> future = QtConcurrent::run(m_threadPool, &AppIconResolver::findThemeIconName, name);
+    m_pendingLookups.insert(key, future);
+
+    QFutureWatcher<QString> *watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [ = ] {
+        onLookupFinished(key, name, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(future);
+
+    return future;
+}
+
+/**
+ * @brief AppIconResolver::pixmap 获取已经查找完成的图标
+ * @param pix 获取到的图标
+ * @param key 图标名、尺寸、缩放和主题
+ * @return 查找已完成并且成功获取到图标时返回true，否则发起异步查找并返回false
+ */
+bool AppIconResolver::pixmap(QPixmap &pix, const AppIconKey &key)
+{
+    if (QPixmap *cachePixmap = m_pixmapCache.object(key)) {
+        pix = *cachePixmap;
+        return true;
+    }
+
+    const QString lookup = lookupKey(key.name);
+    if (isFailed(lookup))
+        return false;
+
+    if (!m_resolvedNames.contains(lookup)) {
+        resolve(key.name);
+        return false;
+    }
+
+    const QIcon icon = QIcon::fromTheme(m_resolvedNames.value(lookup));
+    if (!icon.isNull())
+        pix = icon.pixmap(QSize(key.size, key.size));
+
+    if (icon.isNull() || pix.isNull()) {
+        // 图标可能在后续才安装，超过重试间隔后再重新查找
+        m_resolvedNames.remove(lookup);
+        m_failedLookups.insert(lookup, m_clock.elapsed());
+        return false;
+    }
+
+    m_pixmapCache.insert(key, new QPixmap(pix));
+    return true;
+}
+
+/**
+ * @brief AppIconResolver::findThemeIconName 通过qtxdg-iconfinder查找图标对应的主题图标名称
+ * @param name 图标名
+ * @return 主题图标名称，查找失败时返回传入的图标名
+ * @note 此函数会阻塞等待子进程结束，不要在GUI线程中调用
+ */
+QString AppIconResolver::findThemeIconName(const QString &name)
+{
+    QProcess process;
+    process.start("qtxdg-iconfinder", QStringList() << name);
+    process.closeWriteChannel();
+    process.waitForFinished();
+
+    int exitCode = process.exitCode();
+    QString outputTxt = process.readAllStandardOutput();
+
+    auto list = outputTxt.split("\n");
+
+    if (exitCode != 0 || list.size() <= 3)
+        return name;
+
+    // 去掉无用数据
+    list.removeFirst();
+    list.removeLast();
+    list.removeLast();
+
+    return list.first().simplified();
+}
+
+QString AppIconResolver::lookupKey(const QString &name) const
+{
+    return QIcon::themeName() + "/" + name;
+}
+
+void AppIconResolver::onLookupFinished(const QString &lookupKey, const QString &name, const QString &themeName)
+{
+    m_pendingLookups.remove(lookupKey);
+
+    // 主题在查找过程中被切换，结果已经无效
+    if (lookupKey != this->lookupKey(name))
+        return;
+
+    // 没有找到图标时记录失败，避免每次刷新都启动新的查找进程
+    const bool found = !QIcon::fromTheme(themeName).isNull();
+    if (found)
+        m_resolvedNames.insert(lookupKey, themeName);
+    else
+        m_failedLookups.insert(lookupKey, m_clock.elapsed());
+
+    Q_EMIT iconResolved(name, found);
+}
+
+void AppIconResolver::onThemeChanged()
+{
+    m_resolvedNames.clear();
+    m_failedLookups.clear();
+    m_pixmapCache.clear();
+}
+
+/**
+ * @brief AppIconResolver::isFailed 图标是否在重试间隔内查找失败过，超过重试间隔后清除失败记录
+ */
+bool AppIconResolver::isFailed(const QString &lookupKey)
+{
+    auto it = m_failedLookups.find(lookupKey);
+    if (it == m_failedLookups.end())
+        return false;
+
+    if (m_clock.elapsed() - it.value() < FAILED_RETRY_MSEC)
+        return true;
+
+    m_failedLookups.erase(it);
+    return false;
+}
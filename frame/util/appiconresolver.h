@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPICONRESOLVER_H
+#define APPICONRESOLVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QCache>
+#include <QFuture>
+#include <QPixmap>
+#include <QElapsedTimer>
+
+class QThreadPool;
+
+/**
+ * @brief The AppIconKey struct 图标请求的键值，同名图标在不同尺寸、缩放和主题下分别缓存
+ */
+struct AppIconKey
+{
+    QString name;
+    int size;
+    qreal ratio;
+    QString theme;
+
+    bool operator==(const AppIconKey &other) const;
+};
+
+uint qHash(const AppIconKey &key, uint seed = 0);
+
+/**
+ * @brief The AppIconResolver class
+ * 在工作线程中查找主题图标（qtxdg-iconfinder），避免在GUI线程中阻塞等待子进程，
+ * 相同图标的并发请求只会触发一次查找，查找完成后通过iconResolved信号通知界面刷新，
+ * 查找失败的图标在主题变化或者超过重试间隔之前不会再次查找
+ */
+class AppIconResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AppIconResolver *instance();
+
+    QFuture<QString> resolve(const QString &name);
+    bool pixmap(QPixmap &pix, const AppIconKey &key);
+    static QString findThemeIconName(const QString &name);
+
+Q_SIGNALS:
+    void iconResolved(const QString &name, bool found) const;
+
+private:
+    explicit AppIconResolver(QObject *parent = nullptr);
+
+    QString lookupKey(const QString &name) const;
+    void onLookupFinished(const QString &lookupKey, const QString &name, const QString &themeName);
+    void onThemeChanged();
+    bool isFailed(const QString &lookupKey);
+
+private:
+    QThreadPool *m_threadPool;
+    QHash<QString, QFuture<QString>> m_pendingLookups;  // 正在查找的图标，用于合并重复请求
+    QHash<QString, QString> m_resolvedNames;            // 已查找到的主题图标名称
+    QHash<QString, qint64> m_failedLookups;             // 查找失败的图标和失败的时间
+    QElapsedTimer m_clock;
+    QCache<AppIconKey, QPixmap> m_pixmapCache;
+};
+
+#endif // APPICONRESOLVER_H
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "clockservice.h"
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QDebug>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+ClockService::ClockService(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_timerFd(timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC))
+    , m_clockNotifier(nullptr)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ClockService::onTimeout);
+
+    if (m_timerFd >= 0 && armClockChangeNotifier()) {
+        m_clockNotifier = new QSocketNotifier(m_timerFd, QSocketNotifier::Read, this);
+        connect(m_clockNotifier, &QSocketNotifier::activated, this, &ClockService::onClockChanged);
+    } else {
+        qWarning() << "create clock change notifier failed, system time changes will be noticed at the next minute";
+    }
+
+    const QDateTime current = QDateTime::currentDateTime();
+    m_lastMinute = QDateTime(current.date(), QTime(current.time().hour(), current.time().minute()));
+    m_lastDate = current.date();
+
+    schedule();
+}
+
+ClockService::~ClockService()
+{
+    if (m_timerFd >= 0)
+        close(m_timerFd);
+}
+
+ClockService *ClockService::instance()
+{
+    static ClockService *service = new ClockService(qApp);
+    return service;
+}
+
+/**
+ * @brief ClockService::requestSeconds 需要按秒刷新，例如显示秒数的提示框显示时调用，
+ * 直到调用releaseSeconds或者requester被销毁为止
+ */
+void ClockService::requestSeconds(QObject *requester)
+{
+    if (!requester || m_secondRequesters.contains(requester))
+        return;
+
+    m_secondRequesters.insert(requester);
+    connect(requester, &QObject::destroyed, this, &ClockService::onRequesterDestroyed, Qt::UniqueConnection);
+
+    if (m_secondRequesters.size() == 1)
+        schedule();
+}
+
+void ClockService::releaseSeconds(QObject *requester)
+{
+    if (!m_secondRequesters.remove(requester))
+        return;
+
+    disconnect(requester, &QObject::destroyed, this, &ClockService::onRequesterDestroyed);
+
+    // 回到按分钟唤醒，当前这一秒的定时器到期后不再按秒刷新
+    if (m_secondRequesters.isEmpty())
+        schedule();
+}
+
+/**
+ * @brief ClockService::msecsToNextMinute
+ * @return 到下一个整分钟的毫秒数，正好在整分钟时返回一分钟
+ */
+qint64 ClockService::msecsToNextMinute(const QDateTime &dateTime)
+{
+    const QTime &time = dateTime.time();
+    return 60 * 1000 - (time.second() * 1000 + time.msec());
+}
+
+void ClockService::schedule()
+{
+    const QDateTime current = QDateTime::currentDateTime();
+    const qint64 interval = m_secondRequesters.isEmpty() ? msecsToNextMinute(current) : 1000 - current.time().msec();
+    m_timer->start(int(interval));
+}
+
+/**
+ * @brief ClockService::armClockChangeNotifier 设置一个永远不会到期的定时器，
+ * 系统时间被修改时定时器被取消，文件描述符变为可读
+ */
+bool ClockService::armClockChangeNotifier()
+{
+    itimerspec spec = {};
+    spec.it_value.tv_sec = std::numeric_limits<time_t>::max();
+    return timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, nullptr) == 0;
+}
+
+void ClockService::onTimeout()
+{
+    const QDateTime current = QDateTime::currentDateTime();
+
+    if (!m_secondRequesters.isEmpty())
+        Q_EMIT secondChanged(current);
+
+    // 定时器可能提前几毫秒到期，此时分钟还没有变化，只需要重新计算下一次唤醒的时间
+    const QDateTime minute(current.date(), QTime(current.time().hour(), current.time().minute()));
+    if (minute != m_lastMinute) {
+        m_lastMinute = minute;
+        Q_EMIT minuteChanged(current);
+
+        if (current.date() != m_lastDate) {
+            m_lastDate = current.date();
+            Q_EMIT dateChanged(m_lastDate);
+        }
+    }
+
+    schedule();
+}
+
+void ClockService::onClockChanged()
+{
+    // 定时器被取消时read返回ECANCELED，需要重新设置才能收到下一次修改的通知
+    quint64 expirations = 0;
+    if (read(m_timerFd, &expirations, sizeof(expirations)) < 0 && errno != ECANCELED && errno != EAGAIN)
+        qWarning() << "read clock change notifier failed:" << strerror(errno);
+
+    armClockChangeNotifier();
+
+    m_timer->stop();
+    onTimeout();
+}
+
+void ClockService::onRequesterDestroyed(QObject *requester)
+{
+    m_secondRequesters.remove(requester);
+    if (m_secondRequesters.isEmpty())
+        schedule();
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef CLOCKSERVICE_H
+#define CLOCKSERVICE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QSet>
+
+class QTimer;
+class QSocketNotifier;
+
+/**
+ * @brief The ClockService class
+ * 进程内共用的时钟，默认只在整分钟时唤醒一次，发送minuteChanged和跨天时的dateChanged信号；
+ * 只有在显示秒数的提示框可见时（调用requestSeconds后）才每秒唤醒一次。
+ * 系统时间被修改时通过timerfd的TFD_TIMER_CANCEL_ON_SET立即得到通知，重新对齐
+ */
+class ClockService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ClockService *instance();
+
+    void requestSeconds(QObject *requester);
+    void releaseSeconds(QObject *requester);
+
+    static qint64 msecsToNextMinute(const QDateTime &dateTime);
+
+Q_SIGNALS:
+    void secondChanged(const QDateTime &dateTime);
+    void minuteChanged(const QDateTime &dateTime);
+    void dateChanged(const QDate &date);
+
+private:
+    explicit ClockService(QObject *parent = nullptr);
+    ~ClockService() override;
+
+    void schedule();
+    bool armClockChangeNotifier();
+    void onTimeout();
+    void onClockChanged();
+    void onRequesterDestroyed(QObject *requester);
+
+private:
+    QTimer *m_timer;
+    int m_timerFd;
+    QSocketNotifier *m_clockNotifier;
+    QSet<const QObject *> m_secondRequesters;
+    QDateTime m_lastMinute;
+    QDate m_lastDate;
+};
+
+#endif // CLOCKSERVICE_H
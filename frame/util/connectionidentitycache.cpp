@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "connectionidentitycache.h"
+
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QFile>
+#include <QDebug>
+
+ConnectionIdentityCache::ConnectionIdentityCache(QObject *parent)
+    : QObject(parent)
+{
+    connect(QDBusConnection::sessionBus().interface(), &QDBusConnectionInterface::serviceOwnerChanged,
+            this, &ConnectionIdentityCache::onServiceOwnerChanged);
+}
+
+ConnectionIdentityCache *ConnectionIdentityCache::instance()
+{
+    static ConnectionIdentityCache *cache = new ConnectionIdentityCache(qApp);
+    return cache;
+}
+
+bool ConnectionIdentityCache::contains(const QString &service) const
+{
+    return m_identities.contains(service);
+}
+
+/**
+ * @brief ConnectionIdentityCache::identity 获取已缓存的进程信息，未缓存时返回空的信息
+ */
+ConnectionIdentity ConnectionIdentityCache::identity(const QString &service) const
+{
+    return m_identities.value(service);
+}
+
+/**
+ * @brief ConnectionIdentityCache::request 异步查询服务对应的进程信息，查询完成后发送identityReady信号
+ * @param service DBus服务名
+ */
+void ConnectionIdentityCache::request(const QString &service)
+{
+    if (service.isEmpty() || m_identities.contains(service) || m_pendingServices.contains(service))
+        return;
+
+    m_pendingServices.insert(service);
+
+    QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                      "org.freedesktop.DBus", "GetConnectionUnixProcessID");
+    msg << service;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ this, service ](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        // 查询期间服务已经退出，不再缓存
+        if (!m_pendingServices.remove(service))
+            return;
+
+        ConnectionIdentity identity;
+        QDBusPendingReply<uint> reply = *call;
+        if (reply.isError()) {
+            qDebug() << "get connection pid failed, service:" << service << reply.error().message();
+        } else {
+            identity.pid = reply.value();
+            identity.fileName = fileNameByPid(identity.pid);
+        }
+
+        m_identities.insert(service, identity);
+        Q_EMIT identityReady(service);
+    });
+}
+
+/**
+ * @brief ConnectionIdentityCache::serviceName 从托盘的服务路径(服务名/对象路径)中获取服务名
+ */
+QString ConnectionIdentityCache::serviceName(const QString &servicePath)
+{
+    return servicePath.section('/', 0, 0);
+}
+
+QString ConnectionIdentityCache::fileNameByPid(uint pid)
+{
+    if (pid == 0)
+        return QString();
+
+    QFile file(QString("/proc/%1/cmdline").arg(pid));
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+
+    // cmdline中的参数以'\0'分隔，这里只取第一个参数
+    return QString(file.readAll());
+}
+
+void ConnectionIdentityCache::onServiceOwnerChanged(const QString &service, const QString &oldOwner, const QString &newOwner)
+{
+    Q_UNUSED(newOwner);
+
+    if (oldOwner.isEmpty())
+        return;
+
+    m_identities.remove(service);
+    m_pendingServices.remove(service);
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef CONNECTIONIDENTITYCACHE_H
+#define CONNECTIONIDENTITYCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+
+/**
+ * @brief The ConnectionIdentity struct DBus连接对应的进程信息
+ */
+struct ConnectionIdentity
+{
+    uint pid = 0;
+    QString fileName;       // 进程的程序路径（/proc/<pid>/cmdline中的第一个参数）
+};
+
+/**
+ * @brief The ConnectionIdentityCache class
+ * 缓存DBus服务名对应的进程信息，异步调用GetConnectionUnixProcessID获取进程号，
+ * 服务名的所有者变化(NameOwnerChanged)时清除缓存，托盘中的各个模块共用
+ */
+class ConnectionIdentityCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ConnectionIdentityCache *instance();
+
+    bool contains(const QString &service) const;
+    ConnectionIdentity identity(const QString &service) const;
+    void request(const QString &service);
+
+    static QString serviceName(const QString &servicePath);
+    static QString fileNameByPid(uint pid);
+
+Q_SIGNALS:
+    void identityReady(const QString &service) const;
+
+private:
+    explicit ConnectionIdentityCache(QObject *parent = nullptr);
+
+    void onServiceOwnerChanged(const QString &service, const QString &oldOwner, const QString &newOwner);
+
+private:
+    QHash<QString, ConnectionIdentity> m_identities;
+    QSet<QString> m_pendingServices;    // 正在查询的服务，同一个服务同时只查询一次
+};
+
+#endif // CONNECTIONIDENTITYCACHE_H
@@ -0,0 +1,312 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbusstatistics.h"
+#include "spantracer.h"
+#include "sharedinstance.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QDBusAbstractInterface>
+#include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+#include <algorithm>
+
+#define DBUS_STATISTICS_PROPERTY "_dock_dbus_statistics"
+#define PROPERTIES_INTERFACE "org.freedesktop.DBus.Properties"
+// 主线程中超过这个时间(毫秒)的同步调用输出警告
+#define GUI_BLOCKING_WARNING_MSEC 50
+
+// 直方图各区间的上限(毫秒)，最后一个区间记录所有超过100ms的调用
+static const qint64 HistogramBounds[DBUS_HISTOGRAM_SIZE - 1] = { 1, 2, 5, 10, 25, 50, 100 };
+
+DBusStatistics::DBusStatistics()
+{
+    m_elapsed.start();
+}
+
+DBusStatistics *DBusStatistics::instance()
+{
+    static DBusStatistics *statistics = Utils::sharedInstance<DBusStatistics>(DBUS_STATISTICS_PROPERTY, [] { return new DBusStatistics; });
+
+    return statistics;
+}
+
+bool DBusStatistics::isEnabled()
+{
+    return SpanTracer::instance()->isEnabled();
+}
+
+/**
+ * @brief DBusStatistics::onTraceEnabledChanged 开启或关闭跟踪后，为已经创建的代理类添加或移除信号的匹配规则
+ */
+void DBusStatistics::onTraceEnabledChanged(bool enabled)
+{
+    QMutexLocker locker(&m_mutex);
+    m_counters.removeAll(nullptr);
+    for (const QPointer<DBusSignalCounter> &counter : m_counters)
+        QMetaObject::invokeMethod(counter, "setWatching", Q_ARG(bool, enabled));
+}
+
+QString DBusStatistics::key(const QString &service, const QString &member)
+{
+    return QString("%1 %2").arg(service).arg(member);
+}
+
+int DBusStatistics::bucketIndex(qint64 latencyNs)
+{
+    const qint64 latencyMs = latencyNs / 1000000;
+    for (int i = 0; i < DBUS_HISTOGRAM_SIZE - 1; ++i) {
+        if (latencyMs < HistogramBounds[i])
+            return i;
+    }
+
+    return DBUS_HISTOGRAM_SIZE - 1;
+}
+
+void DBusStatistics::recordCall(const QString &service, const QString &member, CallType type, qint64 latencyNs, bool error)
+{
+    if (!isEnabled())
+        return;
+
+    const bool onGuiThread = (type == SyncCall && qApp && QThread::currentThread() == qApp->thread());
+    if (onGuiThread && latencyNs >= GUI_BLOCKING_WARNING_MSEC * 1000000ll)
+        qWarning() << "blocking dbus call on gui thread:" << service << member << latencyNs / 1000000 << "ms";
+
+    QMutexLocker locker(&m_mutex);
+    Entry &entry = m_entries[key(service, member)];
+    if (type == SyncCall)
+        ++entry.syncCalls;
+    else
+        ++entry.asyncCalls;
+
+    if (onGuiThread)
+        ++entry.guiBlockingCalls;
+
+    if (error)
+        ++entry.errors;
+
+    if (latencyNs >= 0) {
+        ++entry.timedCalls;
+        entry.totalNs += latencyNs;
+        entry.maxNs = qMax(entry.maxNs, latencyNs);
+        ++entry.histogram[bucketIndex(latencyNs)];
+    }
+}
+
+void DBusStatistics::recordSignal(const QString &service, const QString &member)
+{
+    if (!isEnabled())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    ++m_entries[key(service, member)].signalCount;
+}
+
+QHash<QString, DBusStatistics::Entry> DBusStatistics::entries() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries;
+}
+
+/**
+ * @brief DBusStatistics::report 导出统计结果
+ * @return JSON格式的字符串，按照调用和信号的总次数从多到少排序
+ */
+QString DBusStatistics::report() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QList<QPair<QString, Entry>> entries;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+        entries << qMakePair(it.key(), it.value());
+
+    std::sort(entries.begin(), entries.end(), [](const QPair<QString, Entry> &entry1, const QPair<QString, Entry> &entry2) {
+        return entry1.second.syncCalls + entry1.second.asyncCalls + entry1.second.signalCount
+                > entry2.second.syncCalls + entry2.second.asyncCalls + entry2.second.signalCount;
+    });
+
+    QJsonArray items;
+    for (const QPair<QString, Entry> &pair : entries) {
+        const Entry &entry = pair.second;
+
+        QJsonArray histogram;
+        for (quint64 count : entry.histogram)
+            histogram << qint64(count);
+
+        QJsonObject item;
+        item["service"] = pair.first.section(' ', 0, 0);
+        item["member"] = pair.first.section(' ', 1);
+        item["syncCalls"] = qint64(entry.syncCalls);
+        item["asyncCalls"] = qint64(entry.asyncCalls);
+        item["signals"] = qint64(entry.signalCount);
+        item["errors"] = qint64(entry.errors);
+        item["guiBlockingCalls"] = qint64(entry.guiBlockingCalls);
+        item["avgMs"] = entry.timedCalls ? entry.totalNs / 1000000.0 / entry.timedCalls : 0.0;
+        item["maxMs"] = entry.maxNs / 1000000.0;
+        item["histogram"] = histogram;
+        items << item;
+    }
+
+    QJsonArray bounds;
+    for (qint64 bound : HistogramBounds)
+        bounds << bound;
+
+    QJsonObject report;
+    report["elapsedMSecs"] = m_elapsed.elapsed();
+    report["histogramBoundsMs"] = bounds;
+    report["items"] = items;
+
+    return QString::fromUtf8(QJsonDocument(report).toJson(QJsonDocument::Indented));
+}
+
+void DBusStatistics::dumpToLog() const
+{
+    const QHash<QString, Entry> &allEntries = entries();
+    qInfo() << "dbus statistics, entries:" << allEntries.size();
+    for (auto it = allEntries.constBegin(); it != allEntries.constEnd(); ++it) {
+        const Entry &entry = it.value();
+        qInfo().noquote() << it.key()
+                          << "sync:" << entry.syncCalls
+                          << "async:" << entry.asyncCalls
+                          << "signals:" << entry.signalCount
+                          << "errors:" << entry.errors
+                          << "guiBlocking:" << entry.guiBlockingCalls
+                          << "avgMs:" << (entry.timedCalls ? entry.totalNs / 1000000.0 / entry.timedCalls : 0.0)
+                          << "maxMs:" << entry.maxNs / 1000000.0;
+    }
+}
+
+void DBusStatistics::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_elapsed.restart();
+}
+
+/**
+ * @brief DBusStatistics::property 读取代理类的属性，属性读取是同步的Get调用，统计其耗时
+ */
+QVariant DBusStatistics::property(const QDBusAbstractInterface *inter, const char *name)
+{
+    if (!isEnabled())
+        return inter->property(name);
+
+    DBusCallScope scope(inter->service(), QString("Get.%1").arg(QString::fromLatin1(name)));
+    const QVariant &value = inter->property(name);
+    scope.setError(!value.isValid());
+
+    return value;
+}
+
+/**
+ * @brief DBusStatistics::setProperty 设置代理类的属性，属性设置是同步的Set调用，统计其耗时
+ */
+bool DBusStatistics::setProperty(QDBusAbstractInterface *inter, const char *name, const QVariant &value)
+{
+    if (!isEnabled())
+        return inter->setProperty(name, value);
+
+    DBusCallScope scope(inter->service(), QString("Set.%1").arg(QString::fromLatin1(name)));
+    const bool ret = inter->setProperty(name, value);
+    scope.setError(!ret);
+
+    return ret;
+}
+
+QDBusPendingCall DBusStatistics::asyncCall(QDBusAbstractInterface *inter, const QString &method, const QList<QVariant> &args)
+{
+    return watch(inter->asyncCallWithArgumentList(method, args), inter->service(), method);
+}
+
+/**
+ * @brief DBusStatistics::watch 统计异步调用从发出到收到返回的耗时
+ * @return 传入的call，方便直接返回
+ */
+QDBusPendingCall DBusStatistics::watch(const QDBusPendingCall &call, const QString &service, const QString &member)
+{
+    if (!isEnabled())
+        return call;
+
+    const qint64 beginNs = Utils::monotonicNs();
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished, watcher, [ = ] {
+        instance()->recordCall(service, member, AsyncCall, Utils::monotonicNs() - beginNs, watcher->isError());
+        watcher->deleteLater();
+    });
+
+    return call;
+}
+
+/**
+ * @brief DBusStatistics::watchSignals 统计代理类对应接口上的所有信号。
+ * 需要在总线上额外添加匹配规则，只在开启跟踪时添加，运行中开启跟踪时由onTraceEnabledChanged补上
+ * @param propertiesChanged 是否同时统计属性变化信号，有自己的属性变化处理函数的类在处理函数中调用recordSignal统计
+ */
+void DBusStatistics::watchSignals(QDBusAbstractInterface *inter, bool propertiesChanged)
+{
+    DBusSignalCounter *counter = new DBusSignalCounter(inter, propertiesChanged);
+    if (isEnabled())
+        counter->setWatching(true);
+
+    DBusStatistics *statistics = instance();
+    QMutexLocker locker(&statistics->m_mutex);
+    statistics->m_counters.removeAll(nullptr);
+    statistics->m_counters << counter;
+}
+
+DBusCallScope::DBusCallScope(const QString &service, const QString &member)
+    : m_service(service)
+    , m_member(member)
+    , m_beginNs(DBusStatistics::isEnabled() ? Utils::monotonicNs() : -1)
+    , m_error(false)
+{
+}
+
+DBusCallScope::~DBusCallScope()
+{
+    if (m_beginNs >= 0)
+        DBusStatistics::instance()->recordCall(m_service, m_member, DBusStatistics::SyncCall, Utils::monotonicNs() - m_beginNs, m_error);
+}
+
+DBusSignalCounter::DBusSignalCounter(QDBusAbstractInterface *inter, bool propertiesChanged)
+    : QObject(inter)
+    , m_inter(inter)
+    , m_propertiesChanged(propertiesChanged)
+    , m_watching(false)
+{
+}
+
+void DBusSignalCounter::setWatching(bool watching)
+{
+    if (m_watching == watching)
+        return;
+
+    m_watching = watching;
+    QDBusConnection connection = m_inter->connection();
+    if (watching) {
+        connection.connect(m_inter->service(), m_inter->path(), m_inter->interface(), QString(),
+                           this, SLOT(onSignal(const QDBusMessage &)));
+        if (m_propertiesChanged)
+            connection.connect(m_inter->service(), m_inter->path(), PROPERTIES_INTERFACE, "PropertiesChanged",
+                               this, SLOT(onSignal(const QDBusMessage &)));
+    } else {
+        connection.disconnect(m_inter->service(), m_inter->path(), m_inter->interface(), QString(),
+                              this, SLOT(onSignal(const QDBusMessage &)));
+        if (m_propertiesChanged)
+            connection.disconnect(m_inter->service(), m_inter->path(), PROPERTIES_INTERFACE, "PropertiesChanged",
+                                  this, SLOT(onSignal(const QDBusMessage &)));
+    }
+}
+
+void DBusSignalCounter::onSignal(const QDBusMessage &message)
+{
+    // 信号的发送者是唯一名称，这里使用代理类对应的服务名，便于和调用统计对应
+    DBusStatistics::instance()->recordSignal(m_inter->service(), message.member());
+}
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DBUSSTATISTICS_H
+#define DBUSSTATISTICS_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QPointer>
+
+class QDBusAbstractInterface;
+class DBusSignalCounter;
+
+// 调用耗时直方图的区间个数
+#define DBUS_HISTOGRAM_SIZE 8
+
+/**
+ * @brief The DBusStatistics class
+ * 统计任务栏发出的DBus调用和收到的DBus信号，按照服务名+方法名(或信号名)分类，
+ * 记录同步/异步调用次数、往返耗时、错误次数，以及在主线程中发生的阻塞调用。
+ * 通过DBus接口dbusStatistics获取统计结果，或者调用dumpDBusStatistics输出到日志中。
+ * 只在开启跟踪(DDE_DOCK_TRACE或DBus接口setTraceEnabled)时统计，未开启时每次调用只有一次原子读取的开销。
+ * 插件中编译的代码通过qApp的属性共用任务栏中的实例
+ */
+class DBusStatistics
+{
+public:
+    enum CallType {
+        SyncCall,
+        AsyncCall
+    };
+
+    struct Entry
+    {
+        quint64 syncCalls = 0;
+        quint64 asyncCalls = 0;
+        quint64 signalCount = 0;
+        quint64 errors = 0;
+        quint64 guiBlockingCalls = 0;     // 在主线程中的同步调用
+        quint64 timedCalls = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        quint64 histogram[DBUS_HISTOGRAM_SIZE] = {};
+    };
+
+    static DBusStatistics *instance();
+    static bool isEnabled();
+
+    void onTraceEnabledChanged(bool enabled);
+
+    void recordCall(const QString &service, const QString &member, CallType type, qint64 latencyNs, bool error);
+    void recordSignal(const QString &service, const QString &member);
+
+    QHash<QString, Entry> entries() const;
+    QString report() const;
+    void dumpToLog() const;
+    void reset();
+
+    static int bucketIndex(qint64 latencyNs);
+    static QString key(const QString &service, const QString &member);
+
+    // 给代理类使用的辅助函数
+    static QVariant property(const QDBusAbstractInterface *inter, const char *name);
+    static bool setProperty(QDBusAbstractInterface *inter, const char *name, const QVariant &value);
+    static QDBusPendingCall asyncCall(QDBusAbstractInterface *inter, const QString &method, const QList<QVariant> &args);
+    static QDBusPendingCall watch(const QDBusPendingCall &call, const QString &service, const QString &member);
+    static void watchSignals(QDBusAbstractInterface *inter, bool propertiesChanged = false);
+
+private:
+    DBusStatistics();
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QElapsedTimer m_elapsed;
+    QList<QPointer<DBusSignalCounter>> m_counters;
+};
+
+/**
+ * @brief The DBusCallScope class 统计作用域内的同步DBus调用
+ */
+class DBusCallScope
+{
+public:
+    DBusCallScope(const QString &service, const QString &member);
+    ~DBusCallScope();
+
+    void setError(bool error) { m_error = error; }
+
+private:
+    Q_DISABLE_COPY(DBusCallScope)
+
+    QString m_service;
+    QString m_member;
+    qint64 m_beginNs;
+    bool m_error;
+};
+
+/**
+ * @brief The DBusSignalCounter class 统计某个接口上收到的所有信号
+ */
+class DBusSignalCounter : public QObject
+{
+    Q_OBJECT
+
+public:
+    DBusSignalCounter(QDBusAbstractInterface *inter, bool propertiesChanged);
+
+    Q_INVOKABLE void setWatching(bool watching);
+
+private Q_SLOTS:
+    void onSignal(const QDBusMessage &message);
+
+private:
+    QDBusAbstractInterface *m_inter;
+    bool m_propertiesChanged;   // 同时统计属性变化信号
+    bool m_watching;
+};
+
+#endif // DBUSSTATISTICS_H
@@ -8,30 +8,58 @@
 #include <QMouseEvent>
 #include <QTouchEvent>
 
+bool DockApplication::IsTouchState = false;
+
 DockApplication::DockApplication(int &argc, char **argv)
     : DApplication (argc, argv)
 {
+    setProperty(IS_TOUCH_STATE, IsTouchState);
 }
 
 bool DockApplication::notify(QObject *obj, QEvent *event)
 {
-    QMouseEvent *mouseEvent = dynamic_cast<QMouseEvent *>(event);
-
-    if (mouseEvent) {
-        // 鼠标事件可以通过source函数确定是否触屏事件，并将结果写入qApp的动态属性中
-        const Qt::MouseEventSource src = mouseEvent->source();
-        if (src == Qt::MouseEventSynthesizedByQt || src == Qt::MouseEventSynthesizedByApplication) {
-            qApp->setProperty(IS_TOUCH_STATE, true);
-        } else {
-            qApp->setProperty(IS_TOUCH_STATE, false);
-        }
+    // 根据事件类型判断，避免对每个事件都做dynamic_cast
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::NonClientAreaMouseButtonPress:
+    case QEvent::NonClientAreaMouseButtonRelease:
+    case QEvent::NonClientAreaMouseButtonDblClick:
+    case QEvent::NonClientAreaMouseMove: {
+        // 鼠标事件可以通过source函数确定是否触屏事件
+        const Qt::MouseEventSource src = static_cast<QMouseEvent *>(event)->source();
+        setTouchState(src == Qt::MouseEventSynthesizedByQt || src == Qt::MouseEventSynthesizedByApplication);
+        break;
     }
-
-    // 任务栏屏蔽多指触控
-    QTouchEvent *touchEvent = dynamic_cast<QTouchEvent *>(event);
-    if(touchEvent && (touchEvent->touchPoints().size() > 1)) {
-        return true;
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+        // 任务栏屏蔽多指触控
+        if (static_cast<QTouchEvent *>(event)->touchPoints().size() > 1)
+            return true;
+        break;
+    default:
+        break;
     }
 
     return DApplication::notify(obj, event);
 }
+
+bool DockApplication::isTouchState()
+{
+    return IsTouchState;
+}
+
+void DockApplication::setTouchState(bool isTouch)
+{
+    // 只在状态变化时写入属性，避免安装在qApp上的事件过滤器频繁处理属性变化事件
+    if (IsTouchState == isTouch)
+        return;
+
+    IsTouchState = isTouch;
+    setProperty(IS_TOUCH_STATE, isTouch);
+
+    Q_EMIT touchStateChanged(isTouch);
+}
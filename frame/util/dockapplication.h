@@ -18,6 +18,8 @@ DUTIL_USE_NAMESPACE
 /**
  * @brief The DockApplication class
  * 本类通过重写application的notify函数监控应用的鼠标事件，判断是否为触屏状态
+ * 触屏状态只在变化时更新，任务栏内部通过isTouchState和touchStateChanged获取，
+ * 插件仍然可以通过qApp的IS_TOUCH_STATE属性获取
  */
 class DockApplication : public DApplication
 {
@@ -25,6 +27,17 @@ class DockApplication : public DApplication
 public:
     explicit DockApplication(int &argc, char **argv);
     virtual bool notify(QObject *obj, QEvent *event) override;
+
+    static bool isTouchState();
+
+Q_SIGNALS:
+    void touchStateChanged(bool isTouch);
+
+private:
+    void setTouchState(bool isTouch);
+
+private:
+    static bool IsTouchState;
 };
 
 #endif // DOCKAPPLICATION_H
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "icondiskcache.h"
+#include "sharedinstance.h"
+
+#include <QDir>
+#include <QIcon>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDirIterator>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QApplication>
+#include <QThread>
+#include <QDebug>
+
+#include <DApplication>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+DWIDGET_USE_NAMESPACE
+
+#define CACHE_MAGIC 0x43494444          // "DDIC"
+#define CACHE_VERSION 1
+#define CACHE_EXPIRED_DAYS 30
+#define ICON_DISK_CACHE_PROPERTY "_dock_icon_disk_cache"
+
+namespace {
+
+struct CacheHeader
+{
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+};
+
+struct MappedData
+{
+    void *data;
+    size_t length;
+};
+
+void unmapCacheFile(void *info)
+{
+    MappedData *mapped = static_cast<MappedData *>(info);
+    munmap(mapped->data, mapped->length);
+    delete mapped;
+}
+
+}
+
+IconDiskCache::IconDiskCache(QObject *parent)
+    : QObject(parent)
+    , m_cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/dde-dock/icons")
+    , m_themeName(QIcon::themeName())
+{
+    DApplication *app = qobject_cast<DApplication *>(qApp);
+    if (app)
+        connect(app, &DApplication::iconThemeChanged, this, &IconDiskCache::onIconThemeChanged);
+
+    // 清理过期缓存不需要阻塞界面
+    QThread *cleanThread = QThread::create([ this ] { removeExpiredFiles(); });
+    connect(cleanThread, &QThread::finished, cleanThread, &QThread::deleteLater);
+    cleanThread->start(QThread::LowestPriority);
+}
+
+IconDiskCache *IconDiskCache::instance()
+{
+    // 多个插件中也编译了这份代码，共用一个实例，避免重复清理缓存目录
+    static IconDiskCache *cache = Utils::sharedInstance<IconDiskCache>(ICON_DISK_CACHE_PROPERTY, [] { return new IconDiskCache(qApp); });
+    return cache;
+}
+
+/**
+ * @brief IconDiskCache::find 从磁盘缓存中读取图标
+ * @param iconName 图标名
+ * @param size 图标尺寸
+ * @param ratio 缩放比例
+ * @param pix 读取到的图标
+ * @param sourceFile 图标的源文件，为空时表示图标只来自当前主题，源文件修改后缓存失效
+ * @return 缓存存在且有效时返回true
+ */
+bool IconDiskCache::find(const QString &iconName, const QSize &size, qreal ratio, QPixmap &pix, const QString &sourceFile)
+{
+    const QByteArray fileName = QFile::encodeName(cacheFile(iconName, size, ratio, sourceFile));
+
+    int fd = open(fileName.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(CacheHeader))) {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    // 文件可能被其他程序修改，头部的每一项都要检查，格式只能是写入时使用的格式
+    const CacheHeader *header = static_cast<const CacheHeader *>(data);
+    if (header->magic != CACHE_MAGIC || header->version != CACHE_VERSION
+            || header->width <= 0 || header->height <= 0
+            || header->format != QImage::Format_ARGB32_Premultiplied
+            || qint64(header->bytesPerLine) < qint64(header->width) * 4
+            || st.st_size < static_cast<off_t>(sizeof(CacheHeader) + qint64(header->bytesPerLine) * header->height)) {
+        munmap(data, static_cast<size_t>(st.st_size));
+        return false;
+    }
+
+    // 图像数据直接使用映射的内存（只读，修改时QImage会自动拷贝），最后一个引用释放时解除映射
+    MappedData *mapped = new MappedData { data, static_cast<size_t>(st.st_size) };
+    const uchar *bits = static_cast<const uchar *>(data) + sizeof(CacheHeader);
+    const QImage image(bits, header->width, header->height, header->bytesPerLine,
+                       QImage::Format_ARGB32_Premultiplied, unmapCacheFile, mapped);
+
+    pix = QPixmap::fromImage(image);
+    pix.setDevicePixelRatio(ratio);
+
+    return !pix.isNull();
+}
+
+/**
+ * @brief IconDiskCache::insert 将渲染后的图标写入磁盘缓存
+ */
+void IconDiskCache::insert(const QString &iconName, const QSize &size, qreal ratio, const QPixmap &pix, const QString &sourceFile)
+{
+    if (pix.isNull())
+        return;
+
+    const QString fileName = cacheFile(iconName, size, ratio, sourceFile);
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+        return;
+
+    const QImage image = pix.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const CacheHeader header { CACHE_MAGIC, CACHE_VERSION, image.width(), image.height(),
+                image.bytesPerLine(), static_cast<qint32>(image.format()) };
+
+    // 先写入临时文件再重命名，避免其他进程读取到不完整的缓存
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    if (!file.commit())
+        qWarning() << "write icon cache failed:" << fileName;
+}
+
+QString IconDiskCache::cacheFile(const QString &iconName, const QSize &size, qreal ratio, const QString &sourceFile)
+{
+    const qint64 sourceStamp = sourceFile.isEmpty() ? 0 : QFileInfo(sourceFile).lastModified().toSecsSinceEpoch();
+
+    const QString key = QString("%1|%2|%3x%4|%5|%6|%7|%8").arg(iconName).arg(m_themeName)
+            .arg(size.width()).arg(size.height()).arg(ratio)
+            .arg(sourceFile).arg(themeStamp(m_themeName)).arg(sourceStamp);
+    const QString hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    return QString("%1/%2/%3").arg(m_cacheDir).arg(m_themeName).arg(hash);
+}
+
+qint64 IconDiskCache::themeStamp(const QString &theme)
+{
+    if (m_themeStamps.contains(theme))
+        return m_themeStamps.value(theme);
+
+    // 安装或更新图标时会刷新icon-theme.cache，取主题目录及其索引文件中最新的修改时间
+    qint64 stamp = 0;
+    for (const QString &searchPath : QIcon::themeSearchPaths()) {
+        for (const QString &themeName : { theme, QString("hicolor") }) {
+            const QString themeDir = searchPath + "/" + themeName;
+            for (const QString &path : { themeDir, themeDir + "/index.theme", themeDir + "/icon-theme.cache" }) {
+                const QFileInfo info(path);
+                if (info.exists())
+                    stamp = qMax(stamp, info.lastModified().toSecsSinceEpoch());
+            }
+        }
+    }
+
+    m_themeStamps.insert(theme, stamp);
+    return stamp;
+}
+
+void IconDiskCache::onIconThemeChanged()
+{
+    const QString oldTheme = m_themeName;
+    m_themeName = QIcon::themeName();
+    m_themeStamps.clear();
+
+    if (oldTheme != m_themeName && !oldTheme.isEmpty())
+        QDir(m_cacheDir + "/" + oldTheme).removeRecursively();
+}
+
+void IconDiskCache::removeExpiredFiles()
+{
+    const QDateTime expiredTime = QDateTime::currentDateTime().addDays(-CACHE_EXPIRED_DAYS);
+
+    QDirIterator it(m_cacheDir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileInfo().lastModified() < expiredTime)
+            QFile::remove(it.filePath());
+    }
+}
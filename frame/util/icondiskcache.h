@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ICONDISKCACHE_H
+#define ICONDISKCACHE_H
+
+#include <QObject>
+#include <QPixmap>
+#include <QHash>
+#include <QDateTime>
+
+/**
+ * @brief The IconDiskCache class
+ * 渲染后图标的磁盘缓存，位于$XDG_CACHE_HOME/dde-dock/icons/<主题名>下，
+ * 文件名为图标名、主题、尺寸、缩放和图标源文件修改时间的哈希值，
+ * 读取时直接将文件映射到内存中，无需再次解析SVG或查找主题
+ */
+class IconDiskCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconDiskCache *instance();
+
+    bool find(const QString &iconName, const QSize &size, qreal ratio, QPixmap &pix, const QString &sourceFile = QString());
+    void insert(const QString &iconName, const QSize &size, qreal ratio, const QPixmap &pix, const QString &sourceFile = QString());
+
+private:
+    explicit IconDiskCache(QObject *parent = nullptr);
+
+    QString cacheFile(const QString &iconName, const QSize &size, qreal ratio, const QString &sourceFile);
+    qint64 themeStamp(const QString &theme);
+    void onIconThemeChanged();
+    void removeExpiredFiles();
+
+private:
+    QString m_cacheDir;
+    QString m_themeName;
+    QHash<QString, qint64> m_themeStamps;   // 主题目录的最后修改时间，主题包更新后缓存自动失效
+};
+
+#endif // ICONDISKCACHE_H
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "imageutil.h"
+#include "icondiskcache.h"
 
 #include <QIcon>
 #include <QPainter>
@@ -15,7 +16,10 @@
 #include <QDBusInterface>
 #include <QDBusReply>
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QDBusUnixFileDescriptor>
+#include <QPixmapCache>
 
 #include <X11/Xcursor/Xcursor.h>
 
@@ -24,6 +28,68 @@
 #include <iosfwd>
 
 const QPixmap ImageUtil::loadSvg(const QString &iconName, const QString &localPath, const int size, const qreal ratio)
+{
+    QString localIcon = QString("%1%2%3").arg(localPath).arg(iconName).arg(iconName.contains(".svg") ? "" : ".svg");
+    const QString memoryKey = memoryCacheKey(iconName, localIcon, QSize(size, size), ratio);
+    QPixmap pixmap;
+    if (QPixmapCache::find(memoryKey, &pixmap))
+        return pixmap;
+
+    if (!IconDiskCache::instance()->find(iconName, QSize(size, size), ratio, pixmap, localIcon)) {
+        pixmap = renderSvg(iconName, localIcon, size, ratio);
+        IconDiskCache::instance()->insert(iconName, QSize(size, size), ratio, pixmap, localIcon);
+    }
+
+    if (!pixmap.isNull())
+        QPixmapCache::insert(memoryKey, pixmap);
+
+    return pixmap;
+}
+
+const QPixmap ImageUtil::loadSvg(const QString &iconName, const QSize size, const qreal ratio)
+{
+    const QString memoryKey = memoryCacheKey(iconName, QString(), size, ratio);
+    QPixmap pixmap;
+    if (QPixmapCache::find(memoryKey, &pixmap))
+        return pixmap;
+
+    if (IconDiskCache::instance()->find(iconName, size, ratio, pixmap)) {
+        QPixmapCache::insert(memoryKey, pixmap);
+        return pixmap;
+    }
+
+    QIcon icon = QIcon::fromTheme(iconName);
+    if (!icon.isNull()) {
+        pixmap = icon.pixmap(QCoreApplication::testAttribute(Qt::AA_UseHighDpiPixmaps) ? size : QSize(size * ratio));
+        pixmap.setDevicePixelRatio(ratio);
+        if (ratio != 1) {
+            if (pixmap.size().width() > size.width() * ratio)
+                pixmap = pixmap.scaledToWidth(size.width() * ratio);
+            if (pixmap.size().height() > size.height() * ratio)
+                pixmap = pixmap.scaledToHeight(size.height() * ratio);
+        }
+
+        IconDiskCache::instance()->insert(iconName, size, ratio, pixmap);
+        QPixmapCache::insert(memoryKey, pixmap);
+        return pixmap;
+    }
+    return QPixmap();
+}
+
+/**
+ * @brief ImageUtil::memoryCacheKey 内存缓存的键值，绘制时先从内存缓存中读取，
+ * 同一个图标、尺寸和缩放只在第一次加载时访问磁盘缓存，主题名作为键值的一部分，切换主题后自动失效；
+ * 本地图标文件的修改时间也作为键值的一部分，修改文件后重新加载
+ */
+QString ImageUtil::memoryCacheKey(const QString &iconName, const QString &localIcon, const QSize &size, qreal ratio)
+{
+    const qint64 localStamp = localIcon.isEmpty() ? 0 : QFileInfo(localIcon).lastModified().toMSecsSinceEpoch();
+
+    return QString("dock-svg/%1/%2/%3/%4/%5x%6@%7").arg(QIcon::themeName()).arg(iconName).arg(localIcon).arg(localStamp)
+            .arg(size.width()).arg(size.height()).arg(ratio);
+}
+
+const QPixmap ImageUtil::renderSvg(const QString &iconName, const QString &localIcon, const int size, const qreal ratio)
 {
     QIcon icon = QIcon::fromTheme(iconName);
     int pixmapSize = QCoreApplication::testAttribute(Qt::AA_UseHighDpiPixmaps) ? size : int(size * ratio);
@@ -36,7 +102,6 @@ const QPixmap ImageUtil::loadSvg(const QString &iconName, const QString &localPa
     }
 
     QPixmap pixmap(pixmapSize, pixmapSize);
-    QString localIcon = QString("%1%2%3").arg(localPath).arg(iconName).arg(iconName.contains(".svg") ? "" : ".svg");
     QSvgRenderer renderer(localIcon);
     pixmap.fill(Qt::transparent);
 
@@ -52,25 +117,6 @@ const QPixmap ImageUtil::loadSvg(const QString &iconName, const QString &localPa
     return pixmap.scaled(size * ratio, size * ratio);
 }
 
-const QPixmap ImageUtil::loadSvg(const QString &iconName, const QSize size, const qreal ratio)
-{
-    QIcon icon = QIcon::fromTheme(iconName);
-    if (!icon.isNull()) {
-        QPixmap pixmap = icon.pixmap(QCoreApplication::testAttribute(Qt::AA_UseHighDpiPixmaps) ? size : QSize(size * ratio));
-        pixmap.setDevicePixelRatio(ratio);
-        if (ratio == 1)
-            return pixmap;
-
-        if (pixmap.size().width() > size.width() * ratio)
-            pixmap = pixmap.scaledToWidth(size.width() * ratio);
-        if (pixmap.size().height() > size.height() * ratio)
-            pixmap = pixmap.scaledToHeight(size.height() * ratio);
-
-        return pixmap;
-    }
-    return QPixmap();
-}
-
 QCursor* ImageUtil::loadQCursorFromX11Cursor(const char* theme, const char* cursorName, int cursorSize)
 {
     if (!theme || !cursorName || cursorSize <= 0)
@@ -22,6 +22,9 @@ public:
     // 加载窗口的预览图
     static QPixmap loadWindowThumb(const QString &winInfoId);                      // 加载图片，参数为windowId或者窗口的UUID
 
+private:
+    static QString memoryCacheKey(const QString &iconName, const QString &localIcon, const QSize &size, qreal ratio);
+    static const QPixmap renderSvg(const QString &iconName, const QString &localIcon, const int size, const qreal ratio);
 };
 
 #endif // IMAGEUTIL_H
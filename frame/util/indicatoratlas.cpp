@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "indicatoratlas.h"
+
+#include <DPlatformTheme>
+
+#include <QApplication>
+#include <QPainter>
+#include <QSvgRenderer>
+
+IndicatorAtlas::IndicatorAtlas(QObject *parent)
+    : QObject(parent)
+    , m_activeColor(DGuiApplicationHelper::instance()->systemTheme()->activeColor())
+{
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::activeColorChanged, this, &IndicatorAtlas::onActiveColorChanged);
+}
+
+IndicatorAtlas *IndicatorAtlas::instance()
+{
+    static IndicatorAtlas *atlas = new IndicatorAtlas(qApp);
+    return atlas;
+}
+
+/**
+ * @brief IndicatorAtlas::indicator 获取运行指示器图片
+ * @param themeType 主题类型
+ * @param position 任务栏位置，上下方向为横向指示器，左右方向为纵向指示器
+ * @param active 是否为活动窗口，活动窗口的指示器使用主题活动色填充
+ * @param ratio 缩放比例
+ * @return 已设置缩放比例的图片，首次获取时渲染，之后直接返回缓存
+ */
+QPixmap IndicatorAtlas::indicator(DGuiApplicationHelper::ColorType themeType, Dock::Position position, bool active, qreal ratio)
+{
+    const bool vertical = (position == Dock::Left || position == Dock::Right);
+    // 活动指示器使用活动色填充，与主题类型无关
+    const QString key = QString("%1|%2|%3|%4").arg(active ? -1 : themeType).arg(vertical).arg(active).arg(ratio);
+
+    auto it = m_indicators.constFind(key);
+    if (it != m_indicators.constEnd())
+        return it.value();
+
+    const QPixmap &pixmap = render(themeType, vertical, active, ratio);
+    m_indicators.insert(key, pixmap);
+
+    return pixmap;
+}
+
+QPixmap IndicatorAtlas::render(DGuiApplicationHelper::ColorType themeType, bool vertical, bool active, qreal ratio) const
+{
+    QString fileName;
+    if (active)
+        fileName = vertical ? "indicator_active_ver" : "indicator_active";
+    else if (themeType == DGuiApplicationHelper::DarkType)
+        fileName = vertical ? "indicator_dark_ver" : "indicator_dark";
+    else
+        fileName = vertical ? "indicator_ver" : "indicator";
+
+    QSvgRenderer renderer(QString(":/indicator/resources/%1.svg").arg(fileName));
+    if (!renderer.isValid())
+        return QPixmap();
+
+    QPixmap pixmap(renderer.defaultSize() * ratio);
+    if (active) {
+        pixmap.fill(m_activeColor);
+    } else {
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        renderer.render(&painter);
+    }
+    pixmap.setDevicePixelRatio(ratio);
+
+    return pixmap;
+}
+
+void IndicatorAtlas::onActiveColorChanged(const QColor &color)
+{
+    if (m_activeColor == color)
+        return;
+
+    m_activeColor = color;
+    m_indicators.clear();
+
+    Q_EMIT indicatorChanged();
+}
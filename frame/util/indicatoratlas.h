@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef INDICATORATLAS_H
+#define INDICATORATLAS_H
+
+#include "constants.h"
+
+#include <DGuiApplicationHelper>
+
+#include <QObject>
+#include <QHash>
+#include <QPixmap>
+#include <QColor>
+
+DGUI_USE_NAMESPACE
+
+/**
+ * @brief The IndicatorAtlas class
+ * 时尚模式下应用图标下方的运行指示器，按主题类型、缩放、方向和活动色预先渲染，
+ * 所有应用共用同一份图片，主题色变化时清空重新渲染，避免每次绘制都解析SVG
+ */
+class IndicatorAtlas : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IndicatorAtlas *instance();
+
+    QPixmap indicator(DGuiApplicationHelper::ColorType themeType, Dock::Position position, bool active, qreal ratio);
+
+Q_SIGNALS:
+    void indicatorChanged() const;
+
+private:
+    explicit IndicatorAtlas(QObject *parent = nullptr);
+
+    QPixmap render(DGuiApplicationHelper::ColorType themeType, bool vertical, bool active, qreal ratio) const;
+    void onActiveColorChanged(const QColor &color);
+
+private:
+    QHash<QString, QPixmap> m_indicators;
+    QColor m_activeColor;
+};
+
+#endif // INDICATORATLAS_H
@@ -7,6 +7,7 @@
 #include "dockitemmanager.h"
 #include "utils.h"
 #include "displaymanager.h"
+#include "dbusstatistics.h"
 
 #include <QAction>
 #include <QMenu>
@@ -140,12 +141,12 @@ void MenuWorker::createMenu(QMenu *settingsMenu)
 
 void MenuWorker::onDockSettingsTriggered()
 {
-    DDBusSender().service(controllCenterService)
+    DBusStatistics::watch(DDBusSender().service(controllCenterService)
             .path(controllCenterPath)
             .interface(controllCenterInterface)
             .method("ShowPage")
             .arg(QString("personalization/desktop/dock"))
-            .call();
+            .call(), controllCenterService, "ShowPage");
 }
 
 void MenuWorker::exec()
@@ -13,6 +13,7 @@
 #include "windowmanager.h"
 #include "dockitemmanager.h"
 #include "dockscreen.h"
+#include "dbusstatistics.h"
 
 #include <QWidget>
 #include <QScreen>
@@ -276,192 +277,123 @@ void MultiScreenWorker::onOpacityChanged(const double value)
  * 触发时机:屏幕大小,屏幕坐标,屏幕数量,发生变化
  *          任务栏位置发生变化
  *          任务栏'模式'发生变化
+ * 每次变化只计算一次区域，和已经注册的区域比较，只重新注册发生变化的区域
  */
 void MultiScreenWorker::onRequestUpdateRegionMonitor()
 {
-    if (!m_registerKey.isEmpty()) {
-#ifdef QT_DEBUG
-        bool ret = m_eventInter->UnregisterArea(m_registerKey);
-        qDebug() << "取消唤起区域监听:" << ret;
-#else
-        m_eventInter->UnregisterArea(m_registerKey);
-#endif
-        m_registerKey.clear();
-    }
-
-    if (!m_extralRegisterKey.isEmpty()) {
-#ifdef QT_DEBUG
-        bool ret = m_extralEventInter->UnregisterArea(m_extralRegisterKey);
-        qDebug() << "取消任务栏外部区域监听:" << ret;
-#else
-        m_extralEventInter->UnregisterArea(m_extralRegisterKey);
-#endif
-        m_extralRegisterKey.clear();
-    }
-
-    if (!m_touchRegisterKey.isEmpty()) {
-        m_touchEventInter->UnregisterArea(m_touchRegisterKey);
-        m_touchRegisterKey.clear();
-    }
-
     const static int flags = Motion | Button | Key;
     const static int monitorHeight = static_cast<int>(15 * qApp->devicePixelRatio());
     // 后端认为的任务栏大小(无缩放因素影响)
     const int realDockSize = int((m_displayMode == DisplayMode::Fashion ? m_dockInter->windowSizeFashion() + 2 * 10 /*上下的边距各10像素*/ : m_dockInter->windowSizeEfficient()) * qApp->devicePixelRatio());
+    // 触屏监控高度固定调整为最大任务栏高度100+任务栏与屏幕边缘间距
+    const int monitHeight = 100 + WINDOWMARGIN;
 
-    // 任务栏唤起区域
-    m_monitorRectList.clear();
+    QList<QRect> screenRects;
     for (auto s : DIS_INS->screens()) {
         // 屏幕此位置不可停靠时,不用监听这块区域
         if (!DIS_INS->canDock(s, m_position))
             continue;
 
-        MonitRect monitorRect;
         QRect screenRect = s->geometry();
         screenRect.setSize(screenRect.size() * s->devicePixelRatio());
-
-        switch (m_position) {
-        case Top: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + monitorHeight;
-        }
-            break;
-        case Bottom: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y() + screenRect.height() - monitorHeight;
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
-            break;
-        case Left: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + monitorHeight;
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
-            break;
-        case Right: {
-            monitorRect.x1 = screenRect.x() + screenRect.width() - monitorHeight;
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
-            break;
-        }
-
-        if (!m_monitorRectList.contains(monitorRect)) {
-            m_monitorRectList << monitorRect;
-#ifdef QT_DEBUG
-            qDebug() << "监听区域：" << monitorRect.x1 << monitorRect.y1 << monitorRect.x2 << monitorRect.y2;
-#endif
-        }
+        screenRects << screenRect;
     }
 
-    m_extralRectList.clear();
-    for (auto s : DIS_INS->screens()) {
-        // 屏幕此位置不可停靠时,不用监听这块区域
-        if (!DIS_INS->canDock(s, m_position))
-            continue;
+    // 任务栏唤起区域、任务栏内部区域、触屏唤起区域
+    const QList<MonitRect> monitorRects = edgeRects(screenRects, m_position, monitorHeight);
+    const QList<MonitRect> extralRects = edgeRects(screenRects, m_position, realDockSize);
+    const QList<MonitRect> touchRects = edgeRects(screenRects, m_position, monitHeight);
 
-        MonitRect monitorRect;
-        QRect screenRect = s->geometry();
-        screenRect.setSize(screenRect.size() * s->devicePixelRatio());
+    const bool monitorChanged = unregisterArea(m_eventInter, m_registerKey, m_monitorRectList, monitorRects);
+    const bool extralChanged = unregisterArea(m_extralEventInter, m_extralRegisterKey, m_extralRectList, extralRects);
+    const bool touchChanged = unregisterArea(m_touchEventInter, m_touchRegisterKey, m_touchRectList, touchRects);
 
-        switch (m_position) {
-        case Top: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + realDockSize;
-        }
-            break;
-        case Bottom: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y() + screenRect.height() - realDockSize;
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
-            break;
-        case Left: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + realDockSize;
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
-            break;
-        case Right: {
-            monitorRect.x1 = screenRect.x() + screenRect.width() - realDockSize;
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
-            break;
-        }
-
-        if (!m_extralRectList.contains(monitorRect)) {
-            m_extralRectList << monitorRect;
 #ifdef QT_DEBUG
-            qDebug() << "任务栏内部区域：" << monitorRect.x1 << monitorRect.y1 << monitorRect.x2 << monitorRect.y2;
-#endif
-        }
+    if (monitorChanged) {
+        for (const MonitRect &rect : monitorRects)
+            qDebug() << "监听区域：" << rect.x1 << rect.y1 << rect.x2 << rect.y2;
     }
 
-    // 触屏监控高度固定调整为最大任务栏高度100+任务栏与屏幕边缘间距
-    const int monitHeight = 100 + WINDOWMARGIN;
+    if (extralChanged) {
+        for (const MonitRect &rect : extralRects)
+            qDebug() << "任务栏内部区域：" << rect.x1 << rect.y1 << rect.x2 << rect.y2;
+    }
+#endif
 
-    // 任务栏触屏唤起区域
-    m_touchRectList.clear();
-    for (auto s : DIS_INS->screens()) {
-        // 屏幕此位置不可停靠时,不用监听这块区域
-        if (!DIS_INS->canDock(s, m_position))
-            continue;
+    // RegisterAreas需要等待返回的key，先发出所有的注册请求，再统一等待返回，避免多次串行的往返
+    QDBusPendingReply<QString> monitorReply;
+    QDBusPendingReply<QString> extralReply;
+    QDBusPendingReply<QString> touchReply;
+    if (monitorChanged)
+        monitorReply = DBusStatistics::watch(m_eventInter->RegisterAreas(monitorRects, flags), xEventMonitorService, "RegisterAreas");
+    if (extralChanged)
+        extralReply = DBusStatistics::watch(m_extralEventInter->RegisterAreas(extralRects, flags), xEventMonitorService, "RegisterAreas");
+    if (touchChanged)
+        touchReply = DBusStatistics::watch(m_touchEventInter->RegisterAreas(touchRects, flags), xEventMonitorService, "RegisterAreas");
+
+    if (monitorChanged)
+        m_registerKey = monitorReply.value();
+    if (extralChanged)
+        m_extralRegisterKey = extralReply.value();
+    if (touchChanged)
+        m_touchRegisterKey = touchReply.value();
+}
 
+/**
+ * @brief edgeRects 计算每个屏幕靠近任务栏一侧的监听区域
+ * @param screenRects 可以停靠任务栏的屏幕区域(物理像素)
+ * @param position 任务栏位置
+ * @param size 区域的宽度(左右方向)或者高度(上下方向)
+ * @return 去掉重复后的区域，复制模式下多个屏幕只有一个区域
+ */
+QList<MonitRect> MultiScreenWorker::edgeRects(const QList<QRect> &screenRects, const Position &position, int size)
+{
+    QList<MonitRect> rects;
+    for (const QRect &screenRect : screenRects) {
         MonitRect monitorRect;
-        QRect screenRect = s->geometry();
-        screenRect.setSize(screenRect.size() * s->devicePixelRatio());
-
-        switch (m_position) {
-        case Top: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + monitHeight;
-        }
+        monitorRect.x1 = screenRect.x();
+        monitorRect.y1 = screenRect.y();
+        monitorRect.x2 = screenRect.x() + screenRect.width();
+        monitorRect.y2 = screenRect.y() + screenRect.height();
+
+        switch (position) {
+        case Top:
+            monitorRect.y2 = monitorRect.y1 + size;
             break;
-        case Bottom: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y() + screenRect.height() - monitHeight;
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
+        case Bottom:
+            monitorRect.y1 = monitorRect.y2 - size;
             break;
-        case Left: {
-            monitorRect.x1 = screenRect.x();
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + monitHeight;
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
+        case Left:
+            monitorRect.x2 = monitorRect.x1 + size;
             break;
-        case Right: {
-            monitorRect.x1 = screenRect.x() + screenRect.width() - monitHeight;
-            monitorRect.y1 = screenRect.y();
-            monitorRect.x2 = screenRect.x() + screenRect.width();
-            monitorRect.y2 = screenRect.y() + screenRect.height();
-        }
+        case Right:
+            monitorRect.x1 = monitorRect.x2 - size;
             break;
         }
 
-        if (!m_touchRectList.contains(monitorRect)) {
-            m_touchRectList << monitorRect;
-        }
+        if (!rects.contains(monitorRect))
+            rects << monitorRect;
+    }
 
+    return rects;
+}
+
+/**
+ * @brief unregisterArea 区域发生变化时注销已经注册的区域，注销不需要等待返回
+ * @return 区域是否需要重新注册
+ */
+bool MultiScreenWorker::unregisterArea(XEventMonitor *eventInter, QString &key, QList<MonitRect> &registeredRects, const QList<MonitRect> &rects)
+{
+    if (!key.isEmpty() && registeredRects == rects)
+        return false;
+
+    if (!key.isEmpty()) {
+        DBusStatistics::watch(eventInter->UnregisterArea(key), xEventMonitorService, "UnregisterArea");
+        key.clear();
     }
 
-    m_registerKey = m_eventInter->RegisterAreas(m_monitorRectList, flags);
-    m_extralRegisterKey = m_extralEventInter->RegisterAreas(m_extralRectList, flags);
-    m_touchRegisterKey = m_touchEventInter->RegisterAreas(m_touchRectList, flags);
+    registeredRects = rects;
+    return true;
 }
 
 /**
@@ -777,6 +709,9 @@ bool MultiScreenWorker::isCursorOut(int x, int y)
 void MultiScreenWorker::checkXEventMonitorService()
 {
     auto connectionInit = [ = ](XEventMonitor * eventInter, XEventMonitor * extralEventInter, XEventMonitor * touchEventInter) {
+        // 三个代理监听的是同一个接口，只统计一次信号
+        DBusStatistics::watchSignals(eventInter);
+
         connect(eventInter, &XEventMonitor::CursorMove, this, &MultiScreenWorker::onRegionMonitorChanged);
         connect(eventInter, &XEventMonitor::ButtonPress, this, [ = ] { setStates(MousePress, true); });
         connect(eventInter, &XEventMonitor::ButtonRelease, this, [ = ] { setStates(MousePress, false); });
@@ -816,6 +751,12 @@ void MultiScreenWorker::checkXEventMonitorService()
                 // connect
                 connectionInit(m_eventInter, m_extralEventInter, m_touchEventInter);
 
+                // 服务启动前注册的区域已经无效，需要重新注册
+                m_registerKey.clear();
+                m_extralRegisterKey.clear();
+                m_touchRegisterKey.clear();
+                onRequestUpdateRegionMonitor();
+
                 disconnect(ifc);
             }
         });
@@ -165,6 +165,9 @@ private:
 
     bool isCursorOut(int x, int y);
 
+    static QList<MonitRect> edgeRects(const QList<QRect> &screenRects, const Position &position, int size);
+    bool unregisterArea(XEventMonitor *eventInter, QString &key, QList<MonitRect> &registeredRects, const QList<MonitRect> &rects);
+
     bool onScreenEdge(const QString &screenName, const QPoint &point);
     const QPoint rawXPosition(const QPoint &scaledPos);
     static bool isCopyMode();
@@ -196,7 +199,7 @@ private:
     QString m_extralRegisterKey;
     QString m_touchRegisterKey;                 // 触控屏唤起任务栏监控区域key
     QPoint m_touchPos;                          // 触屏按下坐标
-    QList<MonitRect> m_monitorRectList;         // 监听唤起任务栏区域
+    QList<MonitRect> m_monitorRectList;         // 监听唤起任务栏区域,和已注册的区域一致
     QList<MonitRect> m_extralRectList;          // 任务栏外部区域,随m_monitorRectList一起更新
     QList<MonitRect> m_touchRectList;           // 监听触屏唤起任务栏区域
     QString m_delayScreen;                      // 任务栏将要切换到的屏幕名
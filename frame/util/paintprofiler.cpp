@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "paintprofiler.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+
+// 直方图各区间的上限(微秒)，最后一个区间记录所有超过16ms的绘制
+static const qint64 HistogramBounds[PAINT_HISTOGRAM_SIZE - 1] = { 50, 100, 250, 500, 1000, 2000, 4000, 8000, 16000 };
+
+PaintProfiler::PaintProfiler()
+{
+    m_elapsed.start();
+}
+
+PaintProfiler *PaintProfiler::instance()
+{
+    static PaintProfiler *profiler = new PaintProfiler;
+    return profiler;
+}
+
+/**
+ * @brief PaintProfiler::stats 获取对应的统计项，不存在时创建
+ * @param key 一般为类名加上应用或插件的名称
+ * @return 统计项，调用release之前一直有效，调用方可以保存起来
+ */
+PaintProfiler::Stats *PaintProfiler::stats(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    Stats *&stats = m_stats[key];
+    if (!stats)
+        stats = new Stats;
+
+    ++stats->users;
+    return stats;
+}
+
+/**
+ * @brief PaintProfiler::release 不再使用统计项，所有使用者都释放后从统计结果中移除
+ */
+void PaintProfiler::release(Stats *stats)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!stats || --stats->users > 0)
+        return;
+
+    m_stats.remove(m_stats.key(stats));
+    delete stats;
+}
+
+int PaintProfiler::bucketIndex(qint64 durationNs)
+{
+    const qint64 durationUs = durationNs / 1000;
+    for (int i = 0; i < PAINT_HISTOGRAM_SIZE - 1; ++i) {
+        if (durationUs < HistogramBounds[i])
+            return i;
+    }
+
+    return PAINT_HISTOGRAM_SIZE - 1;
+}
+
+void PaintProfiler::recordPaint(Stats *stats, qint64 durationNs)
+{
+    if (!stats || durationNs < 0)
+        return;
+
+    stats->paintCount.fetchAndAddRelaxed(1);
+    stats->timedPaintCount.fetchAndAddRelaxed(1);
+    stats->totalNs.fetchAndAddRelaxed(quint64(durationNs));
+    stats->histogram[bucketIndex(durationNs)].fetchAndAddRelaxed(1);
+
+    quint64 maxNs = stats->maxNs.loadAcquire();
+    while (quint64(durationNs) > maxNs && !stats->maxNs.testAndSetOrdered(maxNs, quint64(durationNs), maxNs));
+}
+
+/**
+ * @brief PaintProfiler::recordRepaint 只记录重绘次数，用于无法统计耗时的控件(例如插件提供的控件)
+ */
+void PaintProfiler::recordRepaint(Stats *stats)
+{
+    if (stats)
+        stats->paintCount.fetchAndAddRelaxed(1);
+}
+
+void PaintProfiler::recordLayout(Stats *stats)
+{
+    if (stats)
+        stats->layoutCount.fetchAndAddRelaxed(1);
+}
+
+/**
+ * @brief PaintProfiler::report 导出统计结果
+ * @return JSON格式的字符串，按照重绘次数从多到少排序
+ */
+QString PaintProfiler::report() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const qint64 elapsedMSecs = qMax<qint64>(1, m_elapsed.elapsed());
+
+    QList<QJsonObject> items;
+    for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) {
+        const Stats *stats = it.value();
+        const quint64 paintCount = stats->paintCount.loadAcquire();
+        const quint64 timedPaintCount = stats->timedPaintCount.loadAcquire();
+        const quint64 layoutCount = stats->layoutCount.loadAcquire();
+        if (paintCount == 0 && layoutCount == 0)
+            continue;
+
+        QJsonArray histogram;
+        for (int i = 0; i < PAINT_HISTOGRAM_SIZE; ++i)
+            histogram << qint64(stats->histogram[i].loadAcquire());
+
+        QJsonObject item;
+        item["key"] = it.key();
+        item["paints"] = qint64(paintCount);
+        item["layouts"] = qint64(layoutCount);
+        item["paintsPerSecond"] = paintCount * 1000.0 / elapsedMSecs;
+        item["avgUs"] = timedPaintCount ? stats->totalNs.loadAcquire() / 1000.0 / timedPaintCount : 0.0;
+        item["maxUs"] = stats->maxNs.loadAcquire() / 1000.0;
+        item["histogram"] = histogram;
+        items << item;
+    }
+
+    std::sort(items.begin(), items.end(), [](const QJsonObject &item1, const QJsonObject &item2) {
+        return item1.value("paints").toDouble() > item2.value("paints").toDouble();
+    });
+
+    QJsonArray bounds;
+    for (qint64 bound : HistogramBounds)
+        bounds << bound;
+
+    QJsonArray itemArray;
+    for (const QJsonObject &item : items)
+        itemArray << item;
+
+    QJsonObject report;
+    report["elapsedMSecs"] = elapsedMSecs;
+    report["histogramBoundsUs"] = bounds;
+    report["items"] = itemArray;
+
+    return QString::fromUtf8(QJsonDocument(report).toJson(QJsonDocument::Indented));
+}
+
+void PaintProfiler::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    for (Stats *stats : m_stats) {
+        stats->paintCount.storeRelease(0);
+        stats->timedPaintCount.storeRelease(0);
+        stats->totalNs.storeRelease(0);
+        stats->maxNs.storeRelease(0);
+        stats->layoutCount.storeRelease(0);
+        for (int i = 0; i < PAINT_HISTOGRAM_SIZE; ++i)
+            stats->histogram[i].storeRelease(0);
+    }
+
+    m_elapsed.restart();
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PAINTPROFILER_H
+#define PAINTPROFILER_H
+
+#include "sharedinstance.h"
+
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+// 绘制耗时直方图的区间个数
+#define PAINT_HISTOGRAM_SIZE 10
+
+/**
+ * @brief The PaintProfiler class
+ * 统计任务栏中各个图标的绘制耗时、重绘次数和布局次数。
+ * 每个图标对应一个Stats，图标中保存Stats指针，记录时只有原子操作，不需要加锁；
+ * Stats在所有使用者调用release之前不会被释放，reset只清零计数，保证图标中保存的指针一直有效
+ */
+class PaintProfiler
+{
+public:
+    struct Stats
+    {
+        QAtomicInteger<quint64> paintCount;
+        QAtomicInteger<quint64> timedPaintCount;
+        QAtomicInteger<quint64> totalNs;
+        QAtomicInteger<quint64> maxNs;
+        QAtomicInteger<quint64> layoutCount;
+        QAtomicInteger<quint64> histogram[PAINT_HISTOGRAM_SIZE];
+        int users = 0;
+    };
+
+    static PaintProfiler *instance();
+
+    Stats *stats(const QString &key);
+    void release(Stats *stats);
+
+    void recordPaint(Stats *stats, qint64 durationNs);
+    void recordRepaint(Stats *stats);
+    void recordLayout(Stats *stats);
+
+    QString report() const;
+    void reset();
+
+    static int bucketIndex(qint64 durationNs);
+
+private:
+    PaintProfiler();
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, Stats *> m_stats;
+    QElapsedTimer m_elapsed;
+};
+
+/**
+ * @brief The PaintScope class 在作用域结束时记录一次绘制耗时
+ */
+class PaintScope
+{
+public:
+    explicit PaintScope(PaintProfiler::Stats *stats)
+        : m_stats(stats)
+        , m_beginNs(Utils::monotonicNs())
+    {
+    }
+
+    ~PaintScope()
+    {
+        PaintProfiler::instance()->recordPaint(m_stats, Utils::monotonicNs() - m_beginNs);
+    }
+
+private:
+    Q_DISABLE_COPY(PaintScope)
+
+    PaintProfiler::Stats *m_stats;
+    qint64 m_beginNs;
+};
+
+#endif // PAINTPROFILER_H
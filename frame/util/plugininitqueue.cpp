@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "plugininitqueue.h"
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+// 每批初始化插件的最长耗时，超过后剩余的插件在下一次事件循环中初始化
+#define INIT_BATCH_MSEC 16
+
+PluginInitQueue::PluginInitQueue(std::function<void(PluginsItemInterface *)> initPlugin, QObject *parent)
+    : QObject(parent)
+    , m_initPlugin(std::move(initPlugin))
+{
+}
+
+void PluginInitQueue::enqueue(PluginsItemInterface *interface)
+{
+    m_pendingPlugins << interface;
+    if (m_pendingPlugins.size() == 1)
+        QTimer::singleShot(1, this, &PluginInitQueue::initPendingPlugins);
+}
+
+void PluginInitQueue::initPendingPlugins()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!m_pendingPlugins.isEmpty()) {
+        m_initPlugin(m_pendingPlugins.takeFirst());
+        if (timer.elapsed() >= INIT_BATCH_MSEC)
+            break;
+    }
+
+    if (!m_pendingPlugins.isEmpty())
+        QTimer::singleShot(1, this, &PluginInitQueue::initPendingPlugins);
+}
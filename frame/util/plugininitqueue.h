@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PLUGININITQUEUE_H
+#define PLUGININITQUEUE_H
+
+#include <QObject>
+#include <QList>
+
+#include <functional>
+
+class PluginsItemInterface;
+
+/**
+ * @brief The PluginInitQueue class
+ * 按插件的加载顺序分批初始化插件，每批的耗时不超过INIT_BATCH_MSEC，
+ * 剩余的插件在下一次事件循环中继续初始化，避免长时间阻塞界面
+ */
+class PluginInitQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PluginInitQueue(std::function<void(PluginsItemInterface *)> initPlugin, QObject *parent = nullptr);
+
+    void enqueue(PluginsItemInterface *interface);
+
+private Q_SLOTS:
+    void initPendingPlugins();
+
+private:
+    std::function<void(PluginsItemInterface *)> m_initPlugin;
+    QList<PluginsItemInterface *> m_pendingPlugins;     // 等待初始化的插件，按加载顺序排列
+};
+
+#endif // PLUGININITQUEUE_H
@@ -4,23 +4,248 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "pluginloader.h"
+#include "spantracer.h"
+#include "constants.h"
+#include "sharedinstance.h"
 
 #include <QDir>
+#include <QFile>
 #include <QDebug>
 #include <QLibrary>
+#include <QPluginLoader>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
 #include <QGSettings>
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
 
 #include <DSysInfo>
 
+#include <limits>
+
+#include <elf.h>
+#include <link.h>
+#include <string.h>
+
 DCORE_USE_NAMESPACE
 
+// 并行加载动态库的最大线程数
+#define MAX_LOAD_THREAD 4
+#define PLUGIN_TIMING_STORE_PROPERTY "_dock_plugin_timings"
+
+/**
+ * @brief The PluginTimingStore struct 所有插件的加载和初始化耗时
+ */
+struct PluginTimingStore
+{
+    QMutex mutex;
+    QMap<QString, PluginTiming> timings;
+};
+
+static PluginTimingStore *timingStore()
+{
+    static PluginTimingStore *store = Utils::sharedInstance<PluginTimingStore>(PLUGIN_TIMING_STORE_PROPERTY, [] { return new PluginTimingStore; });
+
+    return store;
+}
+
+/**
+ * @brief The LibraryLoadTask class 在线程池中加载插件依赖的动态库。
+ * 插件本身不在这里加载，否则插件的静态初始化(可能创建QObject)会在线程池的线程中执行，
+ * 插件在界面线程中由QPluginLoader加载时，依赖的动态库已经加载完成，只需要处理插件本身
+ */
+class LibraryLoadTask : public QRunnable
+{
+public:
+    LibraryLoadTask(const QString &pluginFile, QMutex *mutex, QWaitCondition *condition, bool *done)
+        : m_pluginFile(pluginFile)
+        , m_mutex(mutex)
+        , m_condition(condition)
+        , m_done(done)
+    {
+    }
+
+    void run() override
+    {
+        DOCK_TRACE_SCOPE_ARG("PluginLoader::loadLibrary", m_pluginFile);
+        QElapsedTimer timer;
+        timer.start();
+
+        // 这里只加载动态库，不卸载，界面线程中加载插件时直接使用已加载的动态库
+        for (const QString &libraryName : PluginLoader::neededLibraries(m_pluginFile)) {
+            QLibrary library(libraryName);
+            if (!library.load())
+                qDebug() << "preload plugin dependency failed:" << library.errorString();
+        }
+
+        {
+            PluginTimingStore *store = timingStore();
+            QMutexLocker locker(&store->mutex);
+            store->timings[m_pluginFile].loadMSecs = timer.elapsed();
+        }
+
+        QMutexLocker locker(m_mutex);
+        *m_done = true;
+        m_condition->wakeAll();
+    }
+
+private:
+    QString m_pluginFile;
+    QMutex *m_mutex;
+    QWaitCondition *m_condition;
+    bool *m_done;
+};
+
 PluginLoader::PluginLoader(const QString &pluginDirPath, QObject *parent)
     : QThread(parent)
     , m_pluginDirPath(pluginDirPath)
 {
+    // 在界面线程中创建耗时记录，工作线程中不访问qApp的属性
+    timingStore();
 }
 
-void PluginLoader::run()
+/**
+ * @brief PluginLoader::compatibleApiList 任务栏支持的插件api版本
+ */
+const QStringList &PluginLoader::compatibleApiList()
+{
+    static const QStringList apiList {
+        "1.1.1",
+        "1.2",
+        "1.2.1",
+        "1.2.2",
+        DOCK_PLUGIN_API_VERSION
+    };
+
+    return apiList;
+}
+
+bool PluginLoader::isCompatibleApi(const QString &api)
+{
+    return !api.isEmpty() && compatibleApiList().contains(api);
+}
+
+/**
+ * @brief PluginLoader::timings 获取所有插件的加载和初始化耗时
+ * @return 插件文件路径和对应的耗时
+ */
+QMap<QString, PluginTiming> PluginLoader::timings()
+{
+    PluginTimingStore *store = timingStore();
+    QMutexLocker locker(&store->mutex);
+    return store->timings;
+}
+
+/**
+ * @brief PluginLoader::timingReport 导出所有插件的加载和初始化耗时
+ * @return JSON格式的字符串，未完成的耗时为-1
+ */
+QString PluginLoader::timingReport()
+{
+    const QMap<QString, PluginTiming> &allTimings = timings();
+
+    QJsonArray items;
+    for (auto it = allTimings.constBegin(); it != allTimings.constEnd(); ++it) {
+        QJsonObject item;
+        item["plugin"] = it.key();
+        item["loadMs"] = it.value().loadMSecs;
+        item["initMs"] = it.value().initMSecs;
+        items << item;
+    }
+
+    QJsonObject report;
+    report["plugins"] = items;
+
+    return QString::fromUtf8(QJsonDocument(report).toJson(QJsonDocument::Indented));
+}
+
+void PluginLoader::recordInitTime(const QString &pluginFile, qint64 msecs)
+{
+    PluginTimingStore *store = timingStore();
+    QMutexLocker locker(&store->mutex);
+    store->timings[pluginFile].initMSecs = msecs;
+}
+
+/**
+ * @brief PluginLoader::neededLibraries 读取动态库中的DT_NEEDED项，不加载动态库
+ * @param libraryFile 动态库文件路径
+ * @return 依赖的动态库名称(soname)，文件不是当前架构的ELF文件时返回空列表
+ */
+QStringList PluginLoader::neededLibraries(const QString &libraryFile)
+{
+    QFile file(libraryFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return QStringList();
+
+    const qint64 size = file.size();
+    const uchar *data = size >= qint64(sizeof(ElfW(Ehdr))) ? file.map(0, size) : nullptr;
+    if (!data)
+        return QStringList();
+
+    const ElfW(Ehdr) *header = reinterpret_cast<const ElfW(Ehdr) *>(data);
+    const unsigned char elfClass = sizeof(void *) == 8 ? ELFCLASS64 : ELFCLASS32;
+    if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 || header->e_ident[EI_CLASS] != elfClass
+            || header->e_shentsize != sizeof(ElfW(Shdr))
+            || qint64(header->e_shoff) + qint64(header->e_shnum) * qint64(sizeof(ElfW(Shdr))) > size)
+        return QStringList();
+
+    auto inFile = [ size ](quint64 offset, quint64 length) {
+        return offset <= quint64(size) && length <= quint64(size) - offset;
+    };
+
+    QStringList libraries;
+    const ElfW(Shdr) *sections = reinterpret_cast<const ElfW(Shdr) *>(data + header->e_shoff);
+    for (int i = 0; i < header->e_shnum; ++i) {
+        const ElfW(Shdr) &dynamic = sections[i];
+        if (dynamic.sh_type != SHT_DYNAMIC || dynamic.sh_link >= header->e_shnum
+                || !inFile(dynamic.sh_offset, dynamic.sh_size))
+            continue;
+
+        const ElfW(Shdr) &strings = sections[dynamic.sh_link];
+        if (!inFile(strings.sh_offset, strings.sh_size))
+            continue;
+
+        const ElfW(Dyn) *entries = reinterpret_cast<const ElfW(Dyn) *>(data + dynamic.sh_offset);
+        const size_t count = dynamic.sh_size / sizeof(ElfW(Dyn));
+        for (size_t j = 0; j < count && entries[j].d_tag != DT_NULL; ++j) {
+            if (entries[j].d_tag != DT_NEEDED || entries[j].d_un.d_val >= strings.sh_size)
+                continue;
+
+            const char *name = reinterpret_cast<const char *>(data + strings.sh_offset + entries[j].d_un.d_val);
+            libraries << QString::fromLatin1(name, int(qstrnlen(name, uint(strings.sh_size - entries[j].d_un.d_val))));
+        }
+    }
+
+    return libraries;
+}
+
+/**
+ * @brief PluginLoader::sortPlugins 根据插件元数据中的order排序，没有order的插件排在后面，order相同时按文件名排序
+ * @param pluginMetaData 插件文件路径和对应的元数据
+ * @return 排序后的插件文件路径
+ */
+QStringList PluginLoader::sortPlugins(const QMap<QString, QJsonObject> &pluginMetaData)
+{
+    QStringList plugins = pluginMetaData.keys();
+
+    auto order = [ & ](const QString &plugin) {
+        const QJsonObject &meta = pluginMetaData.value(plugin);
+        return meta.contains("order") ? meta.value("order").toInt() : std::numeric_limits<int>::max();
+    };
+
+    // QMap的键已经按文件名排序，稳定排序保证order相同时的顺序
+    std::stable_sort(plugins.begin(), plugins.end(), [ & ](const QString &plugin1, const QString &plugin2) {
+        return order(plugin1) < order(plugin2);
+    });
+
+    return plugins;
+}
+
+QStringList PluginLoader::findPlugins() const
 {
     QDir pluginsDir(m_pluginDirPath);
     const QStringList files = pluginsDir.entryList(QDir::Files);
@@ -55,12 +280,53 @@ void PluginLoader::run()
             continue;
         }
 
-        plugins << file;
+        plugins << pluginsDir.absoluteFilePath(file);
     }
 
-    for (auto plugin : plugins) {
-        emit pluginFounded(pluginsDir.absoluteFilePath(plugin));
+    return plugins;
+}
+
+void PluginLoader::run()
+{
+    // 读取元数据不会加载动态库
+    QMap<QString, QJsonObject> pluginMetaData;
+    {
+        DOCK_TRACE_SCOPE_ARG("PluginLoader::scanMetaData", m_pluginDirPath);
+        for (const QString &plugin : findPlugins())
+            pluginMetaData.insert(plugin, QPluginLoader(plugin).metaData().value("MetaData").toObject());
     }
 
+    const QStringList plugins = sortPlugins(pluginMetaData);
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QVector<bool> done(plugins.size(), false);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), MAX_LOAD_THREAD));
+
+    for (int i = 0; i < plugins.size(); ++i) {
+        // api版本不兼容的插件不能加载动态库，否则会执行其中的静态初始化，交给插件控制器给出提示
+        if (!isCompatibleApi(pluginMetaData.value(plugins[i]).value("api").toString())) {
+            done[i] = true;
+            continue;
+        }
+
+        threadPool.start(new LibraryLoadTask(plugins[i], &mutex, &condition, &done[i]));
+    }
+
+    // 按排序后的顺序通知，排在前面的插件加载完成后即可开始初始化，不必等待所有插件
+    for (int i = 0; i < plugins.size(); ++i) {
+        {
+            QMutexLocker locker(&mutex);
+            while (!done[i])
+                condition.wait(&mutex);
+        }
+
+        emit pluginFounded(plugins[i]);
+    }
+
+    threadPool.waitForDone();
+
     emit finished();
 }
@@ -7,7 +7,24 @@
 #define PLUGINLOADER_H
 
 #include <QThread>
+#include <QJsonObject>
+#include <QMap>
 
+/**
+ * @brief The PluginTiming struct 插件加载(dlopen)和初始化(init)的耗时，未完成时为-1
+ */
+struct PluginTiming
+{
+    qint64 loadMSecs = -1;
+    qint64 initMSecs = -1;
+};
+
+/**
+ * @brief The PluginLoader class
+ * 查找插件目录中可用的插件，先读取插件的元数据(不加载动态库)并按元数据中的order排序，
+ * 然后在线程池中并行加载插件依赖的动态库，按排序后的顺序依次发送pluginFounded信号，
+ * 界面线程中加载插件时只需要处理插件本身，插件的静态初始化仍然在界面线程中执行
+ */
 class PluginLoader : public QThread
 {
     Q_OBJECT
@@ -15,6 +32,14 @@ class PluginLoader : public QThread
 public:
     explicit PluginLoader(const QString &pluginDirPath, QObject *parent);
 
+    static const QStringList &compatibleApiList();
+    static bool isCompatibleApi(const QString &api);
+    static QMap<QString, PluginTiming> timings();
+    static QString timingReport();
+    static void recordInitTime(const QString &pluginFile, qint64 msecs);
+    static QStringList neededLibraries(const QString &libraryFile);
+    static QStringList sortPlugins(const QMap<QString, QJsonObject> &pluginMetaData);
+
 signals:
     void finished() const;
     void pluginFounded(const QString &pluginFile) const;
@@ -22,6 +47,9 @@ signals:
 protected:
     void run();
 
+private:
+    QStringList findPlugins() const;
+
 private:
     QString m_pluginDirPath;
 };
@@ -17,26 +17,43 @@ SettingConfig *SettingConfig::instance()
 
 void SettingConfig::setValue(const QString &key, const QVariant &value)
 {
-    if (m_config->isValid() && m_config->keyList().contains(key))
+    if (m_keys.contains(key)) {
+        m_values.remove(key);
         m_config->setValue(key, value);
+    }
 }
 
 QVariant SettingConfig::value(const QString &key) const
 {
-    if (m_config->isValid() && m_config->keyList().contains(key))
-        return m_config->value(key);
+    if (!m_keys.contains(key))
+        return QVariant();
 
-    return QVariant();
+    auto it = m_values.constFind(key);
+    if (it != m_values.constEnd())
+        return it.value();
+
+    const QVariant &value = m_config->value(key);
+    m_values.insert(key, value);
+    return value;
 }
 
 SettingConfig::SettingConfig(QObject *parent)
     : QObject(parent)
     , m_config(new DConfig(QString("com.deepin.dde.dock.dconfig"), QString()))
 {
+    // 配置项在配置文件中是固定的，只需要获取一次
+    if (m_config->isValid()) {
+        for (const QString &key : m_config->keyList())
+            m_keys.insert(key);
+    }
+
     connect(m_config, &DConfig::valueChanged, this, &SettingConfig::onValueChanged);
 }
 
 void SettingConfig::onValueChanged(const QString &key)
 {
-    Q_EMIT valueChanged(key, m_config->value(key));
+    const QVariant &value = m_config->value(key);
+    m_values.insert(key, value);
+
+    Q_EMIT valueChanged(key, value);
 }
@@ -10,6 +10,8 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QHash>
+#include <QSet>
 
 DCORE_BEGIN_NAMESPACE
 class DConfig;
@@ -40,6 +42,8 @@ private Q_SLOTS:
 
 private:
     DConfig *m_config;
+    QSet<QString> m_keys;                       // 配置文件中的所有配置项
+    mutable QHash<QString, QVariant> m_values;  // 已读取的配置值，配置变化时更新
 };
 
 #endif // SETTINGCONFIG_H
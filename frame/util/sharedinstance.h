@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef SHAREDINSTANCE_H
+#define SHAREDINSTANCE_H
+
+#include <QCoreApplication>
+#include <QVariant>
+
+#include <time.h>
+
+namespace Utils {
+
+/**
+ * @brief monotonicNs 单调时钟的当前时间，不受系统时间调整的影响
+ * @return 纳秒
+ */
+inline qint64 monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * @brief sharedInstance 获取进程内唯一的实例
+ * 插件中也会编译同一份源码，每个动态库都有自己的静态变量，这里通过qApp的属性找到先创建的实例，
+ * 保证任务栏和所有插件使用同一个实例。没有qApp时(例如单元测试中)只在当前模块内唯一
+ * @param property 保存实例地址的qApp属性名
+ * @param create 第一次使用时创建实例
+ */
+template <class T, class Factory>
+T *sharedInstance(const char *property, Factory create)
+{
+    if (qApp) {
+        const QVariant &value = qApp->property(property);
+        if (value.isValid())
+            return reinterpret_cast<T *>(value.value<quintptr>());
+    }
+
+    T *instance = create();
+    if (qApp)
+        qApp->setProperty(property, QVariant::fromValue(reinterpret_cast<quintptr>(instance)));
+
+    return instance;
+}
+
+}
+
+#endif // SHAREDINSTANCE_H
@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "spantracer.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QVariant>
+#include <QDebug>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// 每个线程最多保留的记录数
+#define THREAD_BUFFER_SIZE 4096
+// 最多保留的已退出线程的缓冲区个数，线程池中的线程空闲后会退出，不限制的话会一直增长
+#define MAX_FINISHED_THREAD_BUFFERS 8
+#define SPAN_TRACER_PROPERTY "_dock_span_tracer"
+
+/**
+ * @brief The SpanTracer::ThreadBufferRef struct 当前线程在本模块中引用的缓冲区
+ * 任务栏和插件中各有一份线程局部变量，缓冲区本身保存在共用的实例中，线程退出时释放引用
+ */
+struct SpanTracer::ThreadBufferRef
+{
+    ~ThreadBufferRef()
+    {
+        if (buffer)
+            tracer->releaseThreadBuffer(buffer);
+    }
+
+    SpanTracer *tracer = nullptr;
+    ThreadBuffer *buffer = nullptr;
+};
+
+SpanTracer::SpanTracer()
+    : m_enabled(0)
+{
+    const QByteArray &env = qgetenv("DDE_DOCK_TRACE");
+    if (!env.isEmpty() && env != "0")
+        m_enabled.store(1);
+}
+
+SpanTracer *SpanTracer::instance()
+{
+    static SpanTracer *tracer = Utils::sharedInstance<SpanTracer>(SPAN_TRACER_PROPERTY, [] { return new SpanTracer; });
+
+    return tracer;
+}
+
+void SpanTracer::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled ? 1 : 0);
+}
+
+void SpanTracer::addSpan(const char *name, const QByteArray &arg, qint64 beginNs, qint64 endNs)
+{
+    if (!isEnabled())
+        return;
+
+    ThreadBuffer *buffer = threadBuffer();
+
+    QMutexLocker locker(&buffer->mutex);
+    Event &event = buffer->events[buffer->next];
+    // 拷贝名称，环形缓冲区写满后复用原来的空间，不会再分配内存
+    event.name = name;
+    event.arg = arg;
+    event.beginNs = beginNs;
+    event.endNs = endNs;
+
+    if (++buffer->next == buffer->events.size()) {
+        buffer->next = 0;
+        buffer->wrapped = true;
+    }
+}
+
+void SpanTracer::addInstant(const char *name, const QByteArray &arg)
+{
+    if (isEnabled())
+        addSpan(name, arg, Utils::monotonicNs(), -1);
+}
+
+/**
+ * @brief SpanTracer::toChromeTrace 导出为Chrome trace_event格式的JSON
+ */
+QByteArray SpanTracer::toChromeTrace() const
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    QMutexLocker locker(&m_mutex);
+    for (ThreadBuffer *buffer : m_buffers) {
+        QMutexLocker bufferLocker(&buffer->mutex);
+
+        QJsonObject threadName;
+        threadName["name"] = "thread_name";
+        threadName["ph"] = "M";
+        threadName["pid"] = pid;
+        threadName["tid"] = buffer->tid;
+        threadName["args"] = QJsonObject {{ "name", buffer->threadName }};
+        traceEvents << threadName;
+
+        // 环形缓冲区写满后，最早的记录从next开始
+        const int count = buffer->wrapped ? buffer->events.size() : buffer->next;
+        const int start = buffer->wrapped ? buffer->next : 0;
+        for (int i = 0; i < count; ++i) {
+            const Event &event = buffer->events[(start + i) % buffer->events.size()];
+
+            QJsonObject object;
+            object["name"] = QString::fromUtf8(event.name);
+            object["cat"] = "dde-dock";
+            object["pid"] = pid;
+            object["tid"] = buffer->tid;
+            object["ts"] = event.beginNs / 1000.0;
+            if (event.endNs >= 0) {
+                object["ph"] = "X";
+                object["dur"] = (event.endNs - event.beginNs) / 1000.0;
+            } else {
+                object["ph"] = "i";
+                object["s"] = "t";
+            }
+            if (!event.arg.isEmpty())
+                object["args"] = QJsonObject {{ "arg", QString::fromUtf8(event.arg) }};
+
+            traceEvents << object;
+        }
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = traceEvents;
+    trace["displayTimeUnit"] = "ms";
+
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+bool SpanTracer::dump(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "open trace file failed:" << fileName << file.errorString();
+        return false;
+    }
+
+    file.write(toChromeTrace());
+    return file.commit();
+}
+
+void SpanTracer::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    for (ThreadBuffer *buffer : m_buffers) {
+        QMutexLocker bufferLocker(&buffer->mutex);
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
+
+SpanTracer::ThreadBuffer *SpanTracer::threadBuffer()
+{
+    static thread_local ThreadBufferRef ref;
+    if (ref.buffer)
+        return ref.buffer;
+
+    ref.tracer = this;
+    ref.buffer = acquireThreadBuffer(static_cast<qint64>(syscall(SYS_gettid)));
+    return ref.buffer;
+}
+
+/**
+ * @brief SpanTracer::acquireThreadBuffer 获取线程对应的缓冲区，同一个线程中的多份代码使用同一个缓冲区
+ */
+SpanTracer::ThreadBuffer *SpanTracer::acquireThreadBuffer(qint64 tid)
+{
+    QMutexLocker locker(&m_mutex);
+    ThreadBuffer *buffer = m_threadBuffers.value(tid);
+    if (!buffer) {
+        buffer = new ThreadBuffer;
+        buffer->tid = tid;
+        buffer->events.resize(THREAD_BUFFER_SIZE);
+
+        QThread *thread = QThread::currentThread();
+        if (qApp && thread == qApp->thread())
+            buffer->threadName = "main";
+        else if (thread && !thread->objectName().isEmpty())
+            buffer->threadName = thread->objectName();
+        else
+            buffer->threadName = QString("thread-%1").arg(tid);
+
+        m_buffers << buffer;
+        m_threadBuffers.insert(tid, buffer);
+    }
+
+    ++buffer->users;
+    return buffer;
+}
+
+/**
+ * @brief SpanTracer::releaseThreadBuffer 线程退出时调用，保留最近退出的几个线程的记录，更早的释放掉
+ */
+void SpanTracer::releaseThreadBuffer(ThreadBuffer *buffer)
+{
+    QMutexLocker locker(&m_mutex);
+    if (--buffer->users > 0)
+        return;
+
+    // 线程id可能被新线程复用，退出后不再按线程id查找
+    m_threadBuffers.remove(buffer->tid);
+    buffer->finished = true;
+
+    int finishedCount = 0;
+    for (ThreadBuffer *item : m_buffers) {
+        if (item->finished)
+            ++finishedCount;
+    }
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end() && finishedCount > MAX_FINISHED_THREAD_BUFFERS;) {
+        if ((*it)->finished) {
+            delete *it;
+            it = m_buffers.erase(it);
+            --finishedCount;
+        } else {
+            ++it;
+        }
+    }
+}
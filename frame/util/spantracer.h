@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef SPANTRACER_H
+#define SPANTRACER_H
+
+#include "sharedinstance.h"
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#define DOCK_TRACE_CONCAT_IMPL(a, b) a##b
+#define DOCK_TRACE_CONCAT(a, b) DOCK_TRACE_CONCAT_IMPL(a, b)
+// 记录当前作用域的耗时，name必须为字符串常量
+#define DOCK_TRACE_SCOPE(name) TraceScope DOCK_TRACE_CONCAT(traceScope, __LINE__)(name)
+// 记录当前作用域的耗时，并附带参数(如插件名)，参数只在开启跟踪时才会拷贝
+#define DOCK_TRACE_SCOPE_ARG(name, arg) TraceScope DOCK_TRACE_CONCAT(traceScope, __LINE__)(name, arg)
+
+/**
+ * @brief The SpanTracer class
+ * 任务栏启动过程的耗时跟踪，每个线程记录到自己的环形缓冲区中，使用单调时钟计时，
+ * 可以导出为Chrome trace_event格式(chrome://tracing 或 Perfetto 打开)。
+ * 设置环境变量DDE_DOCK_TRACE=1或者通过DBus接口开启，未开启时每个跟踪点只有一次原子读取的开销
+ * 任务栏和插件中编译的多份代码通过qApp的属性共用同一个实例
+ */
+class SpanTracer
+{
+public:
+    struct Event
+    {
+        QByteArray name;        // 拷贝一份，插件卸载后其中的字符串常量就失效了
+        QByteArray arg;
+        qint64 beginNs;
+        qint64 endNs;           // 小于0表示瞬时事件
+    };
+
+    static SpanTracer *instance();
+
+    inline bool isEnabled() const { return m_enabled.load(); }
+    void setEnabled(bool enabled);
+
+    void addSpan(const char *name, const QByteArray &arg, qint64 beginNs, qint64 endNs);
+    void addInstant(const char *name, const QByteArray &arg = QByteArray());
+
+    QByteArray toChromeTrace() const;
+    bool dump(const QString &fileName) const;
+    void clear();
+
+private:
+    struct ThreadBuffer
+    {
+        QMutex mutex;
+        qint64 tid;
+        QString threadName;
+        QVector<Event> events;
+        int next = 0;           // 下一个写入的位置
+        bool wrapped = false;   // 缓冲区已写满，开始覆盖最早的记录
+        int users = 0;          // 当前线程中使用这个缓冲区的模块(任务栏和插件)个数
+        bool finished = false;  // 线程已经退出
+    };
+    struct ThreadBufferRef;
+
+    SpanTracer();
+    ThreadBuffer *threadBuffer();
+    ThreadBuffer *acquireThreadBuffer(qint64 tid);
+    void releaseThreadBuffer(ThreadBuffer *buffer);
+
+private:
+    QAtomicInt m_enabled;
+    mutable QMutex m_mutex;
+    QList<ThreadBuffer *> m_buffers;                // 按创建顺序保存，包括已退出线程的缓冲区
+    QHash<qint64, ThreadBuffer *> m_threadBuffers;  // 仍在运行的线程，按线程id索引
+};
+
+/**
+ * @brief The TraceScope class 在构造和析构时记录作用域的开始和结束时间
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name)
+        : m_name(name)
+        , m_beginNs(SpanTracer::instance()->isEnabled() ? Utils::monotonicNs() : -1)
+    {
+    }
+
+    TraceScope(const char *name, const QString &arg)
+        : m_name(name)
+        , m_beginNs(SpanTracer::instance()->isEnabled() ? Utils::monotonicNs() : -1)
+    {
+        if (m_beginNs >= 0)
+            m_arg = arg.toUtf8();
+    }
+
+    ~TraceScope()
+    {
+        if (m_beginNs >= 0)
+            SpanTracer::instance()->addSpan(m_name, m_arg, m_beginNs, Utils::monotonicNs());
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+
+    const char *m_name;
+    QByteArray m_arg;
+    qint64 m_beginNs;
+};
+
+#endif // SPANTRACER_H
@@ -5,6 +5,8 @@
 
 #include "themeappicon.h"
 #include "imageutil.h"
+#include "appiconresolver.h"
+#include "icondiskcache.h"
 
 #include <QIcon>
 #include <QFile>
@@ -16,7 +18,6 @@
 #include <QDate>
 #include <QPainter>
 #include <QStandardPaths>
-#include <QProcess>
 
 #include <private/qguiapplication_p.h>
 #include <private/qiconloader_p.h>
@@ -37,33 +38,11 @@ ThemeAppIcon::~ThemeAppIcon()
  * @param name 图标名
  * @return 获取到的图标
  * @note 只有在正常查找图标失败时，才走这个逻辑，如果直接使用QIcon::fromTheme可以获取到图标，是没必要的
+ * 此函数会阻塞等待查找结果，界面中请使用getIcon(pix, iconName, size, true)，由AppIconResolver在工作线程中查找
  */
 QIcon ThemeAppIcon::getIcon(const QString &name)
 {
-    //TODO 这里找图标会耗时，界面轻微卡顿，后面有时间可以放到AppItem里面，单独开启线程去查找
-    QProcess process;
-    process.start("qtxdg-iconfinder", QStringList() << name);
-    process.closeWriteChannel();
-    process.waitForFinished();
-
-    int exitCode = process.exitCode();
-    QString outputTxt = process.readAllStandardOutput();
-
-    auto list = outputTxt.split("\n");
-
-    if (exitCode != 0 || list.size() <= 3)
-        return QIcon::fromTheme(name);
-
-    // 去掉无用数据
-    list.removeFirst();
-    list.removeLast();
-    list.removeLast();
-
-    for (auto &s : list) {
-        s = s.simplified();
-    }
-
-    return QIcon::fromTheme(list.first());
+    return QIcon::fromTheme(AppIconResolver::findThemeIconName(name));
 }
 
 bool ThemeAppIcon::getIcon(QPixmap &pix, const QString iconName, const int size, bool reObtain)
@@ -86,6 +65,12 @@ bool ThemeAppIcon::getIcon(QPixmap &pix, const QString iconName, const int size,
         tmpName = name;
     }
 
+    // 主题图标和本地图标文件优先从磁盘缓存中读取，避免再次查找主题和解析SVG
+    const bool diskCacheable = !tmpName.startsWith("data:image/");
+    const QString sourceFile = (diskCacheable && QFile::exists(tmpName)) ? tmpName : QString();
+    if (diskCacheable && IconDiskCache::instance()->find(tmpName, QSize(s, s), qApp->devicePixelRatio(), pix, sourceFile))
+        return true;
+
     do {
         // load pixmap from our Cache
         if (tmpName.startsWith("data:image/")) {
@@ -116,14 +101,20 @@ bool ThemeAppIcon::getIcon(QPixmap &pix, const QString iconName, const int size,
                 break;
         }
 
+        const int fakeSize = std::max(48, s); // cannot use 16x16, cause 16x16 is label icon
+
         // 重新从主题中获取一次
 
         // 如果此提交我们使用的qt版本已经包含，那就可以不需要reObtain的逻辑了
         // https://codereview.qt-project.org/c/qt/qtbase/+/343396
-        if (reObtain)
-            icon = getIcon(tmpName);
-        else
+        if (reObtain) {
+            // 查找在工作线程中进行，未完成前先使用默认图标占位，完成后AppIconResolver::iconResolved通知刷新
+            const AppIconKey iconKey { tmpName, fakeSize, qApp->devicePixelRatio(), QIcon::themeName() };
+            if (AppIconResolver::instance()->pixmap(pix, iconKey))
+                break;
+        } else {
             icon = QIcon::fromTheme(tmpName);
+        }
 
         if(icon.isNull()) {
             icon = QIcon::fromTheme("application-x-desktop");
@@ -131,7 +122,6 @@ bool ThemeAppIcon::getIcon(QPixmap &pix, const QString iconName, const int size,
         }
 
         // load pixmap from Icon-Theme
-        const int fakeSize = std::max(48, s); // cannot use 16x16, cause 16x16 is label icon
         pix = icon.pixmap(QSize(fakeSize, fakeSize));
         if (!pix.isNull())
             break;
@@ -150,6 +140,9 @@ bool ThemeAppIcon::getIcon(QPixmap &pix, const QString iconName, const int size,
     }
     pix.setDevicePixelRatio(qApp->devicePixelRatio());
 
+    if (ret && diskCacheable)
+        IconDiskCache::instance()->insert(tmpName, QSize(s, s), qApp->devicePixelRatio(), pix, sourceFile);
+
     return ret;
 }
 
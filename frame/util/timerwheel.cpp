@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "timerwheel.h"
+
+#include <QApplication>
+#include <QTimer>
+
+#include <limits>
+
+// 时间轮每一格的时长(毫秒)
+#define TICK_INTERVAL 10
+
+TimerWheel::TimerWheel(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_tick(0)
+    , m_nextId(0)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_clock.start();
+
+    connect(m_timer, &QTimer::timeout, this, &TimerWheel::onTimeout);
+}
+
+TimerWheel *TimerWheel::instance()
+{
+    static TimerWheel *wheel = new TimerWheel(qApp);
+    return wheel;
+}
+
+/**
+ * @brief TimerWheel::schedule 添加延时任务
+ * @param msec 延时(毫秒)，按格向上取整
+ * @param context 任务所属的对象，到期时对象已经销毁则不执行
+ * @param callback 到期后通过事件循环在context所在的线程中执行
+ * @return 任务的id，用于取消任务
+ */
+int TimerWheel::schedule(int msec, QObject *context, std::function<void()> callback)
+{
+    // 没有任务时时间轮是静止的，直接对齐到当前时间
+    if (m_entries.isEmpty())
+        m_tick = currentTick();
+
+    const qint64 expireMsec = m_clock.elapsed() + qMax(0, msec);
+    const qint64 expireTick = (expireMsec + TICK_INTERVAL - 1) / TICK_INTERVAL;
+
+    // id为0表示无效的任务，先回绕再自增，避免有符号整数溢出
+    m_nextId = m_nextId < std::numeric_limits<int>::max() ? m_nextId + 1 : 1;
+
+    m_entries.insert(m_nextId, Entry { expireTick, 0, 0, context, callback });
+    insert(m_nextId, m_tick + 1);
+    restartTimer();
+
+    return m_nextId;
+}
+
+void TimerWheel::cancel(int id)
+{
+    m_firing.remove(id);
+
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+
+    m_slots[it->level][it->slot].remove(id);
+    m_entries.erase(it);
+
+    if (m_entries.isEmpty())
+        m_timer->stop();
+}
+
+bool TimerWheel::isPending(int id) const
+{
+    return m_entries.contains(id) || m_firing.contains(id);
+}
+
+qint64 TimerWheel::currentTick() const
+{
+    return m_clock.elapsed() / TICK_INTERVAL;
+}
+
+/**
+ * @brief TimerWheel::insert 根据到期时间距离当前格的远近放入对应的层，越远的层每一格越长
+ * @param earliestTick 最早可以放入的格，新任务不能放入当前已经处理过的格
+ */
+void TimerWheel::insert(int id, qint64 earliestTick)
+{
+    Entry &entry = m_entries[id];
+    entry.expireTick = qMax(entry.expireTick, earliestTick);
+
+    // 超出最高层范围的任务放在最高层的最后一格，降级时重新计算
+    const qint64 maxDelta = (qint64(1) << (SlotBits * Levels)) - 1;
+    const qint64 delta = qMin(entry.expireTick - m_tick, maxDelta);
+    const qint64 tick = m_tick + delta;
+
+    int level = 0;
+    while (level < Levels - 1 && delta >= (qint64(1) << (SlotBits * (level + 1))))
+        ++level;
+
+    entry.level = level;
+    entry.slot = int((tick >> (SlotBits * level)) & SlotMask);
+    m_slots[entry.level][entry.slot].insert(id);
+}
+
+/**
+ * @brief TimerWheel::advance 时间轮前进一格，低层转完一圈时先将高层对应格中的任务降级，再执行到期的任务
+ */
+void TimerWheel::advance()
+{
+    ++m_tick;
+
+    for (int level = 1; level < Levels; ++level) {
+        if ((m_tick & ((qint64(1) << (SlotBits * level)) - 1)) != 0)
+            break;
+
+        // 从最高的需要降级的层开始，保证降级的任务能落到低层对应的格中
+        int top = level;
+        while (top + 1 < Levels && (m_tick & ((qint64(1) << (SlotBits * (top + 1))) - 1)) == 0)
+            ++top;
+
+        for (int i = top; i >= 1; --i)
+            cascade(i);
+        break;
+    }
+
+    QSet<int> ids;
+    ids.swap(m_slots[0][m_tick & SlotMask]);
+    expire(ids);
+}
+
+void TimerWheel::cascade(int level)
+{
+    QSet<int> ids;
+    ids.swap(m_slots[level][(m_tick >> (SlotBits * level)) & SlotMask]);
+    // 降级发生在处理当前格之前，当前格到期的任务仍然可以放入当前格
+    for (int id : ids)
+        insert(id, m_tick);
+}
+
+/**
+ * @brief TimerWheel::expire 到期的任务不在这里直接执行，投递到所属对象的事件队列中，
+ * 避免一格中的任务耗时过长阻塞时间轮，也保证任务在所属对象的线程中执行
+ */
+void TimerWheel::expire(const QSet<int> &ids)
+{
+    // 所属对象销毁后投递的任务不会再执行，这里清理掉
+    for (auto it = m_firing.begin(); it != m_firing.end();) {
+        if (it.value().isNull())
+            it = m_firing.erase(it);
+        else
+            ++it;
+    }
+
+    for (int id : ids) {
+        auto it = m_entries.find(id);
+        if (it == m_entries.end())
+            continue;
+
+        QObject *context = it->context.data();
+        const std::function<void()> callback = it->callback;
+        m_entries.erase(it);
+
+        if (!context || !callback)
+            continue;
+
+        m_firing.insert(id, context);
+        QMetaObject::invokeMethod(context, [ this, id, callback ] { fire(id, callback); }, Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief TimerWheel::fire 执行到期的任务，到期后被取消的任务不再执行
+ */
+void TimerWheel::fire(int id, const std::function<void()> &callback)
+{
+    if (!m_firing.remove(id))
+        return;
+
+    // 任务中可以添加或取消其他任务
+    callback();
+}
+
+/**
+ * @brief TimerWheel::restartTimer 计算下一次需要处理的格：第0层中最近的任务，或者高层中最近的需要降级的格
+ */
+void TimerWheel::restartTimer()
+{
+    if (m_entries.isEmpty()) {
+        m_timer->stop();
+        return;
+    }
+
+    // 高层中的任务会在降级后重新计算，这里只需要保证不会错过降级的时机
+    qint64 nextTick = -1;
+    for (int level = 0; level < Levels; ++level) {
+        const int shift = SlotBits * level;
+        for (int i = 1; i <= Slots; ++i) {
+            const qint64 tick = ((m_tick >> shift) + i) << shift;
+            if (nextTick >= 0 && tick >= nextTick)
+                break;
+
+            if (!m_slots[level][(tick >> shift) & SlotMask].isEmpty()) {
+                nextTick = tick;
+                break;
+            }
+        }
+    }
+
+    if (nextTick < 0)
+        nextTick = m_tick + 1;
+
+    m_timer->start(int(qMax(qint64(0), nextTick * TICK_INTERVAL - m_clock.elapsed())));
+}
+
+void TimerWheel::onTimeout()
+{
+    const qint64 tick = currentTick();
+    while (m_tick < tick && !m_entries.isEmpty())
+        advance();
+
+    restartTimer();
+}
+
+WheelTimer::WheelTimer(QObject *context, int interval, std::function<void()> callback)
+    : m_context(context)
+    , m_interval(interval)
+    , m_callback(callback)
+    , m_id(0)
+{
+}
+
+WheelTimer::~WheelTimer()
+{
+    stop();
+}
+
+/**
+ * @brief WheelTimer::start 开始计时，正在计时的时候重新开始
+ */
+void WheelTimer::start()
+{
+    stop();
+    m_id = TimerWheel::instance()->schedule(m_interval, m_context, m_callback);
+}
+
+void WheelTimer::stop()
+{
+    if (m_id > 0)
+        TimerWheel::instance()->cancel(m_id);
+
+    m_id = 0;
+}
+
+bool WheelTimer::isActive() const
+{
+    return m_id > 0 && TimerWheel::instance()->isPending(m_id);
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QPointer>
+#include <QElapsedTimer>
+
+#include <functional>
+
+class QTimer;
+
+/**
+ * @brief The TimerWheel class
+ * 任务栏共用的分层时间轮，所有控件的延时任务由同一个定时器驱动。
+ * 每一格为TICK_INTERVAL毫秒，落在同一格中的任务一起触发，取消任务的复杂度为O(1)，
+ * 定时器只在有任务到期或者需要降级时唤醒，没有任务时停止。
+ * 到期的任务通过事件循环在所属对象的线程中执行，执行之前仍然可以取消
+ */
+class TimerWheel : public QObject
+{
+    Q_OBJECT
+
+public:
+    static TimerWheel *instance();
+
+    int schedule(int msec, QObject *context, std::function<void()> callback);
+    void cancel(int id);
+    bool isPending(int id) const;
+    int pendingCount() const { return m_entries.size(); }
+
+private:
+    explicit TimerWheel(QObject *parent = nullptr);
+
+    qint64 currentTick() const;
+    void insert(int id, qint64 earliestTick);
+    void advance();
+    void cascade(int level);
+    void expire(const QSet<int> &ids);
+    void fire(int id, const std::function<void()> &callback);
+    void restartTimer();
+    void onTimeout();
+
+private:
+    struct Entry
+    {
+        qint64 expireTick;
+        int level;
+        int slot;
+        QPointer<QObject> context;
+        std::function<void()> callback;
+    };
+
+    enum {
+        Levels = 3,
+        SlotBits = 6,
+        Slots = 1 << SlotBits,
+        SlotMask = Slots - 1
+    };
+
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_tick;                      // 时间轮已经处理到的格
+    int m_nextId;
+    QHash<int, Entry> m_entries;
+    QHash<int, QPointer<QObject>> m_firing;  // 已经到期，等待事件循环执行的任务
+    QSet<int> m_slots[Levels][Slots];
+};
+
+/**
+ * @brief The WheelTimer class
+ * 由TimerWheel驱动的单次定时器，用法和设置了singleShot的QTimer相同，析构时自动取消
+ */
+class WheelTimer
+{
+public:
+    WheelTimer(QObject *context, int interval, std::function<void()> callback);
+    ~WheelTimer();
+
+    void start();
+    void stop();
+    bool isActive() const;
+    int interval() const { return m_interval; }
+
+private:
+    Q_DISABLE_COPY(WheelTimer)
+
+    QObject *m_context;
+    int m_interval;
+    std::function<void()> m_callback;
+    int m_id;
+};
+
+#endif // TIMERWHEEL_H
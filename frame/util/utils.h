@@ -10,6 +10,9 @@
 #include <QApplication>
 #include <QScreen>
 #include <QGSettings>
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
 #include <QDebug>
 
 #include "imageutil.h"
@@ -86,6 +89,119 @@ inline QString qtify_name(const char *name)
     return result;
 }
 
+/**
+ * @brief The SettingsRegistry class 进程内共享的GSettings注册表
+ * 每个schema和path只创建一次QGSettings，读取过的值缓存起来，配置变化时清除对应的缓存，
+ * 避免每次读取都重新解析schema和打开dconf。只能在GUI线程中使用
+ */
+class SettingsRegistry
+{
+public:
+    static SettingsRegistry *instance()
+    {
+        static SettingsRegistry registry;
+        return &registry;
+    }
+
+    /**
+     * @brief settings 获取共享的QGSettings，schema未安装时返回nullptr
+     */
+    QGSettings *settings(const QString &schema_id, const QByteArray &path = QByteArray())
+    {
+        Backend *backend = this->backend(schema_id, path);
+        return backend ? backend->settings : nullptr;
+    }
+
+    bool contains(const QString &schema_id, const QByteArray &path, const QString &key)
+    {
+        Backend *backend = this->backend(schema_id, path);
+        return backend && backend->keys.contains(qtify_name(key.toUtf8().data()));
+    }
+
+    const QVariant value(const QString &schema_id, const QByteArray &path, const QString &key, const QVariant &fallback = QVariant())
+    {
+        Backend *backend = this->backend(schema_id, path);
+        const QString name = qtify_name(key.toUtf8().data());
+        if (!backend || !backend->keys.contains(name)) {
+            qDebug() << "Cannot find gsettings, schema_id:" << schema_id
+                     << " path:" << path << " key:" << key
+                     << "Use fallback value:" << fallback;
+            return fallback;
+        }
+
+        auto it = backend->values.constFind(name);
+        if (it != backend->values.constEnd())
+            return it.value();
+
+        const QVariant &v = backend->settings->get(name);
+        backend->values.insert(name, v);
+        return v;
+    }
+
+    template<typename T>
+    T value(const QString &schema_id, const QByteArray &path, const QString &key, const T &fallback)
+    {
+        return value(schema_id, path, key, QVariant::fromValue(fallback)).template value<T>();
+    }
+
+    bool setValue(const QString &schema_id, const QByteArray &path, const QString &key, const QVariant &value)
+    {
+        Backend *backend = this->backend(schema_id, path);
+        const QString name = qtify_name(key.toUtf8().data());
+        if (!backend || !backend->keys.contains(name)) {
+            qDebug() << "Cannot find gsettings, schema_id:" << schema_id
+                     << " path:" << path << " key:" << key;
+            return false;
+        }
+
+        // 写入后由changed信号清除缓存，这里提前清除，保证随后的读取拿到最新的值
+        backend->values.remove(name);
+        backend->settings->set(name, value);
+        return true;
+    }
+
+private:
+    struct Backend
+    {
+        QGSettings *settings;
+        QSet<QString> keys;                 // 使用qtify_name转换后的键名
+        QHash<QString, QVariant> values;
+    };
+
+    SettingsRegistry() = default;
+    Q_DISABLE_COPY(SettingsRegistry)
+
+    Backend *backend(const QString &schema_id, const QByteArray &path)
+    {
+        const QString id = schema_id + QLatin1Char('@') + QString::fromUtf8(path);
+        auto it = m_backends.find(id);
+        if (it != m_backends.end())
+            return it.value().data();
+
+        // schema未安装时同样记录下来，避免重复查询
+        QSharedPointer<Backend> backend;
+        if (QGSettings::isSchemaInstalled(schema_id.toUtf8())) {
+            backend.reset(new Backend);
+            backend->settings = new QGSettings(schema_id.toUtf8(), path, qApp);
+            for (const QString &key : backend->settings->keys())
+                backend->keys.insert(qtify_name(key.toUtf8().data()));
+
+            Backend *b = backend.data();
+            QObject::connect(b->settings, &QGSettings::changed, b->settings, [ b ](const QString &key) {
+                b->values.remove(qtify_name(key.toUtf8().data()));
+            });
+        } else {
+            qDebug() << "Cannot find gsettings, schema_id:" << schema_id;
+        }
+
+        m_backends.insert(id, backend);
+        return backend.data();
+    }
+
+private:
+    QHash<QString, QSharedPointer<Backend>> m_backends;
+};
+
 /**
  * @brief SettingValue 根据给定信息返回获取的值
  * @param schema_id The id of the schema
@@ -96,40 +212,12 @@ inline QString qtify_name(const char *name)
  */
 inline const QVariant SettingValue(const QString &schema_id, const QByteArray &path = QByteArray(), const QString &key = QString(), const QVariant &fallback = QVariant())
 {
-    const QGSettings *settings = SettingsPtr(schema_id, path);
-
-    if (settings && ((settings->keys().contains(key)) || settings->keys().contains(qtify_name(key.toUtf8().data())))) {
-        QVariant v = settings->get(key);
-        delete settings;
-        return v;
-    } else{
-        qDebug() << "Cannot find gsettings, schema_id:" << schema_id
-                 << " path:" << path << " key:" << key
-                 << "Use fallback value:" << fallback;
-        // 如果settings->keys()不包含key则会存在内存泄露，所以需要释放
-        if (settings)
-            delete settings;
-
-        return fallback;
-    }
+    return SettingsRegistry::instance()->value(schema_id, path, key, fallback);
 }
 
 inline bool SettingSaveValue(const QString &schema_id, const QByteArray &path, const QString &key, const QVariant &value)
 {
-    QGSettings *settings = SettingsPtr(schema_id, path);
-
-    if (settings && ((settings->keys().contains(key)) || settings->keys().contains(qtify_name(key.toUtf8().data())))) {
-        settings->set(key, value);
-        delete settings;
-        return true;
-    } else{
-        qDebug() << "Cannot find gsettings, schema_id:" << schema_id
-                 << " path:" << path << " key:" << key;
-        if (settings)
-            delete settings;
-
-        return false;
-    }
+    return SettingsRegistry::instance()->setValue(schema_id, path, key, value);
 }
 
 inline QPixmap renderSVG(const QString &path, const QSize &size, const qreal devicePixelRatio)
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "windowthumbnailmanager.h"
+#include "dbusstatistics.h"
+
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusInterface>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusReply>
+#include <QDBusServiceWatcher>
+#include <QDBusUnixFileDescriptor>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QDebug>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// 预览图缓存的最大字节数
+#define MAX_THUMBNAIL_CACHE (32 * 1024 * 1024)
+// 预览图缓存超过此时间后，下次请求时在后台重新截图，期间继续使用旧的预览图
+#define THUMBNAIL_EXPIRED_MSEC 1000
+
+const QString kwinService = QStringLiteral("org.kde.KWin");
+
+WindowThumbnailManager::WindowThumbnailManager(QObject *parent)
+    : QObject(parent)
+    , m_thumbnails(MAX_THUMBNAIL_CACHE)
+    , m_kwinAvailable(-1)
+{
+    // 窗管重启后截图特效的状态可能变化，需要重新查询
+    QDBusServiceWatcher *kwinWatcher = new QDBusServiceWatcher(kwinService, QDBusConnection::sessionBus(),
+                                                               QDBusServiceWatcher::WatchForOwnerChange, this);
+    connect(kwinWatcher, &QDBusServiceWatcher::serviceOwnerChanged, this, [ this ] {
+        m_kwinAvailable = -1;
+    });
+}
+
+WindowThumbnailManager *WindowThumbnailManager::instance()
+{
+    static WindowThumbnailManager *manager = new WindowThumbnailManager(qApp);
+    return manager;
+}
+
+bool WindowThumbnailManager::isKWinAvailable()
+{
+    if (m_kwinAvailable >= 0)
+        return m_kwinAvailable;
+
+    m_kwinAvailable = 0;
+    if (QDBusConnection::sessionBus().interface()->isServiceRegistered(kwinService)) {
+        DBusCallScope scope(kwinService, "isEffectLoaded");
+        QDBusInterface interface(kwinService, QStringLiteral("/Effects"), QStringLiteral("org.kde.kwin.Effects"));
+        QDBusReply<bool> reply = interface.call(QStringLiteral("isEffectLoaded"), "screenshot");
+        scope.setError(!reply.isValid());
+
+        m_kwinAvailable = reply.value() ? 1 : 0;
+    }
+
+    return m_kwinAvailable;
+}
+
+QPixmap WindowThumbnailManager::thumbnail(WId wid) const
+{
+    Thumbnail *thumbnail = m_thumbnails.object(wid);
+    return thumbnail ? thumbnail->pixmap : QPixmap();
+}
+
+/**
+ * @brief WindowThumbnailManager::requestThumbnail 请求更新窗口的预览图
+ * @param wid 窗口id
+ * @param windowInfoId 截图时使用的窗口标识，X11下为窗口id，wayland下为窗口的UUID
+ * @param size 预览图的大小（已计算缩放）
+ * @note 缓存仍然有效或者该窗口正在截图时不会重复截图，截图完成后发送thumbnailUpdated信号
+ */
+void WindowThumbnailManager::requestThumbnail(WId wid, const QString &windowInfoId, const QSize &size)
+{
+    if (m_pendingCaptures.contains(wid))
+        return;
+
+    Thumbnail *thumbnail = m_thumbnails.object(wid);
+    if (thumbnail && thumbnail->valid && !thumbnail->timer.hasExpired(THUMBNAIL_EXPIRED_MSEC))
+        return;
+
+    // pipe read write fd
+    int fd[2];
+    if (pipe2(fd, O_CLOEXEC) < 0) {
+        qDebug() << "failed to create pipe";
+        return;
+    }
+
+    QVariantMap option;
+    option["include-decoration"] = true;
+    option["include-cursor"] = false;
+    option["native-resolution"] = true;
+
+    QDBusMessage message = QDBusMessage::createMethodCall(kwinService, QStringLiteral("/org/kde/KWin/ScreenShot2"),
+                                                          QStringLiteral("org.kde.KWin.ScreenShot2"), QStringLiteral("CaptureWindow"));
+    message << QVariant::fromValue(windowInfoId) << QVariant::fromValue(option) << QVariant::fromValue(QDBusUnixFileDescriptor(fd[1]));
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    // 消息中保存的是文件描述符的副本，这里关闭写端，窗管写完数据后读端才能读到结束
+    close(fd[1]);
+
+    m_pendingCaptures.insert(wid);
+    const int readFd = fd[0];
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        onCaptureFinished(watcher, wid, readFd, size);
+    });
+}
+
+/**
+ * @brief WindowThumbnailManager::invalidate 标记窗口的预览图失效，下次请求时重新截图
+ */
+void WindowThumbnailManager::invalidate(WId wid)
+{
+    if (Thumbnail *thumbnail = m_thumbnails.object(wid))
+        thumbnail->valid = false;
+}
+
+/**
+ * @brief WindowThumbnailManager::readThumbnail 从管道中读取窗管写入的截图，并缩放到预览图大小
+ * @param fd 管道读端，函数返回前关闭
+ * @param imageInfo 窗管返回的图像信息
+ * @param size 预览图的大小
+ * @return 缩放后的预览图
+ * @note 读取和缩放比较耗时，在工作线程中调用
+ */
+QImage WindowThumbnailManager::readThumbnail(int fd, const QVariantMap &imageInfo, const QSize &size)
+{
+    QFile file;
+    if (!file.open(fd, QIODevice::ReadOnly, QFileDevice::AutoCloseHandle)) {
+        close(fd);
+        return QImage();
+    }
+
+    const int imageWidth = imageInfo.value("width").toInt();
+    const int imageHeight = imageInfo.value("height").toInt();
+    const int imageStride = imageInfo.value("stride").toInt();
+    const QImage::Format imageFormat = static_cast<QImage::Format>(imageInfo.value("format").toUInt());
+
+    if (imageWidth <= 0 || imageHeight <= 0 || imageFormat <= QImage::Format_Invalid || imageFormat >= QImage::NImageFormats)
+        return QImage();
+
+    // 直接读入图像的内存中，避免再拷贝一次
+    QImage image(imageWidth, imageHeight, imageFormat);
+    if (image.isNull() || imageStride < image.bytesPerLine())
+        return QImage();
+
+    if (imageStride == image.bytesPerLine()) {
+        const qint64 length = qint64(imageStride) * imageHeight;
+        if (file.read(reinterpret_cast<char *>(image.bits()), length) != length)
+            return QImage();
+    } else {
+        QByteArray line(imageStride, Qt::Uninitialized);
+        for (int y = 0; y < imageHeight; ++y) {
+            if (file.read(line.data(), imageStride) != imageStride)
+                return QImage();
+            memcpy(image.scanLine(y), line.constData(), static_cast<size_t>(image.bytesPerLine()));
+        }
+    }
+
+    // Qt的平滑缩放在缩小时为区域平均（盒式）滤波，并使用了SSE/NEON等指令加速
+    return image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+void WindowThumbnailManager::onCaptureFinished(QDBusPendingCallWatcher *watcher, WId wid, int fd, const QSize &size)
+{
+    watcher->deleteLater();
+
+    QDBusPendingReply<QVariantMap> reply = *watcher;
+    if (reply.isError()) {
+        qDebug() << "capture window error: " << reply.error().message();
+        close(fd);
+        m_pendingCaptures.remove(wid);
+        return;
+    }
+
+    QFutureWatcher<QImage> *imageWatcher = new QFutureWatcher<QImage>(this);
+    connect(imageWatcher, &QFutureWatcher<QImage>::finished, this, [ = ] {
+        onThumbnailReady(wid, imageWatcher->result());
+        imageWatcher->deleteLater();
+    });
+    imageWatcher->setFuture(QtConcurrent::run(&WindowThumbnailManager::readThumbnail, fd, reply.value(), size));
+}
+
+void WindowThumbnailManager::onThumbnailReady(WId wid, const QImage &image)
+{
+    m_pendingCaptures.remove(wid);
+
+    if (image.isNull())
+        return;
+
+    Thumbnail *thumbnail = new Thumbnail;
+    thumbnail->pixmap = QPixmap::fromImage(image);
+    thumbnail->timer.start();
+    thumbnail->valid = true;
+    m_thumbnails.insert(wid, thumbnail, image.sizeInBytes());
+
+    Q_EMIT thumbnailUpdated(wid);
+}
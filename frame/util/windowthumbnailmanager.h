@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef WINDOWTHUMBNAILMANAGER_H
+#define WINDOWTHUMBNAILMANAGER_H
+
+#include <QObject>
+#include <QCache>
+#include <QPixmap>
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <QSet>
+
+class QDBusPendingCallWatcher;
+
+/**
+ * @brief The WindowThumbnailManager class
+ * 窗口预览图服务，通过窗管(KWin ScreenShot2)异步截图，在工作线程中读取图像数据并缩放到预览图大小，
+ * 按窗口缓存缩放后的预览图，预览界面直接从缓存中读取，缓存过期或被标记失效后在后台重新截图
+ */
+class WindowThumbnailManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    static WindowThumbnailManager *instance();
+
+    bool isKWinAvailable();
+    QPixmap thumbnail(WId wid) const;
+    void requestThumbnail(WId wid, const QString &windowInfoId, const QSize &size);
+    void invalidate(WId wid);
+
+    static QImage readThumbnail(int fd, const QVariantMap &imageInfo, const QSize &size);
+
+Q_SIGNALS:
+    void thumbnailUpdated(WId wid) const;
+
+private:
+    explicit WindowThumbnailManager(QObject *parent = nullptr);
+
+    void onCaptureFinished(QDBusPendingCallWatcher *watcher, WId wid, int fd, const QSize &size);
+    void onThumbnailReady(WId wid, const QImage &image);
+
+private:
+    struct Thumbnail
+    {
+        QPixmap pixmap;
+        QElapsedTimer timer;
+        bool valid;
+    };
+
+    QCache<WId, Thumbnail> m_thumbnails;
+    QSet<WId> m_pendingCaptures;        // 正在截图的窗口，同一个窗口同时只截一次
+    int m_kwinAvailable;                // KWin截图特效是否可用，-1表示尚未查询
+};
+
+#endif // WINDOWTHUMBNAILMANAGER_H
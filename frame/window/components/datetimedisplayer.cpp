@@ -8,6 +8,8 @@
 #include "dockpopupwindow.h"
 #include "utils.h"
 #include "dbusutil.h"
+#include "dbusstatistics.h"
+#include "clockservice.h"
 
 #include <DFontSizeManager>
 #include <DDBusSender>
@@ -38,7 +40,6 @@ DateTimeDisplayer::DateTimeDisplayer(bool showMultiRow, QWidget *parent)
     , m_timeFont(timeFont())
     , m_tipsWidget(new Dock::TipsWidget(this))
     , m_menu(new QMenu(this))
-    , m_tipsTimer(new QTimer(this))
     , m_currentSize(0)
     , m_oneRow(false)
     , m_showMultiRow(showMultiRow)
@@ -52,11 +53,10 @@ DateTimeDisplayer::DateTimeDisplayer(bool showMultiRow, QWidget *parent)
     connect(m_timedateInter, &Timedate::Use24HourFormatChanged, this, &DateTimeDisplayer::onDateTimeFormatChanged);
     // 连接日期时间修改信号,更新日期时间插件的布局
     connect(m_timedateInter, &Timedate::TimeUpdate, this, static_cast<void (QWidget::*)()>(&DateTimeDisplayer::update));
-    // 连接定时器和时间显示的tips信号,一秒钟触发一次，显示时间
-    connect(m_tipsTimer, &QTimer::timeout, this, &DateTimeDisplayer::onTimeChanged);
+    // 整分钟时刷新显示的时间，tips显示期间按秒刷新tips中的时间
+    connect(ClockService::instance(), &ClockService::minuteChanged, this, &DateTimeDisplayer::onTimeChanged);
+    connect(ClockService::instance(), &ClockService::secondChanged, this, &DateTimeDisplayer::onTimeChanged);
     QMetaObject::invokeMethod(this, "onDateTimeFormatChanged");
-    m_tipsTimer->setInterval(1000);
-    m_tipsTimer->start();
     updatePolicy();
     createMenuItem();
     if (Utils::IS_WAYLAND_DISPLAY)
@@ -133,10 +133,10 @@ void DateTimeDisplayer::mouseReleaseEvent(QMouseEvent *event)
 {
     Q_UNUSED(event);
 
-    DDBusSender().service("org.deepin.dde.Widgets1")
+    DBusStatistics::watch(DDBusSender().service("org.deepin.dde.Widgets1")
             .path("/org/deepin/dde/Widgets1")
             .interface("org.deepin.dde.Widgets1")
-            .method("Toggle").call();
+            .method("Toggle").call(), "org.deepin.dde.Widgets1", "Toggle");
 }
 
 QString DateTimeDisplayer::getTimeString(const Dock::Position &position) const
@@ -354,13 +354,13 @@ void DateTimeDisplayer::createMenuItem()
     if (!QFile::exists(ICBC_CONF_FILE)) {
         QAction *timeSettingAction = new QAction(tr("Time settings"), this);
         connect(timeSettingAction, &QAction::triggered, this, [ = ] {
-            DDBusSender()
+            DBusStatistics::watch(DDBusSender()
                     .service(controllCenterService)
                     .path(controllCenterPath)
                     .interface(controllCenterInterface)
                     .method(QString("ShowPage"))
                     .arg(QString("datetime"))
-                    .call();
+                    .call(), controllCenterService, "ShowPage");
         });
 
         m_menu->addAction(timeSettingAction);
@@ -385,6 +385,8 @@ void DateTimeDisplayer::enterEvent(QEvent *event)
     Q_UNUSED(event);
     Q_EMIT requestDrawBackground(rect());
     update();
+    onTimeChanged();
+    ClockService::instance()->requestSeconds(this);
     m_tipPopupWindow->show(tipsPoint());
 }
 
@@ -393,6 +395,7 @@ void DateTimeDisplayer::leaveEvent(QEvent *event)
     Q_UNUSED(event);
     Q_EMIT requestDrawBackground(QRect());
     update();
+    ClockService::instance()->releaseSeconds(this);
     m_tipPopupWindow->hide();
 }
 
@@ -80,7 +80,6 @@ private:
     Dock::TipsWidget *m_tipsWidget;
     QMenu *m_menu;
     QSharedPointer<DockPopupWindow> m_tipPopupWindow;
-    QTimer *m_tipsTimer;
     QString m_lastDateString;
     QString m_lastTimeString;
     int m_currentSize;
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "desktop_widget.h"
+#include "dbusstatistics.h"
 
 #include <QDBusInterface>
 #include <QDebug>
@@ -85,9 +86,12 @@ void DesktopWidget::mousePressEvent(QMouseEvent *event)
  */
 bool DesktopWidget::checkNeedShowDesktop()
 {
+    // QDBusInterface构造时会同步获取接口信息，一起统计到耗时中
+    DBusCallScope scope("com.deepin.wm", "GetIsShowDesktop");
     QDBusInterface wmInter("com.deepin.wm", "/com/deepin/wm", "com.deepin.wm");
     QList<QVariant> argumentList;
     QDBusMessage reply = wmInter.callWithArgumentList(QDBus::Block, QStringLiteral("GetIsShowDesktop"), argumentList);
+    scope.setError(reply.type() != QDBusMessage::ReplyMessage);
     if (reply.type() == QDBusMessage::ReplyMessage && reply.arguments().count() == 1) {
         return !reply.arguments().at(0).toBool();
     }
@@ -25,6 +25,7 @@
 #include "dockscreen.h"
 #include "docktraywindow.h"
 #include "quicksettingcontroller.h"
+#include "dbusstatistics.h"
 
 #include <QDrag>
 #include <QUrl>
@@ -83,6 +84,7 @@ MainPanelControl::MainPanelControl(DockInter *dockInter, QWidget *parent)
     , m_recentHelper(new RecentAppHelper(m_appAreaSonWidget, m_recentAreaWidget, m_dockInter, this))
     , m_toolHelper(new ToolAppHelper(m_toolSonAreaWidget, this))
     , m_multiHelper(new MultiWindowHelper(m_appAreaSonWidget, m_multiWindowWidget, this))
+    , m_resizeIconRequested(false)
 {
     initUI();
     initConnection();
@@ -233,7 +235,7 @@ void MainPanelControl::updateMainPanelLayout()
     }
 
     // 设置任务栏各区域图标大小
-    resizeDockIcon();
+    requestResizeDockIcon();
 
     // 调整托盘区域大小
     onTrayRequestUpdate();
@@ -281,7 +283,7 @@ void MainPanelControl::resizeEvent(QResizeEvent *event)
     // 避免因为部件size没有调整完导致计算的图标大小不准确
     // 然后重复触发m_pluginAreaWidget的reszie事件并重复计算，造成任务栏图标抖动问题
     QWidget::resizeEvent(event);
-    resizeDockIcon();
+    requestResizeDockIcon();
 }
 
 /** 当用户从最近使用区域拖动应用到左侧应用区域的时候，将该应用驻留
@@ -386,7 +388,7 @@ void MainPanelControl::insertItem(int index, DockItem *item)
 
     // 同removeItem处 注意:不能屏蔽此接口，否则会造成插件插入时无法显示
     if (item->itemType() != DockItem::App)
-        resizeDockIcon();
+        requestResizeDockIcon();
 
     item->checkEntry();
 }
@@ -420,7 +422,7 @@ void MainPanelControl::removeItem(DockItem *item)
      *  注意:不能屏蔽此接口，否则会造成插件移除时无法更新icon大小
      */
     if (item->itemType() != DockItem::App)
-        resizeDockIcon();
+        requestResizeDockIcon();
 }
 
 /**任务栏移动应用图标
@@ -623,10 +625,10 @@ bool MainPanelControl::eventFilter(QObject *watched, QEvent *event)
         switch (event->type()) {
         case QEvent::LayoutRequest:
             m_appAreaSonWidget->adjustSize();
-            resizeDockIcon();
+            requestResizeDockIcon();
             break;
         case QEvent::Resize:
-            resizeDockIcon();
+            requestResizeDockIcon();
             break;
         default:
             moveAppSonWidget();
@@ -638,7 +640,7 @@ bool MainPanelControl::eventFilter(QObject *watched, QEvent *event)
     if (watched == m_tray || watched == m_fixedAreaWidget) {
         switch (event->type()) {
         case QEvent::Resize:
-            resizeDockIcon();
+            requestResizeDockIcon();
             break;
         default:
             break;
@@ -1032,7 +1034,7 @@ QSize MainPanelControl::suitableSize(const Position &position, int screenSize, d
 void MainPanelControl::itemUpdated(DockItem *item)
 {
     item->updateGeometry();
-    resizeDockIcon();
+    requestResizeDockIcon();
 }
 
 void MainPanelControl::paintEvent(QPaintEvent *event)
@@ -1097,11 +1099,38 @@ int MainPanelControl::trayAreaSize(qreal ratio) const
     return length;
 }
 
-/**重新计算任务栏上应用图标、插件图标的大小，并设置
+/**
+ * @brief MainPanelControl::requestResizeDockIcon 标记需要重新计算图标大小，在下一次事件循环中统一计算一次。
+ * 登录时会连续插入大量的应用，每次插入都会触发布局和resize事件，如果每次都立即计算，
+ * 每个图标会被设置n次大小并重新加载n次图标。
+ * 合并后同一批事件只计算一次，计算在绘制之前完成，不会多绘制一帧
+ */
+void MainPanelControl::requestResizeDockIcon()
+{
+    if (m_resizeIconRequested)
+        return;
+
+    m_resizeIconRequested = true;
+    QMetaObject::invokeMethod(this, &MainPanelControl::flushResizeDockIcon, Qt::QueuedConnection);
+}
+
+void MainPanelControl::flushResizeDockIcon()
+{
+    if (!m_resizeIconRequested)
+        return;
+
+    m_resizeIconRequested = false;
+    resizeDockIcon();
+}
+
+/**重新计算任务栏上应用图标、插件图标的大小，并设置，需要立即生效时调用，其他情况调用requestResizeDockIcon
  * @brief MainPanelControl::resizeDockIcon
  */
 void MainPanelControl::resizeDockIcon()
 {
+    // 已经立即计算过了，合并的请求不需要再计算
+    m_resizeIconRequested = false;
+
     int iconSize = 0;
     // 总宽度
     if (m_displayMode == DisplayMode::Fashion) {
@@ -1182,32 +1211,32 @@ void MainPanelControl::calcuDockIconSize(int w, int h)
 {
     int appItemSize = qMin(w, h);
     for (int i = 0; i < m_fixedAreaLayout->count(); ++i)
-        m_fixedAreaLayout->itemAt(i)->widget()->setFixedSize(appItemSize, appItemSize);
+        setItemFixedSize(m_fixedAreaLayout->itemAt(i)->widget(), QSize(appItemSize, appItemSize));
 
     if (m_position == Dock::Position::Top || m_position == Dock::Position::Bottom) {
-        m_fixedSpliter->setFixedSize(SPLITER_SIZE, int(w * 0.6));
-        m_appSpliter->setFixedSize(SPLITER_SIZE, int(w * 0.6));
-        m_recentSpliter->setFixedSize(SPLITER_SIZE, int(w * 0.6));
+        setItemFixedSize(m_fixedSpliter, QSize(SPLITER_SIZE, int(w * 0.6)));
+        setItemFixedSize(m_appSpliter, QSize(SPLITER_SIZE, int(w * 0.6)));
+        setItemFixedSize(m_recentSpliter, QSize(SPLITER_SIZE, int(w * 0.6)));
     } else {
-        m_fixedSpliter->setFixedSize(int(h * 0.6), SPLITER_SIZE);
-        m_appSpliter->setFixedSize(int(h * 0.6), SPLITER_SIZE);
-        m_recentSpliter->setFixedSize(int(h * 0.6), SPLITER_SIZE);
+        setItemFixedSize(m_fixedSpliter, QSize(int(h * 0.6), SPLITER_SIZE));
+        setItemFixedSize(m_appSpliter, QSize(int(h * 0.6), SPLITER_SIZE));
+        setItemFixedSize(m_recentSpliter, QSize(int(h * 0.6), SPLITER_SIZE));
     }
 
     // 时尚模式下判断是否需要显示最近打开的应用区域
     if (m_displayMode == Dock::DisplayMode::Fashion) {
         for (int i = 0; i < m_appAreaSonLayout->count(); ++i)
-            m_appAreaSonLayout->itemAt(i)->widget()->setFixedSize(appItemSize, appItemSize);
+            setItemFixedSize(m_appAreaSonLayout->itemAt(i)->widget(), QSize(appItemSize, appItemSize));
 
         if (m_recentLayout->count() > 0) {
             for (int i = 0; i < m_recentLayout->count(); ++i)
-                m_recentLayout->itemAt(i)->widget()->setFixedSize(appItemSize, appItemSize);
+                setItemFixedSize(m_recentLayout->itemAt(i)->widget(), QSize(appItemSize, appItemSize));
 
             // 时尚模式下计算最近打开应用区域的尺寸
             if (m_position == Dock::Position::Top || m_position == Dock::Position::Bottom)
-                m_recentAreaWidget->setFixedSize(appItemSize * m_recentLayout->count(), QWIDGETSIZE_MAX);
+                setItemFixedSize(m_recentAreaWidget, QSize(appItemSize * m_recentLayout->count(), QWIDGETSIZE_MAX));
             else
-                m_recentAreaWidget->setFixedSize(QWIDGETSIZE_MAX, appItemSize * m_recentLayout->count());
+                setItemFixedSize(m_recentAreaWidget, QSize(QWIDGETSIZE_MAX, appItemSize * m_recentLayout->count()));
         }
 
         if (m_multiWindowLayout->count() > 0) {
@@ -1220,7 +1249,7 @@ void MainPanelControl::calcuDockIconSize(int w, int h)
                     continue;
 
                 QSize size = appMultiItem->suitableSize(appItemSize);
-                appMultiItem->setFixedSize(size);
+                setItemFixedSize(appMultiItem, size);
                 multiSizes << size;
             }
             // 计算多开窗口的尺寸
@@ -1229,31 +1258,31 @@ void MainPanelControl::calcuDockIconSize(int w, int h)
                 for (QSize size : multiSizes)
                     totalSize += size.width();
 
-                m_multiWindowWidget->setFixedSize(totalSize, appItemSize);
+                setItemFixedSize(m_multiWindowWidget, QSize(totalSize, appItemSize));
             } else {
                 for (QSize size : multiSizes)
                     totalSize += size.height();
 
-                m_multiWindowWidget->setFixedSize(appItemSize, totalSize);
+                setItemFixedSize(m_multiWindowWidget, QSize(appItemSize, totalSize));
             }
         } else {
-            m_multiWindowWidget->setFixedSize(0, 0);
+            setItemFixedSize(m_multiWindowWidget, QSize(0, 0));
         }
         if (m_toolSonLayout->count() > 0) {
             for (int i = 0; i < m_toolSonLayout->count(); i++)
-                m_toolSonLayout->itemAt(i)->widget()->setFixedSize(appItemSize, appItemSize);
+                setItemFixedSize(m_toolSonLayout->itemAt(i)->widget(), QSize(appItemSize, appItemSize));
 
             if (m_position == Dock::Position::Top || m_position == Dock::Position::Bottom) {
-                m_toolSonAreaWidget->setFixedSize(appItemSize * m_toolSonLayout->count(), QWIDGETSIZE_MAX);
+                setItemFixedSize(m_toolSonAreaWidget, QSize(appItemSize * m_toolSonLayout->count(), QWIDGETSIZE_MAX));
             } else {
-                m_toolSonAreaWidget->setFixedSize(QWIDGETSIZE_MAX, appItemSize * m_toolSonLayout->count());
+                setItemFixedSize(m_toolSonAreaWidget, QSize(QWIDGETSIZE_MAX, appItemSize * m_toolSonLayout->count()));
             }
         }
 
         if (m_position == Dock::Position::Top || m_position == Dock::Position::Bottom)
-            m_toolAreaWidget->setFixedSize(m_multiWindowWidget->width() + m_toolSonAreaWidget->width(), QWIDGETSIZE_MAX);
+            setItemFixedSize(m_toolAreaWidget, QSize(m_multiWindowWidget->width() + m_toolSonAreaWidget->width(), QWIDGETSIZE_MAX));
         else
-            m_toolAreaWidget->setFixedSize(QWIDGETSIZE_MAX, m_multiWindowWidget->height() + m_toolSonAreaWidget->height());
+            setItemFixedSize(m_toolAreaWidget, QSize(QWIDGETSIZE_MAX, m_multiWindowWidget->height() + m_toolSonAreaWidget->height()));
     } else {
         for (int i = 0; i < m_appAreaSonLayout->count(); ++i) {
             DockItem *dockItem = qobject_cast<DockItem *>(m_appAreaSonLayout->itemAt(i)->widget());
@@ -1261,9 +1290,9 @@ void MainPanelControl::calcuDockIconSize(int w, int h)
                 continue;
             if (dockItem->itemType() == DockItem::ItemType::AppMultiWindow) {
                 AppMultiItem *appMultiItem = qobject_cast<AppMultiItem *>(dockItem);
-                dockItem->setFixedSize(appMultiItem->suitableSize(appItemSize));
+                setItemFixedSize(dockItem, appMultiItem->suitableSize(appItemSize));
             } else {
-                dockItem->setFixedSize(appItemSize, appItemSize);
+                setItemFixedSize(dockItem, QSize(appItemSize, appItemSize));
             }
         }
     }
@@ -1281,6 +1310,23 @@ void MainPanelControl::calcuDockIconSize(int w, int h)
     m_appAreaSonLayout->setContentsMargins(appLeftAndRightMargin, appTopAndBottomMargin, appLeftAndRightMargin, appTopAndBottomMargin);
 }
 
+/**
+ * @brief MainPanelControl::setItemFixedSize 设置控件的固定大小，大小没有变化时不做处理，
+ * 避免重复触发控件的resize事件(例如应用图标在resize时会重新加载图标)
+ * @return 大小发生变化时返回true
+ */
+bool MainPanelControl::setItemFixedSize(QWidget *widget, const QSize &size)
+{
+    if (!widget)
+        return false;
+
+    if (widget->minimumSize() == size && widget->maximumSize() == size)
+        return false;
+
+    widget->setFixedSize(size);
+    return true;
+}
+
 void MainPanelControl::onRecentVisibleChanged(bool visible)
 {
     m_appSpliter->setVisible(visible);
@@ -1320,9 +1366,12 @@ void MainPanelControl::onTrayRequestUpdate()
  */
 bool MainPanelControl::checkNeedShowDesktop()
 {
+    // QDBusInterface构造时会同步获取接口信息，一起统计到耗时中
+    DBusCallScope scope("com.deepin.wm", "GetIsShowDesktop");
     QDBusInterface wmInter("com.deepin.wm", "/com/deepin/wm", "com.deepin.wm");
     QList<QVariant> argumentList;
     QDBusMessage reply = wmInter.callWithArgumentList(QDBus::Block, QStringLiteral("GetIsShowDesktop"), argumentList);
+    scope.setError(reply.type() != QDBusMessage::ReplyMessage);
     if (reply.type() == QDBusMessage::ReplyMessage && reply.arguments().count() == 1) {
         return !reply.arguments().at(0).toBool();
     }
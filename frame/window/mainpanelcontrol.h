@@ -35,6 +35,7 @@ public:
     void setPositonValue(Position position);
     void setDisplayMode(DisplayMode dislayMode);
     void resizeDockIcon();
+    void requestResizeDockIcon();
     void updateDockInter(DockInter *dockInter);
 
     QSize suitableSize(const Position &position, int screenSize, double deviceRatio) const;
@@ -70,6 +71,8 @@ private:
     void moveItem(DockItem *sourceItem, DockItem *targetItem);
     void handleDragMove(QDragMoveEvent *e, bool isFilter);
     void calcuDockIconSize(int w, int h);
+    void flushResizeDockIcon();
+    static bool setItemFixedSize(QWidget *widget, const QSize &size);
     bool checkNeedShowDesktop();
     bool appIsOnDock(const QString &appDesktop);
     void dockRecentApp(DockItem *dockItem);
@@ -125,6 +128,7 @@ private:
     RecentAppHelper *m_recentHelper;
     ToolAppHelper *m_toolHelper;
     MultiWindowHelper *m_multiHelper;
+    bool m_resizeIconRequested;     // 已经请求重新计算图标大小，等待下一次事件循环统一计算
 };
 
 #endif // MAINPANELCONTROL_H
@@ -69,7 +69,7 @@ void MainWindow::initConnections()
  */
 void MainWindow::resizeDockIcon()
 {
-    m_mainPanel->resizeDockIcon();
+    m_mainPanel->requestResizeDockIcon();
 }
 
 /**
@@ -679,6 +679,7 @@ QuickDockItem::QuickDockItem(PluginsItemInterface *pluginItem, const QString &it
     , m_mainLayout(nullptr)
     , m_dockItemParent(nullptr)
     , m_isEnter(false)
+    , m_paintStats(PaintProfiler::instance()->stats(QString("QuickDockItem/%1/%2").arg(pluginItem ? pluginItem->pluginName() : QString()).arg(itemKey)))
 {
     initUi();
     initConnection();
@@ -785,6 +786,8 @@ QSize QuickDockItem::suitableSize() const
 
 void QuickDockItem::paintEvent(QPaintEvent *event)
 {
+    PaintScope scope(m_paintStats);
+
     if (!m_pluginItem)
         return QWidget::paintEvent(event);
 
@@ -922,6 +925,7 @@ bool QuickDockItem::eventFilter(QObject *watched, QEvent *event)
 
 void QuickDockItem::resizeEvent(QResizeEvent *event)
 {
+    PaintProfiler::instance()->recordLayout(m_paintStats);
     QWidget::resizeEvent(event);
     updateWidgetSize();
 }
@@ -7,6 +7,7 @@
 #define QUICKPLUGINWINDOW_H
 
 #include "constants.h"
+#include "paintprofiler.h"
 
 #include <QWidget>
 
@@ -137,6 +138,7 @@ private:
     QHBoxLayout *m_mainLayout;
     QWidget *m_dockItemParent;
     bool m_isEnter;
+    PaintProfiler::Stats *m_paintStats;
 };
 
 #endif // QUICKPLUGINWINDOW_H
@@ -360,7 +360,7 @@ void StretchPluginsItem::mousePressEvent(QMouseEvent *e)
     if (e->button() == Qt::LeftButton)
         m_mousePressPoint = e->pos();
 
-    m_popupTipsDelayTimer->stop();
+    m_popupTipsDelayTimer.stop();
     hideNonModel();
 
     if (e->button() == Qt::RightButton
@@ -16,6 +16,7 @@ DBusTrayManager::DBusTrayManager(QObject *parent)
     qDBusRegisterMetaType<TrayList>();
 
     QDBusConnection::sessionBus().connect(this->service(), this->path(), "org.freedesktop.DBus.Properties",  "PropertiesChanged","sa{sv}as", this, SLOT(__propertyChanged__(QDBusMessage)));
+    DBusStatistics::watchSignals(this, true);
 }
 
 DBusTrayManager::~DBusTrayManager()
@@ -6,6 +6,8 @@
 #ifndef DBUSTRAYMANAGER_H_1467094672
 #define DBUSTRAYMANAGER_H_1467094672
 
+#include "dbusstatistics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -54,39 +56,39 @@ public:
 
     Q_PROPERTY(TrayList TrayIcons READ trayIcons NOTIFY TrayIconsChanged)
     inline TrayList trayIcons() const
-    { return qvariant_cast< TrayList >(property("TrayIcons")); }
+    { return qvariant_cast< TrayList >(DBusStatistics::property(this, "TrayIcons")); }
 
 public Q_SLOTS: // METHODS
     inline QDBusPendingReply<> EnableNotification(uint in0, bool in1)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0) << QVariant::fromValue(in1);
-        return asyncCallWithArgumentList(QStringLiteral("EnableNotification"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("EnableNotification"), argumentList);
     }
 
     inline QDBusPendingReply<QString> GetName(uint in0)
     {
         QList<QVariant> argumentList;
         argumentList << QVariant::fromValue(in0);
-        return asyncCallWithArgumentList(QStringLiteral("GetName"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("GetName"), argumentList);
     }
 
     inline QDBusPendingReply<bool> Manage()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("Manage"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("Manage"), argumentList);
     }
 
     inline QDBusPendingReply<> RetryManager()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("RetryManager"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("RetryManager"), argumentList);
     }
 
     inline QDBusPendingReply<bool> Unmanage()
     {
         QList<QVariant> argumentList;
-        return asyncCallWithArgumentList(QStringLiteral("Unmanage"), argumentList);
+        return DBusStatistics::asyncCall(this, QStringLiteral("Unmanage"), argumentList);
     }
 
 Q_SIGNALS: // SIGNALS
@@ -38,6 +38,11 @@ TrayDelegate::TrayDelegate(QListView *view, QObject *parent)
     connect(this, &TrayDelegate::requestDrag, this, &TrayDelegate::onUpdateExpand);
 }
 
+TrayDelegate::~TrayDelegate()
+{
+    releasePaintStats(true);
+}
+
 void TrayDelegate::setPositon(Dock::Position position)
 {
     m_position = position;
@@ -164,7 +169,7 @@ QSize TrayDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelInd
 
 void TrayDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    Q_UNUSED(index);
+    PaintProfiler::instance()->recordLayout(paintStats(index));
     QRect rect = option.rect;
     // 让控件居中显示
     editor->setGeometry(rect.x() + (rect.width() - ICON_SIZE) / 2,
@@ -174,7 +179,7 @@ void TrayDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewI
 
 void TrayDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    Q_UNUSED(index);
+    PaintScope scope(paintStats(index));
 
     // 如果不是弹出菜单（在任务栏上显示的），在鼠标没有移入的时候无需绘制背景
     if (!isPopupTray() && !(option.state & QStyle::State_MouseOver))
@@ -279,3 +284,48 @@ bool TrayDelegate::isPopupTray() const
 
     return dataModel->isIconTray();
 }
+
+/**
+ * @brief TrayDelegate::paintStats 获取托盘图标对应的绘制统计项
+ * 按照持久索引缓存，只有第一次绘制时读取托盘的key，行被移除后由releasePaintStats释放
+ */
+PaintProfiler::Stats *TrayDelegate::paintStats(const QModelIndex &index) const
+{
+    if (index.model() != m_paintStatsModel) {
+        releasePaintStats(true);
+        if (m_paintStatsModel)
+            disconnect(m_paintStatsModel, nullptr, this, nullptr);
+
+        m_paintStatsModel = index.model();
+        if (m_paintStatsModel) {
+            connect(m_paintStatsModel, &QAbstractItemModel::rowsRemoved, this, [ this ] { releasePaintStats(false); });
+            connect(m_paintStatsModel, &QAbstractItemModel::modelReset, this, [ this ] { releasePaintStats(false); });
+        }
+    }
+
+    const QPersistentModelIndex persistentIndex(index);
+    auto it = m_paintStats.constFind(persistentIndex);
+    if (it != m_paintStats.constEnd())
+        return it.value();
+
+    const QString key = index.data(TrayModel::KeyRole).toString();
+    PaintProfiler::Stats *stats = PaintProfiler::instance()->stats(QString("TrayDelegate/%1").arg(key));
+    m_paintStats.insert(persistentIndex, stats);
+    return stats;
+}
+
+/**
+ * @brief TrayDelegate::releasePaintStats 释放已经被移除的行对应的统计项
+ * @param all 为true时释放所有的统计项
+ */
+void TrayDelegate::releasePaintStats(bool all) const
+{
+    for (auto it = m_paintStats.begin(); it != m_paintStats.end();) {
+        if (all || !it.key().isValid()) {
+            PaintProfiler::instance()->release(it.value());
+            it = m_paintStats.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
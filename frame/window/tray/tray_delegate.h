@@ -7,8 +7,11 @@
 #define TRAYDELEGATE_H
 
 #include "constants.h"
+#include "paintprofiler.h"
 
 #include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+#include <QPointer>
 
 #define ITEM_SIZE 30
 // 托盘图标固定20个像素
@@ -26,6 +29,7 @@ class TrayDelegate : public QStyledItemDelegate
 
 public:
     explicit TrayDelegate(QListView *view, QObject *parent = nullptr);
+    ~TrayDelegate() override;
     void setPositon(Dock::Position position);
 
 Q_SIGNALS:
@@ -46,10 +50,14 @@ protected:
 private:
     ExpandIconWidget *expandWidget();
     bool isPopupTray() const;
+    PaintProfiler::Stats *paintStats(const QModelIndex &index) const;
+    void releasePaintStats(bool all) const;
 
 private:
     Dock::Position m_position;
     QListView *m_listView;
+    mutable QPointer<const QAbstractItemModel> m_paintStatsModel;
+    mutable QHash<QPersistentModelIndex, PaintProfiler::Stats *> m_paintStats;
 };
 
 #endif // TRAYDELEGATE_H
@@ -12,12 +12,12 @@
 #include "pluginsiteminterface.h"
 #include "settingconfig.h"
 #include "platformutils.h"
+#include "connectionidentitycache.h"
 
 #include <QMimeData>
 #include <QIcon>
 #include <QDebug>
 #include <QAbstractItemModel>
-#include <QDBusInterface>
 
 #define TRAY_DRAG_FALG "tray_drag"
 #define DOCKQUICKTRAYNAME "Dock_Quick_Tray_Name"
@@ -67,6 +67,7 @@ TrayModel::TrayModel(bool isIconTray, QObject *parent)
     connect(m_monitor, &TrayMonitor::systemTrayRemoved, this, &TrayModel::onSystemTrayRemoved);
 
     connect(m_monitor, &TrayMonitor::requestUpdateIcon, this, &TrayModel::requestUpdateIcon);
+    connect(ConnectionIdentityCache::instance(), &ConnectionIdentityCache::identityReady, this, &TrayModel::onIdentityReady);
     connect(SETTINGCONFIG, &SettingConfig::valueChanged, this, &TrayModel::onSettingChanged);
 
     m_fixedTrayNames = SETTINGCONFIG->value(DOCKQUICKTRAYNAME).toStringList();
@@ -381,28 +382,7 @@ void TrayModel::onXEmbedTrayRemoved(quint32 winId)
 
 QString TrayModel::fileNameByServiceName(const QString &serviceName) const
 {
-    QStringList serviceInfo = serviceName.split("/");
-    if (serviceInfo.size() <= 0)
-        return QString();
-
-    QDBusInterface dbsInterface("org.freedesktop.DBus", "/org/freedesktop/DBus",
-                                "org.freedesktop.DBus", QDBusConnection::sessionBus());
-    QDBusMessage msg = dbsInterface.call("GetConnectionUnixProcessID", serviceInfo[0] );
-    QList<QVariant> arguments = msg.arguments();
-    if (arguments.size() == 0)
-        return QString();
-
-    QVariant v = arguments.at(0);
-    uint pid = v.toUInt();
-    QString path = QString("/proc/%1/cmdline").arg(pid);
-    QFile file(path);
-    if (file.open(QIODevice::ReadOnly)) {
-        const QString fileName = file.readAll();
-        file.close();
-        return fileName;
-    }
-
-    return QString();
+    return ConnectionIdentityCache::instance()->identity(ConnectionIdentityCache::serviceName(serviceName)).fileName;
 }
 
 bool TrayModel::isTypeWriting(const QString &servicePath) const
@@ -542,6 +522,16 @@ void TrayModel::sortItems()
 
 void TrayModel::onSniTrayAdded(const QString &servicePath)
 {
+    // 应用的进程信息异步获取，获取完成后在onIdentityReady中再添加
+    ConnectionIdentityCache *identityCache = ConnectionIdentityCache::instance();
+    const QString &service = ConnectionIdentityCache::serviceName(servicePath);
+    if (!identityCache->contains(service)) {
+        if (!m_pendingSniServices.contains(servicePath))
+            m_pendingSniServices << servicePath;
+        identityCache->request(service);
+        return;
+    }
+
     if (!sniCanExport(servicePath))
         return;
 
@@ -569,6 +559,8 @@ void TrayModel::onSniTrayAdded(const QString &servicePath)
 
 void TrayModel::onSniTrayRemoved(const QString &servicePath)
 {
+    m_pendingSniServices.removeAll(servicePath);
+
     for (const WinInfo &info : m_winInfos) {
         if (info.servicePath == servicePath)  {
             int index = m_winInfos.indexOf(info);
@@ -597,6 +589,18 @@ void TrayModel::onSniTrayRemoved(const QString &servicePath)
     }
 }
 
+void TrayModel::onIdentityReady(const QString &service)
+{
+    const QStringList servicePaths = m_pendingSniServices;
+    for (const QString &servicePath : servicePaths) {
+        if (ConnectionIdentityCache::serviceName(servicePath) != service)
+            continue;
+
+        m_pendingSniServices.removeAll(servicePath);
+        onSniTrayAdded(servicePath);
+    }
+}
+
 void TrayModel::onIndicatorFounded(const QString &indicatorName)
 {
     const QString &itemKey = IndicatorTrayItem::toIndicatorKey(indicatorName);
@@ -708,6 +712,9 @@ void TrayModel::onSettingChanged(const QString &key, const QVariant &value)
 
     QStringList sniServices = m_monitor->sniServices();
     for (const QString &sniService : sniServices) {
+        if (m_pendingSniServices.contains(sniService))
+            continue;
+
         if (sniCanExport(sniService))
             onSniTrayAdded(sniService);
         else
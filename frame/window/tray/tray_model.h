@@ -117,6 +117,7 @@ private Q_SLOTS:
     void onXEmbedTrayRemoved(quint32 winId);
     void onSniTrayAdded(const QString &servicePath);
     void onSniTrayRemoved(const QString &servicePath);
+    void onIdentityReady(const QString &service);
 
     void onIndicatorFounded(const QString &indicatorName);
     void onIndicatorAdded(const QString &indicatorName);
@@ -163,6 +164,7 @@ private:
 
     QMap<QString, IndicatorPlugin *> m_indicatorMap;
     QStringList m_fixedTrayNames;
+    QStringList m_pendingSniServices;       // 等待获取进程信息的SNI服务
     bool m_isTrayIcon;
 };
 
@@ -7,6 +7,8 @@
 #include "themeappicon.h"
 #include "tipswidget.h"
 #include "utils.h"
+#include "dockapplication.h"
+#include "connectionidentitycache.h"
 
 #include <dbusmenu-qt5/dbusmenuimporter.h>
 
@@ -15,6 +17,8 @@
 #include <QPainter>
 #include <QApplication>
 #include <QDBusPendingCall>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QtConcurrent>
 #include <QFuture>
 #include <QMouseEvent>
@@ -24,6 +28,8 @@
 DGUI_USE_NAMESPACE
 
 #define IconSize 20
+// 获取提示信息的超时时间，托盘程序无响应时不再等待
+#define TOOLTIP_TIMEOUT 1000
 
 const QStringList ItemCategoryList {"ApplicationStatus", "Communications", "SystemServices", "Hardware"};
 const QStringList ItemStatusList {"Passive", "Active", "NeedsAttention"};
@@ -40,6 +46,9 @@ SNITrayItemWidget::SNITrayItemWidget(const QString &sniServicePath, QWidget *par
     , m_updateOverlayIconTimer(new QTimer(this))
     , m_updateAttentionIconTimer(new QTimer(this))
     , m_sniServicePath(sniServicePath)
+    , m_sniToolTipValid(false)
+    , m_toolTipRequested(false)
+    , m_toolTipWatcher(nullptr)
     , m_popupTipsDelayTimer(new QTimer(this))
     , m_handleMouseReleaseTimer(new QTimer(this))
     , m_tipsLabel(new TipsWidget)
@@ -72,8 +81,17 @@ SNITrayItemWidget::SNITrayItemWidget(const QString &sniServicePath, QWidget *par
     m_dbusService = pair.first;
     m_dbusPath = pair.second;
 
-    QDBusConnection conn = QDBusConnection::sessionBus();
-    setOwnerPID(conn.interface()->servicePid(m_dbusService));
+    // 进程号通常已由托盘模型缓存，否则异步获取
+    ConnectionIdentityCache *identityCache = ConnectionIdentityCache::instance();
+    if (identityCache->contains(m_dbusService)) {
+        setOwnerPID(identityCache->identity(m_dbusService).pid);
+    } else {
+        connect(identityCache, &ConnectionIdentityCache::identityReady, this, [ this ](const QString &service) {
+            if (service == m_dbusService)
+                setOwnerPID(ConnectionIdentityCache::instance()->identity(service).pid);
+        });
+        identityCache->request(m_dbusService);
+    }
 
     m_sniInter = new StatusNotifierItem(m_dbusService, m_dbusPath, QDBusConnection::sessionBus(), this);
     m_sniInter->setSync(false);
@@ -138,6 +156,11 @@ SNITrayItemWidget::SNITrayItemWidget(const QString &sniServicePath, QWidget *par
     connect(m_sniInter, &StatusNotifierItem::NewStatus, [ = ] {
         onSNIStatusChanged(m_sniInter->status());
     });
+    // 提示信息变化时只标记缓存失效，下次悬停时再获取
+    connect(m_sniInter, &StatusNotifierItem::ToolTipChanged, this, &SNITrayItemWidget::onSNIToolTipChanged);
+    connect(m_sniInter, &StatusNotifierItem::NewToolTip, this, [ = ] {
+        m_sniToolTipValid = false;
+    });
 
     QMetaObject::invokeMethod(this, &SNITrayItemWidget::initMember, Qt::QueuedConnection);
 }
@@ -235,9 +258,13 @@ QPair<QString, QString> SNITrayItemWidget::serviceAndPath(const QString &service
 
 uint SNITrayItemWidget::servicePID(const QString &servicePath)
 {
-    QString serviceName = serviceAndPath(servicePath).first;
-    QDBusConnection conn = QDBusConnection::sessionBus();
-    return conn.interface()->servicePid(serviceName);
+    // 未缓存时返回0，并在后台获取
+    const QString &serviceName = serviceAndPath(servicePath).first;
+    ConnectionIdentityCache *identityCache = ConnectionIdentityCache::instance();
+    if (!identityCache->contains(serviceName))
+        identityCache->request(serviceName);
+
+    return identityCache->identity(serviceName).pid;
 }
 
 void SNITrayItemWidget::initMenu()
@@ -549,8 +576,11 @@ QPixmap SNITrayItemWidget::newIconPixmap(IconType iconType)
 void SNITrayItemWidget::enterEvent(QEvent *event)
 {
     // 触屏不显示hover效果
-    if (!qApp->property(IS_TOUCH_STATE).toBool()) {
+    if (!DockApplication::isTouchState()) {
         m_popupTipsDelayTimer->start();
+        // 在等待弹出提示的时间内预先获取提示信息
+        if (!m_sniToolTipValid)
+            fetchToolTip();
     }
 
     BaseTrayWidget::enterEvent(event);
@@ -559,6 +589,7 @@ void SNITrayItemWidget::enterEvent(QEvent *event)
 void SNITrayItemWidget::leaveEvent(QEvent *event)
 {
     m_popupTipsDelayTimer->stop();
+    m_toolTipRequested = false;
     if (m_popupShown && !PopupWindow->model())
         hidePopup();
 
@@ -654,33 +685,71 @@ void SNITrayItemWidget::showHoverTips()
     if (PopupWindow->model())
         return;
 
-    QProcess p;
-    p.start("qdbus", {m_dbusService});
-    if (!p.waitForFinished(1000)) {
-        qDebug() << "sni dbus service error : " << m_dbusService;
+    // 有缓存时直接显示，否则等待异步获取完成后再显示
+    if (m_sniToolTipValid) {
+        showToolTip();
         return;
     }
 
-    QDBusInterface infc(m_dbusService, m_dbusPath);
-    QDBusMessage msg = infc.call("Get", "org.kde.StatusNotifierItem", "ToolTip");
-    if (msg.type() == QDBusMessage::ReplyMessage) {
-        QDBusArgument arg = msg.arguments().at(0).value<QDBusVariant>().variant().value<QDBusArgument>();
-        DBusToolTip tooltip = qdbus_cast<DBusToolTip>(arg);
+    m_toolTipRequested = true;
+    fetchToolTip();
+}
+
+/**
+ * @brief SNITrayItemWidget::fetchToolTip 异步获取托盘程序的提示信息
+ * 托盘程序无响应时在TOOLTIP_TIMEOUT后放弃，不会阻塞任务栏
+ */
+void SNITrayItemWidget::fetchToolTip()
+{
+    if (m_toolTipWatcher || m_dbusService.isEmpty())
+        return;
+
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_dbusService, m_dbusPath, "org.freedesktop.DBus.Properties", "Get");
+    msg << QString("org.kde.StatusNotifierItem") << QString("ToolTip");
+
+    m_toolTipWatcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(msg, TOOLTIP_TIMEOUT), this);
+    connect(m_toolTipWatcher, &QDBusPendingCallWatcher::finished, this, [ this ](QDBusPendingCallWatcher *watcher) {
+        watcher->deleteLater();
+        m_toolTipWatcher = nullptr;
 
-        if (tooltip.title.isEmpty())
+        QDBusPendingReply<QDBusVariant> reply = *watcher;
+        if (reply.isError()) {
+            qDebug() << "sni dbus service error : " << m_dbusService << reply.error().message();
+            m_toolTipRequested = false;
             return;
+        }
 
-        // 当提示信息中有换行符时，需要使用setTextList
-        if (tooltip.title.contains('\n'))
-            m_tipsLabel->setTextList(tooltip.title.split('\n'));
-        else
-            m_tipsLabel->setText(tooltip.title);
+        const QDBusArgument &arg = reply.value().variant().value<QDBusArgument>();
+        onSNIToolTipChanged(qdbus_cast<DBusToolTip>(arg));
+    });
+}
 
-        m_tipsLabel->setAccessibleName(itemKeyForConfig().replace("sni:",""));
+void SNITrayItemWidget::showToolTip()
+{
+    m_toolTipRequested = false;
 
+    if (m_sniToolTip.title.isEmpty())
+        return;
 
-        showPopupWindow(m_tipsLabel);
-    }
+    // 当提示信息中有换行符时，需要使用setTextList
+    if (m_sniToolTip.title.contains('\n'))
+        m_tipsLabel->setTextList(m_sniToolTip.title.split('\n'));
+    else
+        m_tipsLabel->setText(m_sniToolTip.title);
+
+    m_tipsLabel->setAccessibleName(itemKeyForConfig().replace("sni:",""));
+
+    showPopupWindow(m_tipsLabel);
+}
+
+void SNITrayItemWidget::onSNIToolTipChanged(const DBusToolTip &value)
+{
+    m_sniToolTip = value;
+    m_sniToolTipValid = true;
+
+    // 正在等待显示，或者提示已经显示时刷新内容
+    if (m_toolTipRequested || (m_popupShown && PopupWindow->getContent() == m_tipsLabel && !PopupWindow->model()))
+        showToolTip();
 }
 
 void SNITrayItemWidget::hideNonModel()
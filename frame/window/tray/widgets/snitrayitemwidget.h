@@ -16,6 +16,7 @@
 #include <QDBusObjectPath>
 
 class DBusMenuImporter;
+class QDBusPendingCallWatcher;
 namespace Dock {
 class TipsWidget;
 }
@@ -85,6 +86,7 @@ private Q_SLOTS:
     void onSNIOverlayIconNameChanged(const QString &value);
     void onSNIOverlayIconPixmapChanged(DBusImageList  value);
     void onSNIStatusChanged(const QString &status);
+    void onSNIToolTipChanged(const DBusToolTip &value);
     void hidePopup();
     void hideNonModel();
     void popupWindowAccept();
@@ -99,6 +101,8 @@ private:
     void setMouseData(QMouseEvent *e);
     void handleMouseRelease();
     void initMember();
+    void fetchToolTip();
+    void showToolTip();
 
 private:
     StatusNotifierItem *m_sniInter;
@@ -130,6 +134,10 @@ private:
     QString m_sniOverlayIconName;
     DBusImageList m_sniOverlayIconPixmap;
     QString m_sniStatus;
+    DBusToolTip m_sniToolTip;
+    bool m_sniToolTipValid;                     // 提示信息是否已缓存
+    bool m_toolTipRequested;                    // 提示信息获取完成后是否需要显示
+    QDBusPendingCallWatcher *m_toolTipWatcher;  // 正在进行的提示信息请求
     QTimer *m_popupTipsDelayTimer;
     QTimer *m_handleMouseReleaseTimer;
     QPair<QPoint, Qt::MouseButton> m_lastMouseReleaseData;
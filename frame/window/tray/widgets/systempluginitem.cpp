@@ -6,6 +6,7 @@
 #include "systempluginitem.h"
 #include "utils.h"
 #include "dockpopupwindow.h"
+#include "dockapplication.h"
 
 #include <QProcess>
 #include <QDebug>
@@ -199,7 +200,7 @@ void SystemPluginItem::enterEvent(QEvent *event)
     }
 
     // 触屏不显示hover效果
-    if (!qApp->property(IS_TOUCH_STATE).toBool()) {
+    if (!DockApplication::isTouchState()) {
         m_popupTipsDelayTimer->start();
     }
     update();
@@ -11,6 +11,8 @@
 #include "dockitemmanager.h"
 #include "dockscreen.h"
 #include "displaymanager.h"
+#include "spantracer.h"
+#include "dbusstatistics.h"
 
 #include <DWindowManagerHelper>
 #include <DDBusSender>
@@ -66,6 +68,8 @@ void WindowManager::addWindow(MainWindowBase *window)
 
 void WindowManager::launch()
 {
+    DOCK_TRACE_SCOPE("WindowManager::launch");
+
     if (!qApp->property("CANSHOW").toBool())
         return;
 
@@ -391,6 +395,7 @@ void WindowManager::RegisterDdeSession()
     qunsetenv(envName.toUtf8().data());
 
     if (!cookie.isEmpty()) {
+        DBusCallScope scope(sessionManagerService, "Register");
         QDBusPendingReply<bool> r = DDBusSender()
                 .interface(sessionManagerService)
                 .path(sessionManagerPath)
@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "xcb_shmcapture.h"
+
+#include <QX11Info>
+#include <QTimer>
+#include <QDebug>
+
+#include <xcb/composite.h>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+// 内存池中所有共享内存段的总大小上限，足够容纳两张4K窗口的截图
+#define MAX_POOL_SIZE (64 * 1024 * 1024)
+// 共享内存段按1M对齐，便于不同大小的窗口复用
+#define SEGMENT_ALIGN (1024 * 1024)
+// 最后一次截图结束后经过这个时间(毫秒)释放所有空闲的内存段
+#define SEGMENT_IDLE_MSEC (10 * 1000)
+
+XcbShmCapture::XcbShmCapture()
+    : m_connection(QX11Info::isPlatformX11() ? QX11Info::connection() : nullptr)
+    , m_shmAvailable(false)
+    , m_compositeAvailable(false)
+    , m_poolSize(0)
+    , m_idleTimer(new QTimer)
+{
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(SEGMENT_IDLE_MSEC);
+    QObject::connect(m_idleTimer, &QTimer::timeout, m_idleTimer, [ this ] { releaseIdleSegments(); });
+
+    if (!m_connection)
+        return;
+
+    // 出错时传入错误指针自行释放，否则错误会进入Qt的事件队列中被当作X错误输出
+    xcb_generic_error_t *error = nullptr;
+    const xcb_query_extension_reply_t *shmExtension = xcb_get_extension_data(m_connection, &xcb_shm_id);
+    if (shmExtension && shmExtension->present) {
+        xcb_shm_query_version_reply_t *reply = xcb_shm_query_version_reply(m_connection, xcb_shm_query_version(m_connection), &error);
+        if (reply) {
+            m_shmAvailable = true;
+            free(reply);
+        }
+        free(error);
+        error = nullptr;
+    }
+
+    // NameWindowPixmap需要composite 0.2及以上版本
+    const xcb_query_extension_reply_t *compositeExtension = xcb_get_extension_data(m_connection, &xcb_composite_id);
+    if (compositeExtension && compositeExtension->present) {
+        xcb_composite_query_version_reply_t *reply = xcb_composite_query_version_reply(m_connection,
+                xcb_composite_query_version(m_connection, XCB_COMPOSITE_MAJOR_VERSION, XCB_COMPOSITE_MINOR_VERSION), &error);
+        if (reply) {
+            m_compositeAvailable = (reply->major_version > 0 || reply->minor_version >= 2);
+            free(reply);
+        }
+        free(error);
+    }
+
+    qDebug() << "xcb shm capture, shm:" << m_shmAvailable << "composite:" << m_compositeAvailable;
+}
+
+XcbShmCapture::~XcbShmCapture()
+{
+    delete m_idleTimer;
+
+    QMutexLocker locker(&m_mutex);
+    for (Segment *segment : m_segments) {
+        // 仍被QImage引用的内存段在QImage释放时由cleanupImage处理
+        if (!segment->inUse)
+            destroySegment(segment);
+    }
+    m_segments.clear();
+}
+
+XcbShmCapture *XcbShmCapture::instance()
+{
+    static XcbShmCapture *capture = new XcbShmCapture;
+    return capture;
+}
+
+bool XcbShmCapture::isValid() const
+{
+    return m_connection && m_shmAvailable;
+}
+
+/**
+ * @brief XcbShmCapture::capture 截取窗口图像
+ * @param winId 窗口id
+ * @return 引用共享内存的图像，QImage释放后内存段归还内存池，需要长期保存时请先缩放或拷贝
+ */
+QImage XcbShmCapture::capture(xcb_window_t winId)
+{
+    if (!isValid())
+        return QImage();
+
+    // 窗口可能已经关闭，错误由这里处理
+    xcb_generic_error_t *error = nullptr;
+    xcb_get_geometry_reply_t *geometry = xcb_get_geometry_reply(m_connection, xcb_get_geometry(m_connection, winId), &error);
+    free(error);
+    if (!geometry)
+        return QImage();
+
+    const int width = geometry->width;
+    const int height = geometry->height;
+    const int depth = geometry->depth;
+    free(geometry);
+
+    QImage::Format format = QImage::Format_Invalid;
+    if (depth == 32)
+        format = QImage::Format_ARGB32_Premultiplied;
+    else if (depth == 24)
+        format = QImage::Format_RGB32;
+
+    if (format == QImage::Format_Invalid || width <= 0 || height <= 0)
+        return QImage();
+
+    // 开启合成时窗口内容保存在离屏pixmap中，即使窗口被遮挡也能获取到完整的图像
+    xcb_drawable_t drawable = winId;
+    xcb_pixmap_t pixmap = XCB_NONE;
+    if (m_compositeAvailable) {
+        pixmap = xcb_generate_id(m_connection);
+        error = xcb_request_check(m_connection, xcb_composite_name_window_pixmap_checked(m_connection, winId, pixmap));
+        if (error) {
+            free(error);
+            error = nullptr;
+            pixmap = XCB_NONE;
+        } else {
+            drawable = pixmap;
+        }
+    }
+
+    const int bytesPerLine = width * 4;
+    Segment *segment = acquireSegment(size_t(bytesPerLine) * size_t(height));
+    if (!segment) {
+        if (pixmap != XCB_NONE)
+            xcb_free_pixmap(m_connection, pixmap);
+        return QImage();
+    }
+
+    xcb_shm_get_image_cookie_t cookie = xcb_shm_get_image(m_connection, drawable, 0, 0, width, height, ~0u,
+                                                          XCB_IMAGE_FORMAT_Z_PIXMAP, segment->shmseg, 0);
+    xcb_shm_get_image_reply_t *reply = xcb_shm_get_image_reply(m_connection, cookie, &error);
+    free(error);
+
+    if (pixmap != XCB_NONE)
+        xcb_free_pixmap(m_connection, pixmap);
+
+    if (!reply) {
+        releaseSegment(segment);
+        return QImage();
+    }
+    free(reply);
+
+    return QImage(segment->address, width, height, bytesPerLine, format, &XcbShmCapture::cleanupImage, segment);
+}
+
+XcbShmCapture::Segment *XcbShmCapture::acquireSegment(size_t size)
+{
+    size = (size + SEGMENT_ALIGN - 1) / SEGMENT_ALIGN * SEGMENT_ALIGN;
+
+    QMutexLocker locker(&m_mutex);
+
+    Segment *suitable = nullptr;
+    for (Segment *segment : m_segments) {
+        if (!segment->inUse && segment->size >= size && (!suitable || segment->size < suitable->size))
+            suitable = segment;
+    }
+
+    if (suitable) {
+        suitable->inUse = true;
+        return suitable;
+    }
+
+    // 超过内存池的大小限制时，先释放空闲的内存段，仍然不够时不再分配，由调用方使用其他方式截图
+    for (auto it = m_segments.begin(); it != m_segments.end() && m_poolSize + size > MAX_POOL_SIZE;) {
+        if ((*it)->inUse) {
+            ++it;
+            continue;
+        }
+
+        destroySegment(*it);
+        it = m_segments.erase(it);
+    }
+
+    if (m_poolSize + size > MAX_POOL_SIZE)
+        return nullptr;
+
+    const int shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (shmid < 0) {
+        qWarning() << "shmget failed, size:" << size;
+        return nullptr;
+    }
+
+    void *address = shmat(shmid, nullptr, 0);
+    if (address == reinterpret_cast<void *>(-1)) {
+        shmctl(shmid, IPC_RMID, nullptr);
+        return nullptr;
+    }
+
+    const xcb_shm_seg_t shmseg = xcb_generate_id(m_connection);
+    xcb_generic_error_t *error = xcb_request_check(m_connection, xcb_shm_attach_checked(m_connection, shmseg, static_cast<uint32_t>(shmid), false));
+
+    // X服务关联后立即标记删除，所有进程分离后系统自动回收，任务栏异常退出也不会残留
+    shmctl(shmid, IPC_RMID, nullptr);
+
+    if (error) {
+        free(error);
+        shmdt(address);
+        return nullptr;
+    }
+
+    Segment *segment = new Segment { shmseg, shmid, static_cast<uchar *>(address), size, true };
+    m_segments << segment;
+    m_poolSize += size;
+
+    return segment;
+}
+
+void XcbShmCapture::releaseSegment(Segment *segment)
+{
+    QMutexLocker locker(&m_mutex);
+    segment->inUse = false;
+
+    // QImage可能在其他线程中释放，通过事件循环重新开始计时
+    QMetaObject::invokeMethod(m_idleTimer, "start", Qt::QueuedConnection);
+}
+
+/**
+ * @brief XcbShmCapture::releaseIdleSegments 一段时间没有截图(如预览窗口已经关闭)，释放所有空闲的内存段
+ */
+void XcbShmCapture::releaseIdleSegments()
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_segments.begin(); it != m_segments.end();) {
+        if ((*it)->inUse) {
+            ++it;
+            continue;
+        }
+
+        destroySegment(*it);
+        it = m_segments.erase(it);
+    }
+}
+
+void XcbShmCapture::destroySegment(Segment *segment)
+{
+    m_poolSize -= segment->size;
+
+    xcb_shm_detach(m_connection, segment->shmseg);
+    xcb_flush(m_connection);
+    shmdt(segment->address);
+    delete segment;
+}
+
+void XcbShmCapture::cleanupImage(void *info)
+{
+    instance()->releaseSegment(static_cast<Segment *>(info));
+}
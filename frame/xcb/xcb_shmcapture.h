@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef XCB_SHMCAPTURE_H
+#define XCB_SHMCAPTURE_H
+
+#include <QImage>
+#include <QList>
+#include <QMutex>
+
+#include <xcb/xcb.h>
+#include <xcb/shm.h>
+
+class QTimer;
+
+/**
+ * @brief The XcbShmCapture class
+ * 基于MIT-SHM的X11窗口截图，通过composite扩展获取窗口的离屏pixmap，
+ * 使用xcb_shm_get_image将图像直接写入共享内存，返回的QImage直接引用共享内存，不再拷贝。
+ * 共享内存段在多次截图之间复用，QImage释放后归还到内存池中，内存池有总大小的限制，一段时间没有截图后释放所有空闲的内存段
+ */
+class XcbShmCapture
+{
+public:
+    static XcbShmCapture *instance();
+
+    bool isValid() const;
+    QImage capture(xcb_window_t winId);
+
+private:
+    struct Segment
+    {
+        xcb_shm_seg_t shmseg;
+        int shmid;
+        uchar *address;
+        size_t size;
+        bool inUse;
+    };
+
+    XcbShmCapture();
+    ~XcbShmCapture();
+
+    Segment *acquireSegment(size_t size);
+    void releaseSegment(Segment *segment);
+    void destroySegment(Segment *segment);
+    void releaseIdleSegments();
+
+    static void cleanupImage(void *info);
+
+private:
+    xcb_connection_t *m_connection;
+    bool m_shmAvailable;
+    bool m_compositeAvailable;
+
+    QMutex m_mutex;
+    QList<Segment *> m_segments;
+    size_t m_poolSize;          // 所有内存段的总大小
+    QTimer *m_idleTimer;
+};
+
+#endif // XCB_SHMCAPTURE_H
@@ -6,11 +6,13 @@
 #include "datetimeplugin.h"
 #include "../../widgets/tipswidget.h"
 #include "../../frame/util/utils.h"
+#include "../../frame/util/clockservice.h"
 
 #include <DDBusSender>
 
 #include <QDebug>
 #include <QDBusConnectionInterface>
+#include <QEvent>
 
 #include <unistd.h>
 
@@ -21,7 +23,6 @@ DatetimePlugin::DatetimePlugin(QObject *parent)
     : QObject(parent)
     , m_centralWidget(nullptr)
     , m_dateTipsLabel(nullptr)
-    , m_refershTimer(nullptr)
     , m_interface(nullptr)
     , m_pluginLoaded(false)
 {
@@ -71,16 +72,15 @@ void DatetimePlugin::loadPlugin()
 
     m_pluginLoaded = true;
     m_dateTipsLabel.reset(new TipsWidget);
-    m_refershTimer = new QTimer(this);
     m_dateTipsLabel->setObjectName("datetime");
-
-    m_refershTimer->setInterval(1000);
-    m_refershTimer->start();
+    // tips中显示秒数，只在tips显示期间按秒刷新
+    m_dateTipsLabel->installEventFilter(this);
 
     m_centralWidget.reset(new DatetimeWidget);
 
     connect(m_centralWidget.data(), &DatetimeWidget::requestUpdateGeometry, [this] { m_proxyInter->itemUpdate(this, pluginName()); });
-    connect(m_refershTimer, &QTimer::timeout, this, &DatetimePlugin::updateCurrentTimeString);
+    connect(ClockService::instance(), &ClockService::minuteChanged, this, &DatetimePlugin::updateCurrentTimeString);
+    connect(ClockService::instance(), &ClockService::secondChanged, this, &DatetimePlugin::updateCurrentTimeString);
 
     m_proxyInter->itemAdded(this, pluginName());
 
@@ -201,6 +201,20 @@ void DatetimePlugin::pluginSettingsChanged()
     refreshPluginItemsVisible();
 }
 
+bool DatetimePlugin::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_dateTipsLabel.data()) {
+        if (event->type() == QEvent::Show) {
+            updateCurrentTimeString();
+            ClockService::instance()->requestSeconds(watched);
+        } else if (event->type() == QEvent::Hide) {
+            ClockService::instance()->releaseSeconds(watched);
+        }
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
 void DatetimePlugin::updateCurrentTimeString()
 {
     const QDateTime currentDateTime = QDateTime::currentDateTime();
@@ -9,7 +9,6 @@
 #include "pluginsiteminterface.h"
 #include "datetimewidget.h"
 
-#include <QTimer>
 #include <QLabel>
 #include <QSettings>
 
@@ -49,6 +48,9 @@ public:
 
     void pluginSettingsChanged() override;
 
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void updateCurrentTimeString();
     void refreshPluginItemsVisible();
@@ -61,7 +63,6 @@ private:
 private:
     QScopedPointer<DatetimeWidget> m_centralWidget;
     QScopedPointer<Dock::TipsWidget> m_dateTipsLabel;
-    QTimer *m_refershTimer;
     QString m_currentTimeString;
     QDBusInterface *m_interface;
     bool m_pluginLoaded;
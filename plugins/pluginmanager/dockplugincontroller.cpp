@@ -9,6 +9,8 @@
 #include "pluginadapter.h"
 #include "utils.h"
 #include "settingconfig.h"
+#include "spantracer.h"
+#include "plugininitqueue.h"
 
 #include <DNotifySender>
 #include <DSysInfo>
@@ -17,18 +19,11 @@
 #include <QDir>
 #include <QMapIterator>
 #include <QPluginLoader>
+#include <QElapsedTimer>
 
 #define PLUGININFO "pluginInfo"
 #define DOCK_QUICK_PLUGINS "Dock_Quick_Plugins"
 
-static const QStringList CompatiblePluginApiList {
-    "1.1.1",
-    "1.2",
-    "1.2.1",
-    "1.2.2",
-    DOCK_PLUGIN_API_VERSION
-};
-
 class PluginInfo : public QObject
 {
 public:
@@ -42,6 +37,7 @@ DockPluginController::DockPluginController(PluginProxyInterface *proxyInter, QOb
     : QObject(parent)
     , m_dbusDaemonInterface(QDBusConnection::sessionBus().interface())
     , m_dockDaemonInter(new DockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus(), this))
+    , m_initQueue(new PluginInitQueue([ this ](PluginsItemInterface *interface) { initPlugin(interface); }, this))
     , m_proxyInter(proxyInter)
 {
     qApp->installEventFilter(this);
@@ -450,21 +446,23 @@ void DockPluginController::positionChanged()
 
 void DockPluginController::loadPlugin(const QString &pluginFile)
 {
+    DOCK_TRACE_SCOPE_ARG("loadPlugin", pluginFile);
     QPluginLoader *pluginLoader = new QPluginLoader(pluginFile, this);
     const QJsonObject &meta = pluginLoader->metaData().value("MetaData").toObject();
     const QString &pluginApi = meta.value("api").toString();
     bool pluginIsValid = true;
-    if (pluginApi.isEmpty() || !CompatiblePluginApiList.contains(pluginApi)) {
+    if (!PluginLoader::isCompatibleApi(pluginApi)) {
         qDebug() << objectName()
-                 << "plugin api version not matched! expect versions:" << CompatiblePluginApiList
+                 << "plugin api version not matched! expect versions:" << PluginLoader::compatibleApiList()
                  << ", got version:" << pluginApi
                  << ", the plugin file is:" << pluginFile;
 
         pluginIsValid = false;
     }
 
-    PluginsItemInterface *interface = qobject_cast<PluginsItemInterface *>(pluginLoader->instance());
-    if (!interface) {
+    // api版本不匹配时不再加载动态库
+    PluginsItemInterface *interface = pluginIsValid ? qobject_cast<PluginsItemInterface *>(pluginLoader->instance()) : nullptr;
+    if (pluginIsValid && !interface) {
         // 如果识别当前插件失败，就认为这个插件是v20的插件，将其转换为v20插件接口
         PluginsItemInterface_V20 *interface_v20 = qobject_cast<PluginsItemInterface_V20 *>(pluginLoader->instance());
         if (interface_v20) {
@@ -542,9 +540,7 @@ void DockPluginController::loadPlugin(const QString &pluginFile)
     // NOTE(justforlxz): 插件的所有初始化工作都在init函数中进行，
     // loadPlugin函数是按队列执行的，initPlugin函数会有可能导致
     // 函数执行被阻塞。
-    QTimer::singleShot(1, this, [ = ] {
-        initPlugin(interface);
-    });
+    m_initQueue->enqueue(interface);
 }
 
 void DockPluginController::initPlugin(PluginsItemInterface *interface)
@@ -553,11 +549,17 @@ void DockPluginController::initPlugin(PluginsItemInterface *interface)
         return;
 
     qDebug() << objectName() << "init plugin: " << interface->pluginName();
+    DOCK_TRACE_SCOPE_ARG("initPlugin", interface->pluginName());
+    QElapsedTimer timer;
+    timer.start();
     interface->init(this);
+    const qint64 initMSecs = timer.elapsed();
 
     for (const auto &pair : m_pluginLoadMap.keys()) {
-        if (pair.second == interface)
+        if (pair.second == interface) {
             m_pluginLoadMap.insert(pair, true);
+            PluginLoader::recordInitTime(pair.first, initMSecs);
+        }
     }
 
     bool loaded = true;
@@ -572,7 +574,7 @@ void DockPluginController::initPlugin(PluginsItemInterface *interface)
     if (loaded) {
         emit pluginLoadFinished();
     }
-    qDebug() << objectName() << "init plugin finished: " << interface->pluginName();
+    qDebug() << objectName() << "init plugin finished: " << interface->pluginName() << "cost:" << initMSecs << "ms";
 }
 
 void DockPluginController::refreshPluginSettings()
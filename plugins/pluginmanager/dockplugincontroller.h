@@ -16,6 +16,7 @@
 
 class PluginsItemInterface;
 class PluginAdapter;
+class PluginInitQueue;
 
 class DockPluginController : public QObject, protected PluginProxyInterface
 {
@@ -91,6 +92,7 @@ private:
 
     // filepath, interface, loaded
     QMap<QPair<QString, PluginsItemInterface *>, bool> m_pluginLoadMap;
+    PluginInitQueue *m_initQueue;
 
     QJsonObject m_pluginSettingsObject;
     QMap<qulonglong, PluginAdapter *> m_pluginAdapterMap;
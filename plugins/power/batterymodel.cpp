@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "batterymodel.h"
+#include "constants.h"
+#include "dbus/dbuspower.h"
+
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusReply>
+#include <QIcon>
+
+#include <DGuiApplicationHelper>
+#include <DPlatformTheme>
+
+DGUI_USE_NAMESPACE
+
+#define PROPERTIES_INTERFACE "org.freedesktop.DBus.Properties"
+#define POWER_PATH "/org/deepin/dde/Power1"
+#define UPOWER_SERVICE "org.freedesktop.UPower"
+#define UPOWER_PATH "/org/freedesktop/UPower"
+#define ICON_SIZE 20
+
+BatteryModel::BatteryModel(QObject *parent)
+    : QObject(parent)
+    , m_exist(false)
+    , m_percentage(0)
+    , m_onBattery(false)
+    , m_state(UNKNOWN)
+{
+    qRegisterMetaType<BatteryStateMap>("BatteryStateMap");
+    qDBusRegisterMetaType<BatteryStateMap>();
+    qRegisterMetaType<BatteryPercentageMap>("BatteryPercentageMap");
+    qDBusRegisterMetaType<BatteryPercentageMap>();
+
+    // 先连接信号再获取属性，保证不会漏掉获取过程中的变化
+    QDBusConnection::sessionBus().connect(DBusPower::staticInterfaceName(), POWER_PATH, PROPERTIES_INTERFACE, "PropertiesChanged",
+                                          this, SLOT(onPropertiesChanged(const QDBusMessage &)));
+    QDBusConnection::systemBus().connect(UPOWER_SERVICE, UPOWER_PATH, PROPERTIES_INTERFACE, "PropertiesChanged",
+                                         this, SLOT(onPropertiesChanged(const QDBusMessage &)));
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, this, &BatteryModel::onIconThemeChanged);
+
+    QDBusMessage message = QDBusMessage::createMethodCall(DBusPower::staticInterfaceName(), POWER_PATH, PROPERTIES_INTERFACE, "GetAll");
+    message << QString(DBusPower::staticInterfaceName());
+    const QDBusReply<QVariantMap> reply = QDBusConnection::sessionBus().call(message);
+    if (reply.isValid())
+        update(reply.value());
+    else
+        qWarning() << "get power properties failed:" << reply.error().message();
+}
+
+QString BatteryModel::iconName(int themeType) const
+{
+    // 先截断小数再分段，5.6%仍然显示0-5%的图标
+    const int percentage = int(uint(qBound(0.0, m_percentage, 100.0)));
+    // onBattery应该表示的是当前是否使用电池在供电，为true表示没插入电源
+    const bool plugged = !m_onBattery;
+
+    /*根据新需求，电池电量显示分别是*/
+    /* 0-5%、6-10%、11%-20%、21-30%、31-40%、41-50%、51-60%、61%-70%、71-80%、81-90%、91-100% */
+    QString percentageStr;
+    if (percentage <= 5)
+        percentageStr = "000";
+    else
+        percentageStr = QString("%1").arg(qMin(100, (percentage + 9) / 10 * 10), 3, 10, QChar('0'));
+
+    QString iconStr;
+    if (m_state == BatteryState::FULLY_CHARGED && plugged) {
+        iconStr = QString("battery-full-charged-symbolic");
+    } else {
+        iconStr = QString("battery-%1-%2")
+                  .arg(percentageStr)
+                  .arg(plugged ? "plugged-symbolic" : "symbolic");
+    }
+
+    if (themeType == DGuiApplicationHelper::ColorType::LightType)
+        iconStr.append(PLUGIN_MIN_ICON_NAME);
+
+    return iconStr;
+}
+
+/**
+ * @brief BatteryModel::icon 获取当前状态的电池图标，同一个图标在相同的缩放比例下只绘制一次
+ */
+QPixmap BatteryModel::icon(int themeType, qreal ratio)
+{
+    const QString &iconStr = iconName(themeType);
+    const QString key = QString("%1@%2").arg(iconStr).arg(ratio);
+    auto it = m_icons.constFind(key);
+    if (it != m_icons.constEnd())
+        return it.value();
+
+    const QSize pixmapSize = QCoreApplication::testAttribute(Qt::AA_UseHighDpiPixmaps) ? QSize(ICON_SIZE, ICON_SIZE) : (QSize(ICON_SIZE, ICON_SIZE) * ratio);
+    QPixmap pix = QIcon::fromTheme(iconStr, QIcon::fromTheme(":/batteryicons/resources/batteryicons/" + iconStr + ".svg")).pixmap(pixmapSize);
+    pix.setDevicePixelRatio(ratio);
+
+    m_icons.insert(key, pix);
+    return pix;
+}
+
+void BatteryModel::update(const QVariantMap &properties)
+{
+    const QString oldIconName = iconName(DGuiApplicationHelper::DarkType);
+
+    auto it = properties.constFind("BatteryPercentage");
+    if (it != properties.constEnd()) {
+        const BatteryPercentageMap &data = qdbus_cast<BatteryPercentageMap>(it.value());
+        const bool exist = !data.isEmpty();
+        if (m_exist != exist) {
+            m_exist = exist;
+            Q_EMIT existChanged(m_exist);
+        }
+
+        const double percentage = data.value("Display");
+        if (!qFuzzyCompare(m_percentage + 1, percentage + 1)) {
+            m_percentage = percentage;
+            Q_EMIT percentageChanged(m_percentage);
+        }
+    }
+
+    it = properties.constFind("BatteryState");
+    if (it != properties.constEnd()) {
+        const BatteryState state = static_cast<BatteryState>(qdbus_cast<BatteryStateMap>(it.value()).value("Display"));
+        if (m_state != state) {
+            m_state = state;
+            Q_EMIT stateChanged(m_state);
+        }
+    }
+
+    it = properties.constFind("OnBattery");
+    if (it != properties.constEnd())
+        m_onBattery = it.value().toBool();
+
+    // 电量在同一个区间内变化时图标不变，不需要重新绘制
+    if (iconName(DGuiApplicationHelper::DarkType) != oldIconName)
+        Q_EMIT iconChanged();
+}
+
+void BatteryModel::onPropertiesChanged(const QDBusMessage &message)
+{
+    const QList<QVariant> &arguments = message.arguments();
+    if (arguments.size() != 3)
+        return;
+
+    // UPower只关心是否使用电池供电
+    const QString &interfaceName = arguments.at(0).toString();
+    QVariantMap changedProperties = qdbus_cast<QVariantMap>(arguments.at(1));
+    if (interfaceName == UPOWER_SERVICE) {
+        const QVariant onBattery = changedProperties.value("OnBattery");
+        if (!onBattery.isValid())
+            return;
+
+        changedProperties = { { "OnBattery", onBattery } };
+    } else if (interfaceName != DBusPower::staticInterfaceName()) {
+        return;
+    }
+
+    update(changedProperties);
+}
+
+void BatteryModel::onIconThemeChanged()
+{
+    m_icons.clear();
+    Q_EMIT iconChanged();
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef BATTERYMODEL_H
+#define BATTERYMODEL_H
+
+#include <QObject>
+#include <QHash>
+#include <QPixmap>
+
+class QDBusMessage;
+
+// from https://upower.freedesktop.org/docs/Device.html#Device:State
+enum BatteryState {
+    UNKNOWN = 0,        // 未知
+    CHARGING = 1,       // 充电中
+    DIS_CHARGING = 2,   // 放电
+    NOT_CHARGED = 3,    // 未充
+    FULLY_CHARGED = 4   // 充满
+};
+
+/**
+ * @brief The BatteryModel class
+ * 电池的状态，创建时用一次GetAll获取，之后只根据PropertiesChanged信号中的值更新，读取时不再访问DBus，
+ * 电池图标按照主题和缩放比例缓存，只有图标变化时才重新绘制
+ */
+class BatteryModel : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BatteryModel(QObject *parent = nullptr);
+
+    bool exist() const { return m_exist; }
+    double percentage() const { return m_percentage; }
+    bool onBattery() const { return m_onBattery; }
+    BatteryState state() const { return m_state; }
+
+    QString iconName(int themeType) const;
+    QPixmap icon(int themeType, qreal ratio);
+
+Q_SIGNALS:
+    void existChanged(bool exist) const;
+    void percentageChanged(double percentage) const;
+    void stateChanged(BatteryState state) const;
+    void iconChanged() const;
+
+private:
+    void update(const QVariantMap &properties);
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QDBusMessage &message);
+    void onIconThemeChanged();
+
+private:
+    bool m_exist;
+    double m_percentage;
+    bool m_onBattery;
+    BatteryState m_state;
+
+    QHash<QString, QPixmap> m_icons;
+};
+
+#endif // BATTERYMODEL_H
@@ -29,7 +29,7 @@ PowerPlugin::PowerPlugin(QObject *parent)
     , m_powerStatusWidget(nullptr)
     , m_tipsLabel(new TipsWidget)
     , m_systemPowerInter(nullptr)
-    , m_powerInter(nullptr)
+    , m_batteryModel(nullptr)
     , m_dconfig(new DConfig(QString("org.deepin.dde.dock.power"), QString()))
     , m_preChargeTimer(new QTimer(this))
     , m_quickPanel(nullptr)
@@ -60,9 +60,7 @@ QWidget *PowerPlugin::itemWidget(const QString &itemKey)
 
 QWidget *PowerPlugin::itemTipsWidget(const QString &itemKey)
 {
-    const BatteryPercentageMap data = m_powerInter->batteryPercentage();
-
-    if (data.isEmpty()) {
+    if (!m_batteryModel->exist()) {
         return nullptr;
     }
 
@@ -148,9 +146,7 @@ PluginFlags PowerPlugin::flags() const
 
 void PowerPlugin::updateBatteryVisible()
 {
-    const bool exist = !m_powerInter->batteryPercentage().isEmpty();
-
-    if (exist)
+    if (m_batteryModel->exist())
         m_proxyInter->itemAdded(this, POWER_KEY);
     else
         m_proxyInter->itemRemoved(this, POWER_KEY);
@@ -165,7 +161,8 @@ void PowerPlugin::loadPlugin()
 
     m_pluginLoaded = true;
 
-    m_powerStatusWidget.reset(new PowerStatusWidget);
+    m_batteryModel = new BatteryModel(this);
+    m_powerStatusWidget.reset(new PowerStatusWidget(m_batteryModel));
 
     connect(m_powerStatusWidget.get(), &PowerStatusWidget::iconChanged, this, [ this ] {
         m_proxyInter->updateDockInfo(this, DockPart::QuickPanel);
@@ -173,8 +170,6 @@ void PowerPlugin::loadPlugin()
         m_proxyInter->itemUpdate(this, POWER_KEY);
     });
 
-    m_powerInter = new DBusPower(this);
-
     m_systemPowerInter = new SystemPowerInter("org.deepin.dde.Power1", "/org/deepin/dde/Power1", QDBusConnection::systemBus(), this);
     m_systemPowerInter->setSync(true);
 
@@ -187,7 +182,9 @@ void PowerPlugin::loadPlugin()
     connect(m_systemPowerInter, &SystemPowerInter::BatteryTimeToEmptyChanged, this, &PowerPlugin::refreshTipsData);
     connect(m_systemPowerInter, &SystemPowerInter::BatteryTimeToFullChanged, this, &PowerPlugin::refreshTipsData);
 
-    connect(m_powerInter, &DBusPower::BatteryPercentageChanged, this, &PowerPlugin::updateBatteryVisible);
+    connect(m_batteryModel, &BatteryModel::existChanged, this, &PowerPlugin::updateBatteryVisible);
+    connect(m_batteryModel, &BatteryModel::percentageChanged, this, &PowerPlugin::refreshTipsData);
+    connect(m_batteryModel, &BatteryModel::stateChanged, this, &PowerPlugin::refreshTipsData);
 
     updateBatteryVisible();
 
@@ -208,10 +205,9 @@ void PowerPlugin::onGSettingsChanged(const QString &key)
 
 void PowerPlugin::refreshTipsData()
 {
-    const BatteryPercentageMap data = m_powerInter->batteryPercentage();
-    const uint percentage = qMin(100.0, qMax(0.0, data.value("Display")));
+    const uint percentage = qMin(100.0, qMax(0.0, m_batteryModel->percentage()));
     QString value = QString("%1%").arg(std::round(percentage));
-    const int batteryState = m_powerInter->batteryState()["Display"];
+    const int batteryState = m_batteryModel->state();
     QFontMetrics ftm(m_labelText->font());
     value = ftm.elidedText(value, Qt::TextElideMode::ElideMiddle, m_labelText->width());
     m_labelText->setText(value);
@@ -8,7 +8,7 @@
 
 #include "pluginsiteminterface.h"
 #include "powerstatuswidget.h"
-#include "dbus/dbuspower.h"
+#include "batterymodel.h"
 
 #include "org_deepin_dde_systempower1.h"
 
@@ -65,7 +65,7 @@ private:
     QScopedPointer<Dock::TipsWidget> m_tipsLabel;
 
     SystemPowerInter *m_systemPowerInter;
-    DBusPower *m_powerInter;
+    BatteryModel *m_batteryModel;
     Dtk::Core::DConfig *m_dconfig; // 配置
     QTimer *m_preChargeTimer;
     QWidget *m_quickPanel;
@@ -6,6 +6,8 @@
 #ifndef POWERSTATUSWIDGET_H
 #define POWERSTATUSWIDGET_H
 
+#include "batterymodel.h"
+
 #include <QWidget>
 
 #include <DGuiApplicationHelper>
@@ -14,23 +16,12 @@
 
 DGUI_USE_NAMESPACE
 
-class DBusPower;
-
-// from https://upower.freedesktop.org/docs/Device.html#Device:State
-enum BatteryState {
-    UNKNOWN = 0,        // 未知
-    CHARGING = 1,       // 充电中
-    DIS_CHARGING = 2,   // 放电
-    NOT_CHARGED = 3,    // 未充
-    FULLY_CHARGED = 4   // 充满
-};
-
 class PowerStatusWidget : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit PowerStatusWidget(QWidget *parent = 0);
+    explicit PowerStatusWidget(BatteryModel *model, QWidget *parent = 0);
     QPixmap getBatteryIcon(int themeType);
 
 public Q_SLOTS:
@@ -44,9 +35,12 @@ protected:
     void resizeEvent(QResizeEvent *event);
     void paintEvent(QPaintEvent *e);
 
+private:
+    void updateIcon();
 
 private:
-    DBusPower *m_powerInter;
+    BatteryModel *m_model;
+    QPixmap m_icon;
 };
 
 #endif // POWERSTATUSWIDGET_H
@@ -16,12 +16,18 @@
 #include <QIcon>
 #include <QSettings>
 #include <QPainter>
+#include <QDBusServiceWatcher>
+#include <QtConcurrent>
 
 #define PLUGIN_STATE_KEY "enable"
 #define GSETTING_SHOW_SUSPEND "showSuspend"
 #define GSETTING_SHOW_HIBERNATE "showHibernate"
 #define GSETTING_SHOW_SHUTDOWN "showShutdown"
 #define GSETTING_SHOW_LOCK "showLock"
+#define POWER_MANAGER_SERVICE "org.deepin.dde.PowerManager1"
+#define POWER_MANAGER_PATH "/org/deepin/dde/PowerManager1"
+// 打开菜单时查询结果超过这个时间(毫秒)就在后台重新查询，交换分区等变化没有信号通知
+#define CAPABILITIES_EXPIRE_MSEC (30 * 1000)
 
 DCORE_USE_NAMESPACE
 DGUI_USE_NAMESPACE
@@ -32,12 +38,31 @@ ShutdownPlugin::ShutdownPlugin(QObject *parent)
     , m_pluginLoaded(false)
     , m_shutdownWidget(nullptr)
     , m_tipsLabel(new TipsWidget)
-    , m_powerManagerInter(new DBusPowerManager("org.deepin.dde.PowerManager1", "/org/deepin/dde/PowerManager1", QDBusConnection::systemBus(), this))
     , m_gsettings(Utils::ModuleSettingsPtr("shutdown", QByteArray(), this))
     , m_sessionShellGsettings(Utils::SettingsPtr("com.deepin.dde.session-shell", "/com/deepin/dde/session-shell/", this))
+    , m_gsettingsKeys(m_gsettings ? m_gsettings->keys() : QStringList())
+    , m_sessionShellGsettingsKeys(m_sessionShellGsettings ? m_sessionShellGsettings->keys() : QStringList())
+    , m_capabilitiesWatcher(new QFutureWatcher<PowerCapabilities>(this))
 {
     m_tipsLabel->setVisible(false);
     m_tipsLabel->setAccessibleName("shutdown");
+
+    connect(m_capabilitiesWatcher, &QFutureWatcher<PowerCapabilities>::finished, this, [ this ] {
+        m_capabilities = m_capabilitiesWatcher->result();
+        m_capabilitiesTimer.start();
+    });
+
+    // 电源管理服务重启、用户增删时重新查询
+    QDBusServiceWatcher *serviceWatcher = new QDBusServiceWatcher(POWER_MANAGER_SERVICE, QDBusConnection::systemBus(),
+                                                                  QDBusServiceWatcher::WatchForRegistration, this);
+    connect(serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this, &ShutdownPlugin::refreshCapabilities);
+
+    QDBusConnection::systemBus().connect(POWER_MANAGER_SERVICE, POWER_MANAGER_PATH, DBusPowerManager::staticInterfaceName(), QString(),
+                                         this, SLOT(refreshCapabilities()));
+    QDBusConnection::systemBus().connect(DBusAccount::staticService(), DBusAccount::staticInterfacePath(), DBusAccount::staticInterfaceName(), "UserAdded",
+                                         this, SLOT(refreshCapabilities()));
+    QDBusConnection::systemBus().connect(DBusAccount::staticService(), DBusAccount::staticInterfacePath(), DBusAccount::staticInterfaceName(), "UserDeleted",
+                                         this, SLOT(refreshCapabilities()));
 }
 
 const QString ShutdownPlugin::pluginName() const
@@ -104,11 +129,15 @@ const QString ShutdownPlugin::itemContextMenu(const QString &itemKey)
 {
     Q_UNUSED(itemKey);
 
+    // 使用缓存的结果，过期后在后台重新查询，下次打开菜单时生效
+    if (m_capabilitiesTimer.isValid() && m_capabilitiesTimer.hasExpired(CAPABILITIES_EXPIRE_MSEC))
+        refreshCapabilities();
+
     QList<QVariant> items;
     items.reserve(6);
 
     QMap<QString, QVariant> shutdown;
-    if (!m_gsettings || (m_gsettings->keys().contains(GSETTING_SHOW_SHUTDOWN) && m_gsettings->get(GSETTING_SHOW_SHUTDOWN).toBool())) {
+    if (gsettingsEnabled(GSETTING_SHOW_SHUTDOWN)) {
         shutdown["itemId"] = "Shutdown";
         shutdown["itemText"] = tr("Shut down");
         shutdown["isActive"] = true;
@@ -122,15 +151,10 @@ const QString ShutdownPlugin::itemContextMenu(const QString &itemKey)
     items.push_back(reboot);
 
 #ifndef DISABLE_POWER_OPTIONS
-
-    QProcessEnvironment enviromentVar = QProcessEnvironment::systemEnvironment();
-    bool can_sleep = enviromentVar.contains("POWER_CAN_SLEEP") ? QVariant(enviromentVar.value("POWER_CAN_SLEEP")).toBool()
-                     : valueByQSettings<bool>("Power", "sleep", true) &&
-                     m_powerManagerInter->CanSuspend();
-    ;
-    if (can_sleep) {
+    // 查询结果返回之前先显示，由关机界面做最终的判断
+    if (!m_capabilities.valid || m_capabilities.canSuspend) {
         QMap<QString, QVariant> suspend;
-        if (!m_gsettings || (m_gsettings->keys().contains(GSETTING_SHOW_SUSPEND) && m_gsettings->get(GSETTING_SHOW_SUSPEND).toBool())) {
+        if (gsettingsEnabled(GSETTING_SHOW_SUSPEND)) {
             suspend["itemId"] = "Suspend";
             suspend["itemText"] = tr("Suspend");
             suspend["isActive"] = true;
@@ -138,12 +162,9 @@ const QString ShutdownPlugin::itemContextMenu(const QString &itemKey)
         }
     }
 
-    bool can_hibernate = enviromentVar.contains("POWER_CAN_HIBERNATE") ? QVariant(enviromentVar.value("POWER_CAN_HIBERNATE")).toBool()
-                         : checkSwap() && m_powerManagerInter->CanHibernate();
-
-    if (can_hibernate) {
+    if (!m_capabilities.valid || m_capabilities.canHibernate) {
         QMap<QString, QVariant> hibernate;
-        if (!m_gsettings || (m_gsettings->keys().contains(GSETTING_SHOW_HIBERNATE) && m_gsettings->get(GSETTING_SHOW_HIBERNATE).toBool())) {
+        if (gsettingsEnabled(GSETTING_SHOW_HIBERNATE)) {
             hibernate["itemId"] = "Hibernate";
             hibernate["itemText"] = tr("Hibernate");
             hibernate["isActive"] = true;
@@ -154,7 +175,7 @@ const QString ShutdownPlugin::itemContextMenu(const QString &itemKey)
 #endif
 
     QMap<QString, QVariant> lock;
-    if (!m_gsettings || (m_gsettings->keys().contains(GSETTING_SHOW_LOCK) && m_gsettings->get(GSETTING_SHOW_LOCK).toBool())) {
+    if (gsettingsEnabled(GSETTING_SHOW_LOCK)) {
         lock["itemId"] = "Lock";
         lock["itemText"] = tr("Lock");
         lock["isActive"] = true;
@@ -175,14 +196,14 @@ const QString ShutdownPlugin::itemContextMenu(const QString &itemKey)
             Disabled
         } switchUserConfig = OnDemand;
 
-        if (m_sessionShellGsettings && m_sessionShellGsettings->keys().contains("switchuser")) {
+        if (m_sessionShellGsettings && m_sessionShellGsettingsKeys.contains("switchuser")) {
             switchUserConfig = SwitchUserConfig(m_sessionShellGsettings->get("switchuser").toInt());
         }
 
         // 和登录锁屏界面的逻辑保持一致
         if (AlwaysShow == switchUserConfig ||
                  (OnDemand == switchUserConfig &&
-                 (DBusAccount().userList().count() > 1 || DSysInfo::uosType() == DSysInfo::UosType::UosServer))) {
+                 (!m_capabilities.valid || m_capabilities.userCount > 1 || DSysInfo::uosType() == DSysInfo::UosType::UosServer))) {
             QMap<QString, QVariant> switchUser;
             switchUser["itemId"] = "SwitchUser";
             switchUser["itemText"] = tr("Switch account");
@@ -314,6 +335,8 @@ void ShutdownPlugin::loadPlugin()
 
     m_shutdownWidget.reset(new ShutdownWidget);
 
+    refreshCapabilities();
+
     m_proxyInter->itemAdded(this, pluginName());
     displayModeChanged(displayMode());
 }
@@ -350,9 +373,9 @@ qint64 ShutdownPlugin::get_power_image_size()
     return size;
 }
 
-bool ShutdownPlugin::checkSwap()
+bool ShutdownPlugin::checkSwap(const QStringList &configFiles)
 {
-    if (!valueByQSettings<bool>("Power", "hibernate", true))
+    if (!findValueByQSettings<bool>(configFiles, "Power", "hibernate", true))
         return false;
 
     bool hasSwap = false;
@@ -381,3 +404,41 @@ bool ShutdownPlugin::checkSwap()
 
     return hasSwap;
 }
+
+bool ShutdownPlugin::gsettingsEnabled(const QString &key) const
+{
+    return !m_gsettings || (m_gsettingsKeys.contains(key) && m_gsettings->get(key).toBool());
+}
+
+/**
+ * @brief ShutdownPlugin::queryCapabilities 查询是否可以待机、休眠以及用户个数，在后台线程中执行，
+ * 不访问插件对象，插件析构时不需要等待查询结束
+ */
+PowerCapabilities ShutdownPlugin::queryCapabilities(const QStringList &configFiles)
+{
+    PowerCapabilities capabilities;
+    capabilities.valid = true;
+
+#ifndef DISABLE_POWER_OPTIONS
+    DBusPowerManager powerManagerInter(POWER_MANAGER_SERVICE, POWER_MANAGER_PATH, QDBusConnection::systemBus());
+
+    QProcessEnvironment enviromentVar = QProcessEnvironment::systemEnvironment();
+    capabilities.canSuspend = enviromentVar.contains("POWER_CAN_SLEEP") ? QVariant(enviromentVar.value("POWER_CAN_SLEEP")).toBool()
+                              : findValueByQSettings<bool>(configFiles, "Power", "sleep", true) && powerManagerInter.CanSuspend().value();
+
+    capabilities.canHibernate = enviromentVar.contains("POWER_CAN_HIBERNATE") ? QVariant(enviromentVar.value("POWER_CAN_HIBERNATE")).toBool()
+                                : checkSwap(configFiles) && powerManagerInter.CanHibernate().value();
+#endif
+
+    capabilities.userCount = DBusAccount().userList().count();
+
+    return capabilities;
+}
+
+void ShutdownPlugin::refreshCapabilities()
+{
+    if (m_capabilitiesWatcher->isRunning())
+        return;
+
+    m_capabilitiesWatcher->setFuture(QtConcurrent::run(&ShutdownPlugin::queryCapabilities, session_ui_configs));
+}
@@ -10,13 +10,24 @@
 #include "shutdownwidget.h"
 
 #include <QLabel>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
 
-class DBusPowerManager;
 
 namespace Dock {
 class TipsWidget;
 }
 class QGSettings;
+
+// 右键菜单中需要的系统能力，在后台线程中查询
+struct PowerCapabilities
+{
+    bool valid = false;         // 查询结果还没有返回时为false
+    bool canSuspend = false;
+    bool canHibernate = false;
+    int userCount = 0;
+};
+
 class ShutdownPlugin : public QObject, PluginsItemInterface
 {
     Q_OBJECT
@@ -54,7 +65,7 @@ public:
         "/usr/share/dde-session-ui/dde-session-ui.conf"
     };
     template <typename T>
-    T findValueByQSettings(const QStringList &configFiles,
+    static T findValueByQSettings(const QStringList &configFiles,
                            const QString &group,
                            const QString &key,
                            const QVariant &failback)
@@ -85,21 +96,30 @@ public:
                                        failback);
     }
 
-    std::pair<bool, qint64> checkIsPartitionType(const QStringList &list);
-    qint64 get_power_image_size();
+    static std::pair<bool, qint64> checkIsPartitionType(const QStringList &list);
+    static qint64 get_power_image_size();
+
+private Q_SLOTS:
+    void refreshCapabilities();
 
 private:
     void loadPlugin();
-    bool checkSwap();
+    static bool checkSwap(const QStringList &configFiles);
+    bool gsettingsEnabled(const QString &key) const;
+    static PowerCapabilities queryCapabilities(const QStringList &configFiles);
 
 private:
     bool m_pluginLoaded;
 
     QScopedPointer<ShutdownWidget> m_shutdownWidget;
     QScopedPointer<Dock::TipsWidget> m_tipsLabel;
-    DBusPowerManager* m_powerManagerInter;
     const QGSettings *m_gsettings;
     const QGSettings *m_sessionShellGsettings;
+    QStringList m_gsettingsKeys;
+    QStringList m_sessionShellGsettingsKeys;
+    PowerCapabilities m_capabilities;
+    QFutureWatcher<PowerCapabilities> *m_capabilitiesWatcher;
+    QElapsedTimer m_capabilitiesTimer;      // 上次查询结果返回后经过的时间
 };
 
 #endif // SHUTDOWNPLUGIN_H
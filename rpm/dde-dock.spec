@@ -29,6 +29,7 @@ BuildRequires:  pkgconfig(xcb-composite)
 BuildRequires:  pkgconfig(xcb-ewmh)
 BuildRequires:  pkgconfig(xcb-icccm)
 BuildRequires:  pkgconfig(xcb-image)
+BuildRequires:  pkgconfig(xcb-shm)
 BuildRequires:  qt5-linguist
 BuildRequires:  gtest-devel
 BuildRequires:  gmock-devel
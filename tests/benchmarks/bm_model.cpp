@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "tray_model.h"
+#include "mainpanelcontrol.h"
+#include "dbusutil.h"
+
+#include <QBoxLayout>
+#include <QDBusConnection>
+
+#include <benchmark/benchmark.h>
+
+static WinInfo trayInfo(int index)
+{
+    WinInfo info;
+    // 每10个托盘中有一个输入法，排序时需要移动到最后
+    info.type = (index % 10 == 0) ? TrayIconType::Sni : TrayIconType::XEmbed;
+    info.isTypeWriting = (index % 10 == 0);
+    info.key = QString("benchmark-tray-%1").arg(index);
+    info.itemKey = info.key;
+    info.winId = quint32(index + 1);
+    return info;
+}
+
+static void BM_TrayModel_AddRow(benchmark::State &state)
+{
+    const int count = int(state.range(0));
+    for (auto _ : state) {
+        TrayModel model(false);
+        for (int i = 0; i < count; ++i)
+            model.addRow(trayInfo(i));
+
+        benchmark::DoNotOptimize(model.rowCount());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_TrayModel_AddRow)->RangeMultiplier(2)->Range(50, 400)->Complexity();
+
+static void BM_TrayModel_RemoveRow(benchmark::State &state)
+{
+    const int count = int(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        TrayModel model(false);
+        for (int i = 0; i < count; ++i)
+            model.m_winInfos << trayInfo(i);
+        state.ResumeTiming();
+
+        for (int i = 0; i < count; ++i)
+            model.removeRow(trayInfo(i).itemKey);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_TrayModel_RemoveRow)->RangeMultiplier(2)->Range(50, 400)->Complexity();
+
+static void BM_TrayModel_SortItems(benchmark::State &state)
+{
+    const int count = int(state.range(0));
+    TrayModel model(false);
+    for (int i = 0; i < count; ++i)
+        model.m_winInfos << trayInfo(i);
+
+    for (auto _ : state)
+        model.sortItems();
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_TrayModel_SortItems)->RangeMultiplier(2)->Range(50, 400)->Complexity();
+
+// 使用普通控件模拟应用图标，只测试尺寸计算和布局
+static void BM_MainPanelControl_ResizeDockIcon(benchmark::State &state)
+{
+    const int count = int(state.range(0));
+
+    DockInter dockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus());
+    MainPanelControl panel(&dockInter);
+    panel.setDisplayMode(state.range(1) ? DisplayMode::Fashion : DisplayMode::Efficient);
+    panel.setPositonValue(Position::Bottom);
+    panel.resize(1920, 48);
+
+    for (int i = 0; i < count; ++i)
+        panel.m_appAreaSonLayout->addWidget(new QWidget(panel.m_appAreaSonWidget));
+
+    for (auto _ : state)
+        panel.resizeDockIcon();
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MainPanelControl_ResizeDockIcon)->ArgsProduct({{10, 50, 200}, {0, 1}});
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "themeappicon.h"
+#include "imageutil.h"
+#include "utils.h"
+#include "appitem.h"
+#include "snitrayitemwidget.h"
+#include "dbusutil.h"
+
+#include <QPixmap>
+#include <QDBusConnection>
+
+#include <benchmark/benchmark.h>
+
+// 主题图标查找，reObtain为true时跳过内存缓存
+static void BM_ThemeAppIcon_GetIcon(benchmark::State &state)
+{
+    const bool reObtain = state.range(0);
+    QPixmap pixmap;
+    for (auto _ : state) {
+        ThemeAppIcon::getIcon(pixmap, "dde-file-manager", 48, reObtain);
+        benchmark::DoNotOptimize(pixmap);
+    }
+}
+BENCHMARK(BM_ThemeAppIcon_GetIcon)->Arg(0)->Arg(1);
+
+static void BM_ImageUtil_LoadSvg(benchmark::State &state)
+{
+    const QSize size(state.range(0), state.range(0));
+    for (auto _ : state) {
+        const QPixmap &pixmap = ImageUtil::loadSvg(":/res/dde-calendar.svg", size, 1.25);
+        benchmark::DoNotOptimize(pixmap);
+    }
+}
+BENCHMARK(BM_ImageUtil_LoadSvg)->Arg(16)->Arg(48)->Arg(128);
+
+static void BM_Utils_RenderSVG(benchmark::State &state)
+{
+    const QSize size(state.range(0), state.range(0));
+    for (auto _ : state) {
+        const QPixmap &pixmap = Utils::renderSVG(":/res/dde-calendar.svg", size, 1.25);
+        benchmark::DoNotOptimize(pixmap);
+    }
+}
+BENCHMARK(BM_Utils_RenderSVG)->Arg(16)->Arg(48)->Arg(128);
+
+// SNI图标数据(网络字节序的ARGB32)转换为QPixmap
+static void BM_SNI_NewIconPixmap(benchmark::State &state)
+{
+    const int size = int(state.range(0));
+
+    // 以'/'开头的服务路径无效，控件不会连接DBus，只用于测试图标转换
+    SNITrayItemWidget widget("/benchmark");
+
+    DBusImage image;
+    image.width = size;
+    image.height = size;
+    image.pixels = QByteArray(size * size * 4, char(0x7f));
+    widget.m_sniIconPixmap = DBusImageList() << image;
+
+    for (auto _ : state) {
+        const QPixmap &pixmap = widget.newIconPixmap(SNITrayItemWidget::Icon);
+        benchmark::DoNotOptimize(pixmap);
+    }
+    state.SetBytesProcessed(state.iterations() * image.pixels.size());
+}
+BENCHMARK(BM_SNI_NewIconPixmap)->Arg(22)->Arg(64)->Arg(256);
+
+// 通过offscreen平台绘制应用图标(AppItem::paintEvent)，不连接任务栏后端
+static void BM_AppItem_PaintEvent(benchmark::State &state)
+{
+    const QGSettings *appSettings = Utils::ModuleSettingsPtr("app");
+    const QGSettings *activeSettings = Utils::ModuleSettingsPtr("activeapp");
+    const QGSettings *dockedSettings = Utils::ModuleSettingsPtr("dockapp");
+
+    DockInter dockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus());
+    AppItem *appItem = new AppItem(&dockInter, appSettings, activeSettings, dockedSettings, QDBusObjectPath("/org/deepin/dde/daemon/Dock1/entries/benchmark"));
+
+    WindowInfoMap windowInfos;
+    windowInfos.insert(1, WindowInfo());
+    windowInfos.insert(2, WindowInfo());
+    appItem->updateWindowInfos(windowInfos);
+
+    DockItem::setDockDisplayMode(state.range(0) ? DisplayMode::Fashion : DisplayMode::Efficient);
+    appItem->setDockInfo(Dock::Position::Bottom, QRect(0, 0, 1920, 40));
+    appItem->resize(48, 48);
+
+    // 通过render把绘制事件派发到离屏的pixmap上，和真实的绘制流程一致
+    QPixmap target(appItem->size());
+    for (auto _ : state) {
+        target.fill(Qt::transparent);
+        appItem->render(&target);
+    }
+
+    delete appItem;
+    delete appSettings;
+    delete activeSettings;
+    delete dockedSettings;
+}
+BENCHMARK(BM_AppItem_PaintEvent)->Arg(0)->Arg(1);
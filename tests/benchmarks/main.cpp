@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dockapplication.h"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char **argv)
+{
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    DockApplication app(argc, argv);
+    // 设置应用名为dde-dock，否则dconfig相关的配置就读不到了
+    app.setApplicationName("dde-dock");
+
+    qApp->setProperty("CANSHOW", true);
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dockpropertystore.h"
+#include "dbusutil.h"
+
+#include <QDBusMessage>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Ut_DockPropertyStore : public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        // 测试环境中没有后端，标记为已经获取过
+        m_loaded = DockPropertyStore::instance()->m_loaded;
+        m_properties = DockPropertyStore::instance()->m_properties;
+        DockPropertyStore::instance()->m_loaded = true;
+    }
+
+    virtual void TearDown() override
+    {
+        DockPropertyStore::instance()->m_loaded = m_loaded;
+        DockPropertyStore::instance()->m_properties = m_properties;
+    }
+
+private:
+    bool m_loaded;
+    QVariantMap m_properties;
+};
+
+TEST_F(Ut_DockPropertyStore, update_test)
+{
+    DockPropertyStore *store = DockPropertyStore::instance();
+    QSignalSpy spy(store, &DockPropertyStore::propertyChanged);
+
+    store->update({ { "IconSize", 36u }, { "Position", 2 } });
+    EXPECT_EQ(spy.count(), 2);
+    EXPECT_EQ(store->value("IconSize").toUInt(), 36u);
+
+    // 值没有变化时不通知
+    store->update({ { "IconSize", 36u } });
+    EXPECT_EQ(spy.count(), 2);
+
+    store->update({ { "IconSize", 48u } });
+    ASSERT_EQ(spy.count(), 3);
+    EXPECT_EQ(spy.last().at(0).toString(), QString("IconSize"));
+    EXPECT_EQ(spy.last().at(1).toUInt(), 48u);
+}
+
+TEST_F(Ut_DockPropertyStore, propertiesChanged_test)
+{
+    DockPropertyStore *store = DockPropertyStore::instance();
+    QSignalSpy spy(store, &DockPropertyStore::propertyChanged);
+
+    QVariantMap changedProperties;
+    changedProperties["HideMode"] = 1;
+
+    // 其他接口的属性变化不处理
+    QDBusMessage message = QDBusMessage::createSignal(dockServicePath(), "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << QString("org.deepin.dde.daemon.Dock1.Entry") << changedProperties << QStringList();
+    store->onPropertiesChanged(message);
+    EXPECT_EQ(spy.count(), 0);
+
+    message = QDBusMessage::createSignal(dockServicePath(), "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << dockServiceName() << changedProperties << QStringList();
+    store->onPropertiesChanged(message);
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_EQ(store->value("HideMode").toInt(), 1);
+}
+
+TEST_F(Ut_DockPropertyStore, loadFailed_test)
+{
+    DockPropertyStore *store = DockPropertyStore::instance();
+    store->m_loaded = false;
+    store->m_properties = { { "IconSize", 36u } };
+
+    // 测试环境中没有后端，获取失败后继续使用当前的值
+    store->load();
+    ASSERT_TRUE(store->m_loadWatcher);
+    QTRY_VERIFY(!store->m_loadWatcher);
+    EXPECT_FALSE(store->m_loaded);
+    EXPECT_EQ(store->value("IconSize").toUInt(), 36u);
+
+    // 读取属性时不会再访问后端
+    EXPECT_FALSE(store->value("Position").isValid());
+    EXPECT_FALSE(store->m_loadWatcher);
+}
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "entrypropertycache.h"
+#include "entryinterface.h"
+#include "dbusutil.h"
+
+#include <QDBusMessage>
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+#define ENTRY_PATH "/org/deepin/dde/daemon/Dock1/entries/ut_entry"
+
+class Ut_EntryPropertyCache : public ::testing::Test
+{
+public:
+    virtual void TearDown() override
+    {
+        EntryPropertyCache::instance()->m_properties.remove(ENTRY_PATH);
+        EntryPropertyCache::instance()->m_entries.remove(ENTRY_PATH);
+        EntryPropertyCache::instance()->m_prefetched.clear();
+    }
+};
+
+TEST_F(Ut_EntryPropertyCache, acquire_test)
+{
+    EntryPropertyCache *cache = EntryPropertyCache::instance();
+
+    QVariantMap properties;
+    properties["Name"] = "ut_entry";
+    cache->m_properties.insert(ENTRY_PATH, properties);
+
+    // 已经缓存的属性直接返回
+    Dock_Entry *entry1 = new Dock_Entry(dockServiceName(), ENTRY_PATH, QDBusConnection::sessionBus());
+    Dock_Entry *entry2 = new Dock_Entry(dockServiceName(), ENTRY_PATH, QDBusConnection::sessionBus());
+    EXPECT_EQ(entry1->name(), QString("ut_entry"));
+    EXPECT_EQ(cache->m_entries.count(ENTRY_PATH), 2);
+
+    delete entry1;
+    EXPECT_TRUE(cache->m_properties.contains(ENTRY_PATH));
+
+    delete entry2;
+    EXPECT_FALSE(cache->m_properties.contains(ENTRY_PATH));
+    EXPECT_FALSE(cache->m_entries.contains(ENTRY_PATH));
+}
+
+TEST_F(Ut_EntryPropertyCache, propertiesChanged_test)
+{
+    EntryPropertyCache *cache = EntryPropertyCache::instance();
+
+    QVariantMap changedProperties;
+    changedProperties["IsActive"] = true;
+
+    QDBusMessage message = QDBusMessage::createSignal(ENTRY_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << QString(Dock_Entry::staticInterfaceName()) << changedProperties << QStringList();
+
+    // 没有使用的应用不缓存
+    cache->onPropertiesChanged(message);
+    EXPECT_FALSE(cache->m_properties.contains(ENTRY_PATH));
+
+    cache->m_properties.insert(ENTRY_PATH, QVariantMap { { "IsActive", false }, { "Name", "ut_entry" } });
+    cache->onPropertiesChanged(message);
+    EXPECT_TRUE(cache->m_properties[ENTRY_PATH].value("IsActive").toBool());
+    EXPECT_EQ(cache->m_properties[ENTRY_PATH].value("Name").toString(), QString("ut_entry"));
+
+    // 属性变化直接分发给对应路径的Dock_Entry
+    Dock_Entry entry(dockServiceName(), ENTRY_PATH, QDBusConnection::sessionBus());
+    QSignalSpy activeSpy(&entry, &Dock_Entry::IsActiveChanged);
+    QDBusMessage inactiveMessage = QDBusMessage::createSignal(ENTRY_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    inactiveMessage << QString(Dock_Entry::staticInterfaceName()) << QVariantMap { { "IsActive", false } } << QStringList();
+    cache->onPropertiesChanged(inactiveMessage);
+    ASSERT_EQ(activeSpy.count(), 1);
+    EXPECT_FALSE(entry.isActive());
+
+    // 其他接口的属性变化不处理
+    QDBusMessage otherMessage = QDBusMessage::createSignal(ENTRY_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    otherMessage << QString("org.deepin.dde.daemon.Dock1") << changedProperties << QStringList();
+    cache->onPropertiesChanged(otherMessage);
+    EXPECT_EQ(activeSpy.count(), 1);
+    EXPECT_FALSE(cache->m_properties[ENTRY_PATH].value("IsActive").toBool());
+}
+
+TEST_F(Ut_EntryPropertyCache, invalidatedProperties_test)
+{
+    EntryPropertyCache *cache = EntryPropertyCache::instance();
+    cache->m_properties.insert(ENTRY_PATH, QVariantMap { { "Icon", "ut_icon" }, { "Name", "ut_entry" } });
+
+    // 失效的属性从缓存中删除
+    QDBusMessage message = QDBusMessage::createSignal(ENTRY_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << QString(Dock_Entry::staticInterfaceName()) << QVariantMap() << QStringList { "Icon" };
+    cache->onPropertiesChanged(message);
+
+    EXPECT_FALSE(cache->m_properties[ENTRY_PATH].contains("Icon"));
+    EXPECT_EQ(cache->m_properties[ENTRY_PATH].value("Name").toString(), QString("ut_entry"));
+}
+
+TEST_F(Ut_EntryPropertyCache, evictUnused_test)
+{
+    EntryPropertyCache *cache = EntryPropertyCache::instance();
+    cache->m_properties.insert(ENTRY_PATH, QVariantMap { { "Name", "ut_entry" } });
+    cache->m_prefetched.insert(ENTRY_PATH);
+
+    // 被使用的预先获取结果不删除
+    Dock_Entry *entry = new Dock_Entry(dockServiceName(), ENTRY_PATH, QDBusConnection::sessionBus());
+    EXPECT_FALSE(cache->m_prefetched.contains(ENTRY_PATH));
+    cache->evictUnused();
+    EXPECT_TRUE(cache->m_properties.contains(ENTRY_PATH));
+    delete entry;
+
+    // 没有被使用的预先获取结果在应用移除时删除
+    cache->m_properties.insert(ENTRY_PATH, QVariantMap { { "Name", "ut_entry" } });
+    cache->m_prefetched.insert(ENTRY_PATH);
+    cache->evictUnused();
+    EXPECT_FALSE(cache->m_properties.contains(ENTRY_PATH));
+    EXPECT_TRUE(cache->m_prefetched.isEmpty());
+}
+
+TEST_F(Ut_EntryPropertyCache, acquireFailed_test)
+{
+    EntryPropertyCache *cache = EntryPropertyCache::instance();
+
+    // 获取属性失败时也缓存，之后的属性变化仍然可以更新
+    Dock_Entry entry(dockServiceName(), ENTRY_PATH, QDBusConnection::sessionBus());
+    ASSERT_TRUE(cache->m_properties.contains(ENTRY_PATH));
+
+    QSignalSpy nameSpy(&entry, &Dock_Entry::NameChanged);
+    QDBusMessage message = QDBusMessage::createSignal(ENTRY_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << QString(Dock_Entry::staticInterfaceName()) << QVariantMap { { "Name", "ut_entry" } } << QStringList();
+    cache->onPropertiesChanged(message);
+
+    ASSERT_EQ(nameSpy.count(), 1);
+    EXPECT_EQ(entry.name(), QString("ut_entry"));
+}
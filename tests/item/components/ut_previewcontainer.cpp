@@ -28,15 +28,12 @@ TEST_F(Test_PreviewContainer, coverage_test)
     map.insert(2, info);
     map.insert(3, info);
 
-    WId id(1000);
-    AppSnapshot *snap = new AppSnapshot(id);
-    container->m_snapshots.insert(id, snap);
-    snap->requestCloseAppSnapshot();
     container->setWindowInfos(map, QList<quint32> () << 1 << 2 << 3 << 4);
+    ASSERT_EQ(container->m_snapshots.size(), map.size());
 
-    for (const WId snapId: map.keys()) {
-        container->appendSnapWidget(snapId);
-    }
+    WId id(1);
+    AppSnapshot *snap = container->m_snapshots.value(id);
+    snap->requestCloseAppSnapshot();
 
     container->previewEntered(id);
     container->m_waitForShowPreviewTimer->start();
@@ -65,7 +62,6 @@ TEST_F(Test_PreviewContainer, coverage_test)
     container->adjustSize(true);
     container->adjustSize(false);
 
-    delete snap;
     delete container;
     ASSERT_TRUE(true);
 }
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "snapshotpool.h"
+#include "appsnapshot.h"
+#include "previewcontainer.h"
+
+#include <gtest/gtest.h>
+
+class Test_SnapshotPool : public ::testing::Test
+{};
+
+TEST_F(Test_SnapshotPool, reuse_test)
+{
+    SnapshotPool *pool = SnapshotPool::instance();
+    pool->reserve(2);
+
+    AppSnapshot *snap1 = pool->acquire(1001);
+    AppSnapshot *snap2 = pool->acquire(1002);
+    ASSERT_NE(snap1, snap2);
+    EXPECT_EQ(snap1->wid(), WId(1001));
+
+    pool->release(snap1);
+    pool->release(snap2);
+
+    // 优先复用绑定过同一个窗口的预览图
+    EXPECT_EQ(pool->acquire(1001), snap1);
+
+    // 没有绑定过的窗口复用空闲的预览图
+    AppSnapshot *snap3 = pool->acquire(1003);
+    EXPECT_EQ(snap3, snap2);
+    EXPECT_EQ(snap3->wid(), WId(1003));
+
+    pool->release(snap1);
+    pool->release(snap3);
+}
+
+TEST_F(Test_SnapshotPool, container_test)
+{
+    WindowInfoMap infos;
+    WindowInfo info;
+    info.attention = false;
+    info.title = "test";
+    infos.insert(2001, info);
+    infos.insert(2002, info);
+
+    PreviewContainer *container = new PreviewContainer;
+    container->setWindowInfos(infos, WindowList());
+    AppSnapshot *snap = container->m_snapshots.value(2001);
+    ASSERT_TRUE(snap);
+
+    // 预览窗口关闭后预览图回收，下次预览同一个窗口时复用
+    delete container;
+    EXPECT_EQ(snap->parentWidget(), nullptr);
+
+    container = new PreviewContainer;
+    container->setWindowInfos(infos, WindowList());
+    EXPECT_EQ(container->m_snapshots.value(2001), snap);
+
+    infos.remove(2001);
+    container->setWindowInfos(infos, WindowList());
+    EXPECT_FALSE(container->m_snapshots.contains(2001));
+
+    delete container;
+}
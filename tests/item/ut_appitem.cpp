@@ -6,11 +6,13 @@
 #include <QObject>
 #include <QThread>
 #include <QTest>
+#include <QDBusConnection>
 
 #include <gtest/gtest.h>
 
 #include "utils.h"
 #include "appitem.h"
+#include "dbusutil.h"
 
 using namespace ::testing;
 
@@ -21,6 +23,7 @@ public:
     virtual void TearDown() override;
 
     AppItem *appItem;
+    DockInter *dockInter;
     const QGSettings *appSettings;
     const QGSettings *activeSettings;
     const QGSettings *dockedSettings;
@@ -32,12 +35,14 @@ void Test_AppItem::SetUp()
     activeSettings = Utils::ModuleSettingsPtr("activeapp");
     dockedSettings = Utils::ModuleSettingsPtr("dockapp");
 
-    appItem = new AppItem(appSettings, activeSettings, dockedSettings, QDBusObjectPath("/org/deepin/dde/daemon/Dock1/entries/e0T6045b766"));
+    dockInter = new DockInter(dockServiceName(), dockServicePath(), QDBusConnection::sessionBus());
+    appItem = new AppItem(dockInter, appSettings, activeSettings, dockedSettings, QDBusObjectPath("/org/deepin/dde/daemon/Dock1/entries/e0T6045b766"));
 }
 
 void Test_AppItem::TearDown()
 {
     delete appItem;
+    delete dockInter;
     delete appSettings;
     delete activeSettings;
     delete dockedSettings;
@@ -80,8 +85,7 @@ TEST_F(Test_AppItem, paintEvent)
 TEST_F(Test_AppItem, coverage_test)
 {
     // 触发信号测试
-    appItem->m_refershIconTimer->start(10);
-    QTest::qWait(20);
+    appItem->onRefreshIcon();
 
     appItem->undock();
     appItem->appIcon();
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "fakedockdaemon.h"
+#include "dbusutil.h"
+
+#include <QDBusMessage>
+#include <QDebug>
+
+#define ENTRY_INTERFACE "org.deepin.dde.daemon.Dock1.Entry"
+
+void emitPropertiesChanged(const QDBusConnection &connection, const QString &path, const QString &interface, const QVariantMap &changedProperties)
+{
+    QDBusMessage message = QDBusMessage::createSignal(path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << interface << changedProperties << QStringList();
+    connection.send(message);
+}
+
+FakeEntry::FakeEntry(const QDBusConnection &connection, const QString &path, const QString &id, QObject *parent)
+    : QObject(parent)
+    , m_connection(connection)
+    , m_path(path)
+    , m_id(id)
+    , m_currentWindow(0)
+{
+}
+
+QString FakeEntry::desktopFile() const
+{
+    return QString("/usr/share/applications/%1.desktop").arg(m_id);
+}
+
+void FakeEntry::openWindow(quint32 winId)
+{
+    WindowInfo info;
+    info.attention = false;
+    info.title = QString("%1 - %2").arg(m_id).arg(winId);
+    info.uuid = QString();
+
+    m_windowInfos.insert(winId, info);
+    m_windowOrder << winId;
+    m_currentWindow = winId;
+
+    notifyWindowsChanged();
+}
+
+void FakeEntry::closeWindow()
+{
+    if (m_windowOrder.isEmpty())
+        return;
+
+    m_windowInfos.remove(m_windowOrder.takeLast());
+    m_currentWindow = m_windowOrder.isEmpty() ? 0 : m_windowOrder.last();
+
+    notifyWindowsChanged();
+}
+
+void FakeEntry::notifyWindowsChanged()
+{
+    // 和后端一样，窗口列表和当前窗口在同一个信号中通知
+    QVariantMap changedProperties;
+    changedProperties["WindowInfos"] = QVariant::fromValue(m_windowInfos);
+    changedProperties["CurrentWindow"] = m_currentWindow;
+    emitPropertiesChanged(m_connection, m_path, ENTRY_INTERFACE, changedProperties);
+}
+
+FakeDockDaemon::FakeDockDaemon(const QDBusConnection &connection, QObject *parent)
+    : QObject(parent)
+    , m_connection(connection)
+    , m_displayMode(0)
+    , m_hideMode(0)
+    , m_hideTimeout(0)
+    , m_iconSize(36)
+    , m_opacity(0.4)
+    , m_position(2)
+    , m_showTimeout(0)
+    , m_windowSizeEfficient(40)
+    , m_windowSizeFashion(48)
+{
+}
+
+QStringList FakeDockDaemon::dockedApps() const
+{
+    QStringList desktopFiles;
+    for (FakeEntry *entry : m_entries)
+        desktopFiles << entry->desktopFile();
+
+    return desktopFiles;
+}
+
+QList<QDBusObjectPath> FakeDockDaemon::entries() const
+{
+    QList<QDBusObjectPath> paths;
+    for (FakeEntry *entry : m_entries)
+        paths << QDBusObjectPath(entry->path());
+
+    return paths;
+}
+
+QStringList FakeDockDaemon::GetEntryIDs()
+{
+    QStringList ids;
+    for (FakeEntry *entry : m_entries)
+        ids << entry->id();
+
+    return ids;
+}
+
+FakeEntry *FakeDockDaemon::entry(const QString &id) const
+{
+    for (FakeEntry *entry : m_entries) {
+        if (entry->id() == id)
+            return entry;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief FakeDockDaemon::addEntry 注册应用对应的Entry对象，然后发送EntryAdded信号
+ * @return 应用已经存在或者注册失败时返回false
+ */
+bool FakeDockDaemon::addEntry(const QString &id)
+{
+    if (entry(id))
+        return false;
+
+    const QString path = QString("%1/entries/%2").arg(dockServicePath()).arg(id);
+    FakeEntry *fakeEntry = new FakeEntry(m_connection, path, id, this);
+    if (!m_connection.registerObject(path, fakeEntry, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties)) {
+        qWarning() << "register entry failed:" << path << m_connection.lastError().message();
+        delete fakeEntry;
+        return false;
+    }
+
+    m_entries << fakeEntry;
+
+    Q_EMIT EntryAdded(QDBusObjectPath(path), m_entries.size() - 1);
+
+    QVariantMap changedProperties;
+    changedProperties["Entries"] = QVariant::fromValue(entries());
+    emitPropertiesChanged(m_connection, dockServicePath(), dockServiceName(), changedProperties);
+
+    return true;
+}
+
+bool FakeDockDaemon::removeEntry(const QString &id)
+{
+    FakeEntry *fakeEntry = entry(id);
+    if (!fakeEntry)
+        return false;
+
+    m_entries.removeOne(fakeEntry);
+
+    Q_EMIT EntryRemoved(id);
+
+    QVariantMap changedProperties;
+    changedProperties["Entries"] = QVariant::fromValue(entries());
+    emitPropertiesChanged(m_connection, dockServicePath(), dockServiceName(), changedProperties);
+
+    // 注销后可能还有正在处理的属性读取，对象延迟释放
+    m_connection.unregisterObject(fakeEntry->path(), QDBusConnection::UnregisterNode);
+    fakeEntry->deleteLater();
+
+    return true;
+}
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef FAKEDOCKDAEMON_H
+#define FAKEDOCKDAEMON_H
+
+#include "types/dockrect.h"
+#include "entryinterface.h"
+
+#include <QObject>
+#include <QDBusConnection>
+#include <QDBusObjectPath>
+
+/**
+ * @brief The FakeEntry class
+ * 模拟org.deepin.dde.daemon.Dock1.Entry，属性变化时和后端一样发送PropertiesChanged信号
+ */
+class FakeEntry : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.dde.daemon.Dock1.Entry")
+
+    Q_PROPERTY(uint CurrentWindow READ currentWindow)
+    Q_PROPERTY(QString DesktopFile READ desktopFile)
+    Q_PROPERTY(QString Icon READ icon)
+    Q_PROPERTY(QString Id READ id)
+    Q_PROPERTY(bool IsActive READ isActive)
+    Q_PROPERTY(bool IsDocked READ isDocked)
+    Q_PROPERTY(QString Menu READ menu)
+    Q_PROPERTY(QString Name READ name)
+    Q_PROPERTY(WindowInfoMap WindowInfos READ windowInfos)
+    Q_PROPERTY(int Mode READ mode)
+
+public:
+    FakeEntry(const QDBusConnection &connection, const QString &path, const QString &id, QObject *parent = nullptr);
+
+    QString path() const { return m_path; }
+
+    uint currentWindow() const { return m_currentWindow; }
+    QString desktopFile() const;
+    QString icon() const { return QString("application-x-executable"); }
+    QString id() const { return m_id; }
+    bool isActive() const { return false; }
+    bool isDocked() const { return true; }
+    QString menu() const { return QString(); }
+    QString name() const { return m_id; }
+    WindowInfoMap windowInfos() const { return m_windowInfos; }
+    int mode() const { return 0; }
+
+    int windowCount() const { return m_windowInfos.size(); }
+    void openWindow(quint32 winId);
+    void closeWindow();
+
+public Q_SLOTS:
+    void Activate(uint) {}
+    void Check() {}
+    void ForceQuit() {}
+    void ActiveWindow(uint) {}
+    QList<quint32> GetAllowedCloseWindows() { return m_windowInfos.keys(); }
+    void HandleDragDrop(uint, const QStringList &) {}
+    void HandleMenuItem(uint, const QString &) {}
+    void NewInstance(uint) {}
+    void PresentWindows() {}
+    void RequestDock() {}
+    void RequestUndock() {}
+
+private:
+    void notifyWindowsChanged();
+
+private:
+    QDBusConnection m_connection;
+    QString m_path;
+    QString m_id;
+    uint m_currentWindow;
+    WindowInfoMap m_windowInfos;
+    QList<quint32> m_windowOrder;       // 打开窗口的先后顺序，关闭时先关闭最后打开的窗口
+};
+
+/**
+ * @brief The FakeDockDaemon class
+ * 模拟后端的org.deepin.dde.daemon.Dock1服务，任务栏读取的配置属性返回固定的默认值，
+ * 应用的增加和删除由回放程序控制
+ */
+class FakeDockDaemon : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.dde.daemon.Dock1")
+
+    Q_PROPERTY(int DisplayMode READ displayMode WRITE setDisplayMode)
+    Q_PROPERTY(QStringList DockedApps READ dockedApps)
+    Q_PROPERTY(QList<QDBusObjectPath> Entries READ entries)
+    Q_PROPERTY(DockRect FrontendWindowRect READ frontendWindowRect)
+    Q_PROPERTY(int HideMode READ hideMode WRITE setHideMode)
+    Q_PROPERTY(int HideState READ hideState)
+    Q_PROPERTY(uint HideTimeout READ hideTimeout WRITE setHideTimeout)
+    Q_PROPERTY(uint IconSize READ iconSize WRITE setIconSize)
+    Q_PROPERTY(double Opacity READ opacity WRITE setOpacity)
+    Q_PROPERTY(int Position READ position WRITE setPosition)
+    Q_PROPERTY(uint ShowTimeout READ showTimeout WRITE setShowTimeout)
+    Q_PROPERTY(uint WindowSize READ windowSize WRITE setWindowSize)
+    Q_PROPERTY(uint WindowSizeEfficient READ windowSizeEfficient WRITE setWindowSizeEfficient)
+    Q_PROPERTY(uint WindowSizeFashion READ windowSizeFashion WRITE setWindowSizeFashion)
+    Q_PROPERTY(bool ShowRecent READ showRecent)
+    Q_PROPERTY(bool ShowMultiWindow READ showMultiWindow)
+
+public:
+    explicit FakeDockDaemon(const QDBusConnection &connection, QObject *parent = nullptr);
+
+    int displayMode() const { return m_displayMode; }
+    void setDisplayMode(int value) { m_displayMode = value; }
+    QStringList dockedApps() const;
+    QList<QDBusObjectPath> entries() const;
+    DockRect frontendWindowRect() const { return DockRect(); }
+    int hideMode() const { return m_hideMode; }
+    void setHideMode(int value) { m_hideMode = value; }
+    int hideState() const { return 1; }
+    uint hideTimeout() const { return m_hideTimeout; }
+    void setHideTimeout(uint value) { m_hideTimeout = value; }
+    uint iconSize() const { return m_iconSize; }
+    void setIconSize(uint value) { m_iconSize = value; }
+    double opacity() const { return m_opacity; }
+    void setOpacity(double value) { m_opacity = value; }
+    int position() const { return m_position; }
+    void setPosition(int value) { m_position = value; }
+    uint showTimeout() const { return m_showTimeout; }
+    void setShowTimeout(uint value) { m_showTimeout = value; }
+    uint windowSize() const { return m_windowSizeFashion; }
+    void setWindowSize(uint value) { m_windowSizeFashion = value; }
+    uint windowSizeEfficient() const { return m_windowSizeEfficient; }
+    void setWindowSizeEfficient(uint value) { m_windowSizeEfficient = value; }
+    uint windowSizeFashion() const { return m_windowSizeFashion; }
+    void setWindowSizeFashion(uint value) { m_windowSizeFashion = value; }
+    bool showRecent() const { return false; }
+    bool showMultiWindow() const { return false; }
+
+    bool addEntry(const QString &id);
+    bool removeEntry(const QString &id);
+    FakeEntry *entry(const QString &id) const;
+
+public Q_SLOTS:
+    void ActivateWindow(uint) {}
+    void PreviewWindow(uint) {}
+    void CancelPreviewWindow() {}
+    void MinimizeWindow(uint) {}
+    void CloseWindow(uint) {}
+    QStringList GetDockedAppsDesktopFiles() { return dockedApps(); }
+    QStringList GetEntryIDs();
+    QString GetPluginSettings() { return QString("{}"); }
+    bool IsDocked(const QString &desktopFile) { return dockedApps().contains(desktopFile); }
+    bool IsOnDock(const QString &desktopFile) { return dockedApps().contains(desktopFile); }
+    void MergePluginSettings(const QString &) {}
+    void MoveEntry(int, int) {}
+    QString QueryWindowIdentifyMethod(uint) { return QString(); }
+    void RemovePluginSettings(const QString &, const QStringList &) {}
+    bool RequestDock(const QString &, int) { return false; }
+    bool RequestUndock(const QString &) { return false; }
+    void SetFrontendWindowRect(int, int, uint, uint) {}
+    void SetPluginSettings(const QString &) {}
+
+Q_SIGNALS:
+    void DockAppSettingsSynced();
+    void EntryAdded(const QDBusObjectPath &path, int index);
+    void EntryRemoved(const QString &id);
+    void PluginSettingsSynced();
+    void ServiceRestarted();
+
+private:
+    QDBusConnection m_connection;
+    QList<FakeEntry *> m_entries;
+
+    int m_displayMode;
+    int m_hideMode;
+    uint m_hideTimeout;
+    uint m_iconSize;
+    double m_opacity;
+    int m_position;
+    uint m_showTimeout;
+    uint m_windowSizeEfficient;
+    uint m_windowSizeFashion;
+};
+
+void emitPropertiesChanged(const QDBusConnection &connection, const QString &path, const QString &interface, const QVariantMap &changedProperties);
+
+#endif // FAKEDOCKDAEMON_H
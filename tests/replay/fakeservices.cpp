@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "fakeservices.h"
+#include "fakedockdaemon.h"
+#include "faketrayservices.h"
+#include "dbusutil.h"
+#include "spantracer.h"
+
+#include <QDebug>
+
+#define SERVICES_CONNECTION_NAME "dde-dock-replay-services"
+#define TRAY_MANAGER_SERVICE "org.deepin.dde.TrayManager1"
+#define TRAY_MANAGER_PATH "/org/deepin/dde/TrayManager1"
+#define SNI_WATCHER_SERVICE "org.kde.StatusNotifierWatcher"
+#define SNI_WATCHER_PATH "/StatusNotifierWatcher"
+// 窗口ID的起始值，只用于区分不同的窗口
+#define WINDOW_ID_BASE 0x4000000
+
+FakeServices::FakeServices(QObject *parent)
+    : QObject(parent)
+    , m_connection(QString())
+    , m_dockDaemon(nullptr)
+    , m_trayManager(nullptr)
+    , m_sniWatcher(nullptr)
+    , m_nextWindowId(WINDOW_ID_BASE)
+{
+}
+
+FakeServices::~FakeServices()
+{
+}
+
+QString FakeServices::entryId(int index)
+{
+    // 应用ID会作为DBus路径的一部分，只能使用字母、数字和下划线
+    return QString("replay_app_%1").arg(index);
+}
+
+QString FakeServices::sniServicePath(int index) const
+{
+    return QString("%1/StatusNotifierItem/%2").arg(m_uniqueName).arg(index);
+}
+
+bool FakeServices::start(const QString &address)
+{
+    m_connection = QDBusConnection::connectToBus(address, SERVICES_CONNECTION_NAME);
+    if (!m_connection.isConnected()) {
+        qWarning() << "connect to private bus failed:" << m_connection.lastError().message();
+        return false;
+    }
+
+    m_uniqueName = m_connection.baseService();
+    m_dockDaemon = new FakeDockDaemon(m_connection, this);
+    m_trayManager = new FakeTrayManager(this);
+    m_sniWatcher = new FakeStatusNotifierWatcher(this);
+
+    const QDBusConnection::RegisterOptions options = QDBusConnection::ExportAllSlots
+            | QDBusConnection::ExportAllSignals | QDBusConnection::ExportAllProperties;
+
+    bool ret = m_connection.registerObject(dockServicePath(), m_dockDaemon, options)
+            && m_connection.registerObject(TRAY_MANAGER_PATH, m_trayManager, options)
+            && m_connection.registerObject(SNI_WATCHER_PATH, m_sniWatcher, options)
+            && m_connection.registerService(dockServiceName())
+            && m_connection.registerService(TRAY_MANAGER_SERVICE)
+            && m_connection.registerService(SNI_WATCHER_SERVICE);
+
+    if (!ret)
+        qWarning() << "register fake services failed:" << m_connection.lastError().message();
+
+    return ret;
+}
+
+void FakeServices::stop()
+{
+    if (!m_connection.isConnected())
+        return;
+
+    m_connection.unregisterService(dockServiceName());
+    m_connection.unregisterService(TRAY_MANAGER_SERVICE);
+    m_connection.unregisterService(SNI_WATCHER_SERVICE);
+    QDBusConnection::disconnectFromBus(SERVICES_CONNECTION_NAME);
+}
+
+qint64 FakeServices::addEntry(int index)
+{
+    const qint64 beginNs = Utils::monotonicNs();
+    return m_dockDaemon->addEntry(entryId(index)) ? beginNs : -1;
+}
+
+qint64 FakeServices::removeEntry(int index)
+{
+    const qint64 beginNs = Utils::monotonicNs();
+    return m_dockDaemon->removeEntry(entryId(index)) ? beginNs : -1;
+}
+
+qint64 FakeServices::openWindow(int index)
+{
+    FakeEntry *entry = m_dockDaemon->entry(entryId(index));
+    if (!entry)
+        return -1;
+
+    const qint64 beginNs = Utils::monotonicNs();
+    entry->openWindow(m_nextWindowId++);
+    return beginNs;
+}
+
+qint64 FakeServices::closeWindow(int index)
+{
+    FakeEntry *entry = m_dockDaemon->entry(entryId(index));
+    if (!entry || entry->windowCount() == 0)
+        return -1;
+
+    const qint64 beginNs = Utils::monotonicNs();
+    entry->closeWindow();
+    return beginNs;
+}
+
+qint64 FakeServices::registerSni(int index)
+{
+    if (m_sniItems.contains(index))
+        return -1;
+
+    const QString path = QString("/StatusNotifierItem/%1").arg(index);
+    FakeStatusNotifierItem *item = new FakeStatusNotifierItem(QString("replay_sni_%1").arg(index), this);
+    if (!m_connection.registerObject(path, item, QDBusConnection::ExportAllContents)) {
+        qWarning() << "register sni item failed:" << path << m_connection.lastError().message();
+        delete item;
+        return -1;
+    }
+
+    m_sniItems.insert(index, item);
+
+    const qint64 beginNs = Utils::monotonicNs();
+    m_sniWatcher->addItem(sniServicePath(index));
+    return beginNs;
+}
+
+qint64 FakeServices::unregisterSni(int index)
+{
+    FakeStatusNotifierItem *item = m_sniItems.take(index);
+    if (!item)
+        return -1;
+
+    const qint64 beginNs = Utils::monotonicNs();
+    m_sniWatcher->removeItem(sniServicePath(index));
+
+    m_connection.unregisterObject(QString("/StatusNotifierItem/%1").arg(index));
+    item->deleteLater();
+    return beginNs;
+}
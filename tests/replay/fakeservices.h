@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef FAKESERVICES_H
+#define FAKESERVICES_H
+
+#include <QObject>
+#include <QDBusConnection>
+#include <QHash>
+
+class FakeDockDaemon;
+class FakeTrayManager;
+class FakeStatusNotifierWatcher;
+class FakeStatusNotifierItem;
+
+/**
+ * @brief The FakeServices class
+ * 在私有会话总线上提供任务栏依赖的后端服务(Dock1、TrayManager1、StatusNotifierWatcher)。
+ * 对象需要移动到单独的线程中，使用单独的总线连接，任务栏在主线程中的同步调用才不会互相阻塞。
+ * 回放程序通过BlockingQueuedConnection调用下面的接口，返回值为发出DBus信号时的时间戳(纳秒)，失败时返回-1
+ */
+class FakeServices : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FakeServices(QObject *parent = nullptr);
+    ~FakeServices() override;
+
+    static QString entryId(int index);
+    QString sniServicePath(int index) const;
+
+    Q_INVOKABLE bool start(const QString &address);
+    Q_INVOKABLE void stop();
+
+    Q_INVOKABLE qint64 addEntry(int index);
+    Q_INVOKABLE qint64 removeEntry(int index);
+    Q_INVOKABLE qint64 openWindow(int index);
+    Q_INVOKABLE qint64 closeWindow(int index);
+    Q_INVOKABLE qint64 registerSni(int index);
+    Q_INVOKABLE qint64 unregisterSni(int index);
+
+private:
+    QDBusConnection m_connection;
+    QString m_uniqueName;
+    FakeDockDaemon *m_dockDaemon;
+    FakeTrayManager *m_trayManager;
+    FakeStatusNotifierWatcher *m_sniWatcher;
+    QHash<int, FakeStatusNotifierItem *> m_sniItems;
+    quint32 m_nextWindowId;
+};
+
+#endif // FAKESERVICES_H
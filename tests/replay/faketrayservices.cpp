@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "faketrayservices.h"
+
+FakeTrayManager::FakeTrayManager(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FakeStatusNotifierItem::FakeStatusNotifierItem(const QString &id, QObject *parent)
+    : QObject(parent)
+    , m_id(id)
+{
+}
+
+FakeStatusNotifierWatcher::FakeStatusNotifierWatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool FakeStatusNotifierWatcher::addItem(const QString &servicePath)
+{
+    if (m_items.contains(servicePath))
+        return false;
+
+    m_items << servicePath;
+    Q_EMIT StatusNotifierItemRegistered(servicePath);
+
+    return true;
+}
+
+bool FakeStatusNotifierWatcher::removeItem(const QString &servicePath)
+{
+    if (!m_items.removeOne(servicePath))
+        return false;
+
+    Q_EMIT StatusNotifierItemUnregistered(servicePath);
+
+    return true;
+}
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef FAKETRAYSERVICES_H
+#define FAKETRAYSERVICES_H
+
+#include <QObject>
+#include <QDBusObjectPath>
+#include <QStringList>
+
+/**
+ * @brief The FakeTrayManager class
+ * 模拟org.deepin.dde.TrayManager1，离屏环境下没有X窗口，不提供xembed托盘
+ */
+class FakeTrayManager : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.dde.TrayManager1")
+
+    Q_PROPERTY(QList<quint32> TrayIcons READ trayIcons)
+
+public:
+    explicit FakeTrayManager(QObject *parent = nullptr);
+
+    QList<quint32> trayIcons() const { return QList<quint32>(); }
+
+public Q_SLOTS:
+    void EnableNotification(uint, bool) {}
+    QString GetName(uint) { return QString(); }
+    bool Manage() { return true; }
+    void RetryManager() {}
+    bool Unmanage() { return true; }
+
+Q_SIGNALS:
+    void Added(uint id);
+    void Changed(uint id);
+    void Inited();
+    void Removed(uint id);
+};
+
+/**
+ * @brief The FakeStatusNotifierItem class 模拟应用注册的SNI托盘
+ */
+class FakeStatusNotifierItem : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.StatusNotifierItem")
+
+    Q_PROPERTY(QString Category READ category)
+    Q_PROPERTY(QString Id READ id)
+    Q_PROPERTY(QString Title READ title)
+    Q_PROPERTY(QString Status READ status)
+    Q_PROPERTY(QString IconName READ iconName)
+    Q_PROPERTY(QString IconThemePath READ iconThemePath)
+    Q_PROPERTY(QString OverlayIconName READ overlayIconName)
+    Q_PROPERTY(QString AttentionIconName READ attentionIconName)
+    Q_PROPERTY(QString AttentionMovieName READ attentionMovieName)
+    Q_PROPERTY(QDBusObjectPath Menu READ menu)
+    Q_PROPERTY(bool ItemIsMenu READ itemIsMenu)
+    Q_PROPERTY(int WindowId READ windowId)
+
+public:
+    FakeStatusNotifierItem(const QString &id, QObject *parent = nullptr);
+
+    QString category() const { return QString("ApplicationStatus"); }
+    QString id() const { return m_id; }
+    QString title() const { return m_id; }
+    QString status() const { return QString("Active"); }
+    QString iconName() const { return QString("application-x-executable"); }
+    QString iconThemePath() const { return QString(); }
+    QString overlayIconName() const { return QString(); }
+    QString attentionIconName() const { return QString(); }
+    QString attentionMovieName() const { return QString(); }
+    QDBusObjectPath menu() const { return QDBusObjectPath("/NO_DBUSMENU"); }
+    bool itemIsMenu() const { return false; }
+    int windowId() const { return 0; }
+
+public Q_SLOTS:
+    void Activate(int, int) {}
+    void ContextMenu(int, int) {}
+    void Scroll(int, const QString &) {}
+    void SecondaryActivate(int, int) {}
+
+Q_SIGNALS:
+    void NewAttentionIcon();
+    void NewIcon();
+    void NewOverlayIcon();
+    void NewStatus(const QString &status);
+    void NewTitle();
+    void NewToolTip();
+
+private:
+    QString m_id;
+};
+
+/**
+ * @brief The FakeStatusNotifierWatcher class 模拟org.kde.StatusNotifierWatcher
+ */
+class FakeStatusNotifierWatcher : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.StatusNotifierWatcher")
+
+    Q_PROPERTY(bool IsStatusNotifierHostRegistered READ isStatusNotifierHostRegistered)
+    Q_PROPERTY(int ProtocolVersion READ protocolVersion)
+    Q_PROPERTY(QStringList RegisteredStatusNotifierItems READ registeredStatusNotifierItems)
+
+public:
+    explicit FakeStatusNotifierWatcher(QObject *parent = nullptr);
+
+    bool isStatusNotifierHostRegistered() const { return true; }
+    int protocolVersion() const { return 0; }
+    QStringList registeredStatusNotifierItems() const { return m_items; }
+
+    bool addItem(const QString &servicePath);
+    bool removeItem(const QString &servicePath);
+
+public Q_SLOTS:
+    void RegisterStatusNotifierHost(const QString &) {}
+    void RegisterStatusNotifierItem(const QString &) {}
+
+Q_SIGNALS:
+    void StatusNotifierHostRegistered();
+    void StatusNotifierHostUnregistered();
+    void StatusNotifierItemRegistered(const QString &servicePath);
+    void StatusNotifierItemUnregistered(const QString &servicePath);
+
+private:
+    QStringList m_items;
+};
+
+#endif // FAKETRAYSERVICES_H
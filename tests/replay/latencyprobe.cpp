@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "latencyprobe.h"
+#include "spantracer.h"
+
+#include <QApplication>
+#include <QEvent>
+#include <QEventLoop>
+#include <QTimer>
+#include <QWidget>
+
+LatencyProbe::LatencyProbe(QObject *parent)
+    : QObject(parent)
+    , m_timeouts(0)
+    , m_frameQueued(false)
+    , m_loop(nullptr)
+{
+    qApp->installEventFilter(this);
+}
+
+LatencyProbe::~LatencyProbe()
+{
+    qApp->removeEventFilter(this);
+}
+
+void LatencyProbe::expect(qint64 beginNs, const Matcher &matcher)
+{
+    if (beginNs < 0)
+        return;
+
+    m_pending << Expectation { beginNs, matcher };
+}
+
+/**
+ * @brief LatencyProbe::wait 等待所有期望的绘制完成
+ * @return 超时返回false，未完成的期望记为超时
+ */
+bool LatencyProbe::wait(int timeoutMsec)
+{
+    if (pendingCount() == 0)
+        return true;
+
+    QEventLoop loop;
+    QTimer::singleShot(timeoutMsec, &loop, &QEventLoop::quit);
+
+    m_loop = &loop;
+    loop.exec();
+    m_loop = nullptr;
+
+    if (pendingCount() == 0)
+        return true;
+
+    m_timeouts += pendingCount();
+    m_pending.clear();
+    m_painted.clear();
+    return false;
+}
+
+QList<qint64> LatencyProbe::takeLatencies()
+{
+    QList<qint64> latencies;
+    latencies.swap(m_latencies);
+    return latencies;
+}
+
+int LatencyProbe::takeTimeouts()
+{
+    const int timeouts = m_timeouts;
+    m_timeouts = 0;
+    return timeouts;
+}
+
+bool LatencyProbe::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() != QEvent::Paint || m_pending.isEmpty() || !watched->isWidgetType())
+        return false;
+
+    QWidget *widget = static_cast<QWidget *>(watched);
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->matcher(widget)) {
+            m_painted << *it;
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // 同一次刷新中的所有控件绘制完成后才会回到事件循环，这里记录的是整帧完成的时间
+    if (!m_painted.isEmpty() && !m_frameQueued) {
+        m_frameQueued = true;
+        QMetaObject::invokeMethod(this, "onFramePainted", Qt::QueuedConnection);
+    }
+
+    return false;
+}
+
+void LatencyProbe::onFramePainted()
+{
+    m_frameQueued = false;
+
+    const qint64 endNs = Utils::monotonicNs();
+    SpanTracer *tracer = SpanTracer::instance();
+    for (const Expectation &expectation : m_painted) {
+        m_latencies << endNs - expectation.beginNs;
+        tracer->addSpan("replaySignalToFrame", QByteArray(), expectation.beginNs, endNs);
+    }
+
+    m_painted.clear();
+
+    if (m_loop && pendingCount() == 0)
+        m_loop->quit();
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <QObject>
+#include <QList>
+
+#include <functional>
+
+class QWidget;
+class QEventLoop;
+
+/**
+ * @brief The LatencyProbe class
+ * 统计从发出DBus信号到任务栏绘制出对应变化的耗时。
+ * 每次发出信号后登记一个期望，在qApp上监听绘制事件，满足期望的控件绘制后，
+ * 在下一次事件循环中记录结束时间(此时同一批绘制的内容已经刷新到窗口的后台缓冲区)
+ */
+class LatencyProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<bool(QWidget *)> Matcher;
+
+    explicit LatencyProbe(QObject *parent = nullptr);
+    ~LatencyProbe() override;
+
+    void expect(qint64 beginNs, const Matcher &matcher);
+    int pendingCount() const { return m_pending.size() + m_painted.size(); }
+    bool wait(int timeoutMsec);
+
+    QList<qint64> takeLatencies();
+    int takeTimeouts();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private Q_SLOTS:
+    void onFramePainted();
+
+private:
+    struct Expectation
+    {
+        qint64 beginNs;
+        Matcher matcher;
+    };
+
+    QList<Expectation> m_pending;
+    QList<Expectation> m_painted;
+    QList<qint64> m_latencies;
+    int m_timeouts;
+    bool m_frameQueued;
+    QEventLoop *m_loop;
+};
+
+#endif // LATENCYPROBE_H
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "privatebus.h"
+#include "fakeservices.h"
+#include "latencyprobe.h"
+#include "scenariorunner.h"
+#include "dockapplication.h"
+#include "mainwindow.h"
+#include "traymainwindow.h"
+#include "windowmanager.h"
+#include "multiscreenworker.h"
+#include "settingconfig.h"
+#include "connectionidentitycache.h"
+#include "entryinterface.h"
+#include "types/dockrect.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTimer>
+
+#include <unistd.h>
+
+#define DOCKQUICKTRAYNAME "Dock_Quick_Tray_Name"
+// 任务栏启动后等待初始化完成的时间(毫秒)
+#define SETTLE_TIME 1000
+
+/**
+ * 端到端回放程序：启动私有的会话总线，在总线上提供模拟的后端服务，然后在离屏模式下运行真实的
+ * MainWindow和TrayMainWindow，回放登录、窗口开关、托盘变化等场景，输出从DBus信号到绘制完成的耗时
+ */
+int main(int argc, char **argv)
+{
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    // 开启跟踪，报告中的DBus统计只在开启跟踪时记录
+    qputenv("DDE_DOCK_TRACE", "1");
+
+    // 配置写到临时目录中，不影响当前用户的任务栏配置
+    QTemporaryDir configDir;
+    qputenv("XDG_CONFIG_HOME", configDir.path().toLocal8Bit());
+
+    // 会话总线的地址需要在创建qApp之前设置
+    PrivateBus bus;
+    if (!bus.start())
+        return -1;
+
+    qputenv("DBUS_SESSION_BUS_ADDRESS", bus.address().toLocal8Bit());
+
+    DockApplication app(argc, argv);
+    app.setOrganizationName("deepin");
+    app.setApplicationName("dde-dock");
+
+    QCommandLineOption scenarioOption("scenario", "scenarios to replay: login, windows, tray.", "names", "login,windows,tray");
+    QCommandLineOption scriptOption("script", "replay the scenario in the json file.", "file");
+    QCommandLineOption entriesOption("entries", "number of app entries.", "count", "50");
+    QCommandLineOption burstsOption("bursts", "number of window open/close bursts.", "count", "200");
+    QCommandLineOption trayCyclesOption("tray-cycles", "number of tray register/unregister cycles.", "count", "100");
+    QCommandLineOption timeoutOption("timeout", "timeout for each signal to be painted.", "msec", "1000");
+    QCommandLineOption outputOption("output", "write the report to the file.", "file");
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DDE Dock end-to-end replay");
+    parser.addHelpOption();
+    parser.addOptions({ scenarioOption, scriptOption, entriesOption, burstsOption, trayCyclesOption, timeoutOption, outputOption });
+    parser.process(app);
+
+    // 模拟服务导出的属性中使用了自定义类型，注册服务之前需要先注册类型
+    registerDockRectMetaType();
+    registerWindowListMetaType();
+    registerWindowInfoMapMetaType();
+
+    QThread serviceThread;
+    FakeServices services;
+    services.moveToThread(&serviceThread);
+    serviceThread.start();
+
+    bool started = false;
+    QMetaObject::invokeMethod(&services, "start", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, started), Q_ARG(QString, bus.address()));
+    if (!started) {
+        serviceThread.quit();
+        serviceThread.wait();
+        return -1;
+    }
+
+    // 模拟的SNI托盘都由当前进程注册，将其加入任务栏托盘的配置中，否则只会显示在展开的托盘中
+    const QString &trayKey = QString("sni:%1").arg(QFileInfo(ConnectionIdentityCache::fileNameByPid(getpid())).fileName());
+    QStringList trayNames = SETTINGCONFIG->value(DOCKQUICKTRAYNAME).toStringList();
+    if (!trayNames.contains(trayKey))
+        SETTINGCONFIG->setValue(DOCKQUICKTRAYNAME, trayNames << trayKey);
+
+    // 不加载插件，保证每次回放的结果可以比较
+    qApp->setProperty("safeMode", true);
+    qApp->setProperty("CANSHOW", true);
+
+    MultiScreenWorker multiScreenWorker;
+    MainWindow mainWindow(&multiScreenWorker);
+    TrayMainWindow trayMainWindow(&multiScreenWorker);
+    WindowManager windowManager(&multiScreenWorker);
+    windowManager.addWindow(&mainWindow);
+    windowManager.addWindow(&trayMainWindow);
+    windowManager.launch();
+    mainWindow.setVisible(true);
+
+    QList<ScenarioRunner::Scenario> scenarios;
+    if (parser.isSet(scriptOption)) {
+        ScenarioRunner::Scenario scenario;
+        if (!ScenarioRunner::loadScenario(parser.value(scriptOption), scenario))
+            return -1;
+
+        scenarios << scenario;
+    } else {
+        const int entryCount = parser.value(entriesOption).toInt();
+        for (const QString &name : parser.value(scenarioOption).split(",", QString::SkipEmptyParts)) {
+            if (name == "login")
+                scenarios << ScenarioRunner::loginScenario(entryCount);
+            else if (name == "windows")
+                scenarios << ScenarioRunner::windowBurstScenario(parser.value(burstsOption).toInt(), entryCount);
+            else if (name == "tray")
+                scenarios << ScenarioRunner::trayChurnScenario(parser.value(trayCyclesOption).toInt());
+            else
+                qWarning() << "unknown scenario:" << name;
+        }
+    }
+
+    LatencyProbe probe;
+    ScenarioRunner runner(&services, &probe, parser.value(timeoutOption).toInt());
+
+    QTimer::singleShot(SETTLE_TIME, &app, [ & ] {
+        QJsonArray results;
+        for (const ScenarioRunner::Scenario &scenario : scenarios)
+            results << runner.run(scenario);
+
+        QJsonObject report;
+        report["scenarios"] = results;
+        const QByteArray &data = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+        if (parser.isSet(outputOption)) {
+            QFile file(parser.value(outputOption));
+            if (file.open(QIODevice::WriteOnly))
+                file.write(data);
+            else
+                qWarning() << "write report failed:" << file.fileName();
+        } else {
+            fprintf(stdout, "%s\n", data.constData());
+        }
+
+        app.quit();
+    });
+
+    const int ret = app.exec();
+
+    QMetaObject::invokeMethod(&services, "stop", Qt::BlockingQueuedConnection);
+    serviceThread.quit();
+    serviceThread.wait();
+
+    return ret;
+}
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "privatebus.h"
+
+#include <QFile>
+#include <QDebug>
+
+// 启动dbus-daemon的超时时间(毫秒)
+#define BUS_START_TIMEOUT 5000
+
+static const char *BusConfig =
+        "<!DOCTYPE busconfig PUBLIC \"-//freedesktop//DTD D-Bus Bus Configuration 1.0//EN\"\n"
+        " \"http://www.freedesktop.org/standards/dbus/1.0/busconfig.dtd\">\n"
+        "<busconfig>\n"
+        "  <type>session</type>\n"
+        "  <listen>unix:dir=%1</listen>\n"
+        "  <auth>EXTERNAL</auth>\n"
+        "  <policy context=\"default\">\n"
+        "    <allow send_destination=\"*\" eavesdrop=\"true\"/>\n"
+        "    <allow eavesdrop=\"true\"/>\n"
+        "    <allow own=\"*\"/>\n"
+        "  </policy>\n"
+        "</busconfig>\n";
+
+PrivateBus::PrivateBus()
+{
+}
+
+PrivateBus::~PrivateBus()
+{
+    stop();
+}
+
+bool PrivateBus::start()
+{
+    if (!m_dir.isValid()) {
+        qWarning() << "create temporary dir failed:" << m_dir.errorString();
+        return false;
+    }
+
+    const QString configFile = m_dir.filePath("session.conf");
+    QFile file(configFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "write bus config failed:" << configFile;
+        return false;
+    }
+
+    file.write(QString(BusConfig).arg(m_dir.path()).toUtf8());
+    file.close();
+
+    m_process.start("dbus-daemon", QStringList() << QString("--config-file=%1").arg(configFile)
+                    << "--nofork" << "--print-address=1");
+    if (!m_process.waitForStarted(BUS_START_TIMEOUT)) {
+        qWarning() << "start dbus-daemon failed:" << m_process.errorString();
+        return false;
+    }
+
+    // 总线准备好之后才会输出地址
+    while (!m_process.canReadLine()) {
+        if (!m_process.waitForReadyRead(BUS_START_TIMEOUT)) {
+            qWarning() << "read bus address failed:" << m_process.readAllStandardError();
+            stop();
+            return false;
+        }
+    }
+
+    m_address = QString::fromLocal8Bit(m_process.readLine()).trimmed();
+    return !m_address.isEmpty();
+}
+
+void PrivateBus::stop()
+{
+    if (m_process.state() == QProcess::NotRunning)
+        return;
+
+    m_process.terminate();
+    if (!m_process.waitForFinished(BUS_START_TIMEOUT))
+        m_process.kill();
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PRIVATEBUS_H
+#define PRIVATEBUS_H
+
+#include <QProcess>
+#include <QTemporaryDir>
+
+/**
+ * @brief The PrivateBus class
+ * 启动一个私有的dbus-daemon作为会话总线，不使用系统的服务目录，避免按需启动真实的后端服务
+ */
+class PrivateBus
+{
+public:
+    PrivateBus();
+    ~PrivateBus();
+
+    bool start();
+    void stop();
+    QString address() const { return m_address; }
+
+private:
+    Q_DISABLE_COPY(PrivateBus)
+
+    QTemporaryDir m_dir;
+    QProcess m_process;
+    QString m_address;
+};
+
+#endif // PRIVATEBUS_H
@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "scenariorunner.h"
+#include "fakeservices.h"
+#include "appitem.h"
+#include "dockitemmanager.h"
+#include "mainwindowbase.h"
+#include "snitrayitemwidget.h"
+#include "tray_model.h"
+#include "dbusstatistics.h"
+#include "paintprofiler.h"
+#include "spantracer.h"
+
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTimer>
+
+#include <algorithm>
+
+// 每一轮同时开关窗口的应用个数、同时注册的托盘个数
+#define WINDOW_BURST_SIZE 5
+#define TRAY_CHURN_SIZE 5
+
+static const QMap<QString, ScenarioRunner::Step::Action> ActionNames = {
+    { "addEntry", ScenarioRunner::Step::AddEntry },
+    { "removeEntry", ScenarioRunner::Step::RemoveEntry },
+    { "openWindow", ScenarioRunner::Step::OpenWindow },
+    { "closeWindow", ScenarioRunner::Step::CloseWindow },
+    { "registerSni", ScenarioRunner::Step::RegisterSni },
+    { "unregisterSni", ScenarioRunner::Step::UnregisterSni },
+    { "sync", ScenarioRunner::Step::Sync },
+    { "wait", ScenarioRunner::Step::Wait }
+};
+
+static bool isDockWidget(QWidget *widget)
+{
+    return qobject_cast<MainWindowBase *>(widget->window()) != nullptr;
+}
+
+static bool sniInDockModel(const QString &servicePath)
+{
+    for (const WinInfo &winInfo : TrayModel::getDockModel()->m_winInfos) {
+        if (winInfo.servicePath == servicePath)
+            return true;
+    }
+
+    return false;
+}
+
+ScenarioRunner::ScenarioRunner(FakeServices *services, LatencyProbe *probe, int timeoutMsec, QObject *parent)
+    : QObject(parent)
+    , m_services(services)
+    , m_probe(probe)
+    , m_timeoutMsec(timeoutMsec)
+{
+}
+
+/**
+ * @brief ScenarioRunner::loginScenario 登录时后端一次性发出所有应用的EntryAdded信号
+ */
+ScenarioRunner::Scenario ScenarioRunner::loginScenario(int entryCount)
+{
+    Scenario scenario;
+    scenario.name = "login";
+    for (int i = 0; i < entryCount; ++i)
+        scenario.steps << Step { Step::AddEntry, i };
+
+    scenario.steps << Step { Step::Sync, 0 };
+    return scenario;
+}
+
+/**
+ * @brief ScenarioRunner::windowBurstScenario 每一轮中几个应用同时打开一个窗口，绘制完成后再同时关闭
+ */
+ScenarioRunner::Scenario ScenarioRunner::windowBurstScenario(int burstCount, int entryCount)
+{
+    Scenario scenario;
+    scenario.name = "windows";
+    scenario.entryCount = entryCount;
+    if (entryCount <= 0)
+        return scenario;
+
+    const int burstSize = qMin(WINDOW_BURST_SIZE, entryCount);
+    for (int burst = 0; burst < burstCount; ++burst) {
+        for (int i = 0; i < burstSize; ++i)
+            scenario.steps << Step { Step::OpenWindow, (burst * burstSize + i) % entryCount };
+
+        scenario.steps << Step { Step::Sync, 0 };
+
+        for (int i = 0; i < burstSize; ++i)
+            scenario.steps << Step { Step::CloseWindow, (burst * burstSize + i) % entryCount };
+
+        scenario.steps << Step { Step::Sync, 0 };
+    }
+
+    return scenario;
+}
+
+/**
+ * @brief ScenarioRunner::trayChurnScenario 每一轮注册几个SNI托盘，绘制完成后再全部注销
+ */
+ScenarioRunner::Scenario ScenarioRunner::trayChurnScenario(int cycleCount)
+{
+    Scenario scenario;
+    scenario.name = "tray";
+    for (int cycle = 0; cycle < cycleCount; ++cycle) {
+        // 每个托盘使用不同的路径，避免匹配到还未释放的旧控件
+        for (int i = 0; i < TRAY_CHURN_SIZE; ++i)
+            scenario.steps << Step { Step::RegisterSni, cycle * TRAY_CHURN_SIZE + i };
+
+        scenario.steps << Step { Step::Sync, 0 };
+
+        for (int i = 0; i < TRAY_CHURN_SIZE; ++i)
+            scenario.steps << Step { Step::UnregisterSni, cycle * TRAY_CHURN_SIZE + i };
+
+        scenario.steps << Step { Step::Sync, 0 };
+    }
+
+    return scenario;
+}
+
+bool ScenarioRunner::loadScenario(const QString &fileName, Scenario &scenario)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "open scenario failed:" << fileName;
+        return false;
+    }
+
+    QJsonParseError error;
+    const QJsonObject &object = QJsonDocument::fromJson(file.readAll(), &error).object();
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "parse scenario failed:" << fileName << error.errorString();
+        return false;
+    }
+
+    scenario.name = object.value("name").toString(QFileInfo(fileName).baseName());
+    scenario.entryCount = object.value("entries").toInt();
+    scenario.steps.clear();
+
+    for (const QJsonValue &value : object.value("steps").toArray()) {
+        const QJsonObject &stepObject = value.toObject();
+        const QString &actionName = stepObject.value("action").toString();
+        if (!ActionNames.contains(actionName)) {
+            qWarning() << "unknown scenario action:" << actionName;
+            return false;
+        }
+
+        const Step::Action action = ActionNames.value(actionName);
+        const int target = (action == Step::Wait) ? stepObject.value("msec").toInt() : stepObject.value("target").toInt();
+        scenario.steps << Step { action, target };
+    }
+
+    return true;
+}
+
+/**
+ * @brief ScenarioRunner::summarize 统计耗时的分布
+ * @param latencies 每个信号到绘制完成的耗时(纳秒)
+ * @param timeouts 超时未绘制的信号个数
+ */
+QJsonObject ScenarioRunner::summarize(QList<qint64> latencies, int timeouts)
+{
+    QJsonObject summary;
+    summary["samples"] = latencies.size();
+    summary["timeouts"] = timeouts;
+    if (latencies.isEmpty())
+        return summary;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [ & ](int percent) {
+        const int index = qMin(latencies.size() - 1, (latencies.size() * percent) / 100);
+        return latencies.at(index) / 1000000.0;
+    };
+
+    qint64 totalNs = 0;
+    for (qint64 latency : latencies)
+        totalNs += latency;
+
+    summary["minMs"] = latencies.first() / 1000000.0;
+    summary["avgMs"] = totalNs / 1000000.0 / latencies.size();
+    summary["medianMs"] = percentile(50);
+    summary["p95Ms"] = percentile(95);
+    summary["p99Ms"] = percentile(99);
+    summary["maxMs"] = latencies.last() / 1000000.0;
+
+    return summary;
+}
+
+QJsonObject ScenarioRunner::run(const Scenario &scenario)
+{
+    prepareEntries(scenario.entryCount);
+
+    DBusStatistics::instance()->reset();
+    PaintProfiler::instance()->reset();
+
+    const qint64 beginNs = Utils::monotonicNs();
+    for (const Step &step : scenario.steps)
+        runStep(step);
+
+    m_probe->wait(m_timeoutMsec);
+    const qint64 endNs = Utils::monotonicNs();
+    SpanTracer::instance()->addSpan("replayScenario", scenario.name.toUtf8(), beginNs, endNs);
+
+    QJsonObject result = summarize(m_probe->takeLatencies(), m_probe->takeTimeouts());
+    result["name"] = scenario.name;
+    result["steps"] = scenario.steps.size();
+    result["durationMs"] = (endNs - beginNs) / 1000000.0;
+    result["dbusStatistics"] = QJsonDocument::fromJson(DBusStatistics::instance()->report().toUtf8()).object();
+    result["paintProfile"] = QJsonDocument::fromJson(PaintProfiler::instance()->report().toUtf8()).object();
+
+    return result;
+}
+
+qint64 ScenarioRunner::invoke(const char *method, int target)
+{
+    qint64 beginNs = -1;
+    QMetaObject::invokeMethod(m_services, method, Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(qint64, beginNs), Q_ARG(int, target));
+    return beginNs;
+}
+
+void ScenarioRunner::runStep(const Step &step)
+{
+    switch (step.action) {
+    case Step::AddEntry: {
+        const QString &id = FakeServices::entryId(step.target);
+        const qint64 beginNs = invoke("addEntry", step.target);
+        if (beginNs >= 0)
+            m_windowCounts[step.target] = 0;
+
+        m_probe->expect(beginNs, [ id ](QWidget *widget) {
+            AppItem *appItem = qobject_cast<AppItem *>(widget);
+            return appItem && appItem->appId() == id;
+        });
+        break;
+    }
+    case Step::RemoveEntry: {
+        const QString &id = FakeServices::entryId(step.target);
+        const qint64 beginNs = invoke("removeEntry", step.target);
+        m_windowCounts.remove(step.target);
+
+        // 应用被移除后，任务栏重新布局时的第一次绘制
+        m_probe->expect(beginNs, [ id ](QWidget *widget) {
+            return isDockWidget(widget) && !DockItemManager::instance()->m_appIDist.contains(id);
+        });
+        break;
+    }
+    case Step::OpenWindow:
+    case Step::CloseWindow: {
+        const bool open = (step.action == Step::OpenWindow);
+        const QString &id = FakeServices::entryId(step.target);
+        const qint64 beginNs = invoke(open ? "openWindow" : "closeWindow", step.target);
+        if (beginNs < 0)
+            break;
+
+        const int windowCount = (m_windowCounts[step.target] += open ? 1 : -1);
+        m_probe->expect(beginNs, [ id, windowCount ](QWidget *widget) {
+            AppItem *appItem = qobject_cast<AppItem *>(widget);
+            return appItem && appItem->appId() == id && appItem->windowsMap().size() == windowCount;
+        });
+        break;
+    }
+    case Step::RegisterSni: {
+        const QString &servicePath = m_services->sniServicePath(step.target);
+        m_probe->expect(invoke("registerSni", step.target), [ servicePath ](QWidget *widget) {
+            SNITrayItemWidget *trayWidget = qobject_cast<SNITrayItemWidget *>(widget);
+            return trayWidget && trayWidget->m_sniServicePath == servicePath;
+        });
+        break;
+    }
+    case Step::UnregisterSni: {
+        const QString &servicePath = m_services->sniServicePath(step.target);
+        m_probe->expect(invoke("unregisterSni", step.target), [ servicePath ](QWidget *widget) {
+            return isDockWidget(widget) && !sniInDockModel(servicePath);
+        });
+        break;
+    }
+    case Step::Sync:
+        m_probe->wait(m_timeoutMsec);
+        break;
+    case Step::Wait: {
+        QEventLoop loop;
+        QTimer::singleShot(step.target, &loop, &QEventLoop::quit);
+        loop.exec();
+        break;
+    }
+    }
+}
+
+/**
+ * @brief ScenarioRunner::prepareEntries 添加场景需要的应用，添加的耗时不计入场景的统计
+ */
+void ScenarioRunner::prepareEntries(int entryCount)
+{
+    bool added = false;
+    for (int i = 0; i < entryCount; ++i) {
+        if (m_windowCounts.contains(i))
+            continue;
+
+        runStep(Step { Step::AddEntry, i });
+        added = true;
+    }
+
+    if (!added)
+        return;
+
+    m_probe->wait(m_timeoutMsec);
+    m_probe->takeLatencies();
+    m_probe->takeTimeouts();
+}
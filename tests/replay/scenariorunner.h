@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef SCENARIORUNNER_H
+#define SCENARIORUNNER_H
+
+#include "latencyprobe.h"
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+
+class FakeServices;
+
+/**
+ * @brief The ScenarioRunner class
+ * 按顺序回放场景中的每一步，由FakeServices发出DBus信号，LatencyProbe统计信号到绘制完成的耗时。
+ * 场景可以使用内置的登录、窗口开关、托盘变化，也可以从JSON文件中读取，格式为
+ * {"name": "...", "entries": 10, "steps": [{"action": "openWindow", "target": 3}, {"action": "sync"}]}
+ */
+class ScenarioRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Step
+    {
+        enum Action {
+            AddEntry,
+            RemoveEntry,
+            OpenWindow,
+            CloseWindow,
+            RegisterSni,
+            UnregisterSni,
+            Sync,               // 等待之前所有步骤的绘制完成
+            Wait                // 等待固定的时间，target为毫秒数
+        };
+
+        Action action;
+        int target;
+    };
+
+    struct Scenario
+    {
+        QString name;
+        int entryCount = 0;     // 回放前需要准备好的应用个数，准备过程不计入统计
+        QList<Step> steps;
+    };
+
+    ScenarioRunner(FakeServices *services, LatencyProbe *probe, int timeoutMsec, QObject *parent = nullptr);
+
+    static Scenario loginScenario(int entryCount);
+    static Scenario windowBurstScenario(int burstCount, int entryCount);
+    static Scenario trayChurnScenario(int cycleCount);
+    static bool loadScenario(const QString &fileName, Scenario &scenario);
+
+    static QJsonObject summarize(QList<qint64> latencies, int timeouts);
+
+    QJsonObject run(const Scenario &scenario);
+
+private:
+    qint64 invoke(const char *method, int target);
+    void runStep(const Step &step);
+    void prepareEntries(int entryCount);
+
+private:
+    FakeServices *m_services;
+    LatencyProbe *m_probe;
+    int m_timeoutMsec;
+    QHash<int, int> m_windowCounts;     // 已经添加的应用和它打开的窗口个数
+};
+
+#endif // SCENARIORUNNER_H
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "animationclock.h"
+#include "appswingeffectbuilder.h"
+
+#include <QSignalSpy>
+#include <QWidget>
+
+#include <gtest/gtest.h>
+
+class Ut_AnimationClock : public ::testing::Test
+{
+};
+
+TEST_F(Ut_AnimationClock, start_test)
+{
+    AnimationClock *clock = AnimationClock::instance();
+    QSignalSpy spy(clock, &AnimationClock::finished);
+
+    QWidget first;
+    QWidget second;
+    clock->start(&first, 50);
+    clock->start(&second, 200);
+
+    // 所有动画共用同一个定时器
+    ASSERT_TRUE(clock->m_timer->isActive());
+    EXPECT_TRUE(clock->isRunning(&first));
+    EXPECT_GE(clock->elapsed(&first), 0);
+
+    ASSERT_TRUE(spy.wait(1000));
+    EXPECT_EQ(spy.first().first().value<QWidget *>(), &first);
+    EXPECT_FALSE(clock->isRunning(&first));
+    EXPECT_EQ(clock->elapsed(&first), -1);
+    EXPECT_TRUE(clock->isRunning(&second));
+
+    // 手动停止时不发送finished信号，没有动画时定时器停止
+    clock->stop(&second);
+    EXPECT_FALSE(clock->isRunning(&second));
+    EXPECT_FALSE(clock->m_timer->isActive());
+    EXPECT_EQ(spy.count(), 1);
+}
+
+TEST_F(Ut_AnimationClock, destroyed_test)
+{
+    AnimationClock *clock = AnimationClock::instance();
+
+    QWidget *widget = new QWidget;
+    clock->start(widget, 1000);
+    delete widget;
+
+    EXPECT_TRUE(clock->m_animations.isEmpty());
+    EXPECT_FALSE(clock->m_timer->isActive());
+}
+
+TEST_F(Ut_AnimationClock, swingRotation_test)
+{
+    EXPECT_DOUBLE_EQ(SwingRotation(0), 0);
+    EXPECT_DOUBLE_EQ(SwingRotation(SWING_DURATION), 0);
+    EXPECT_DOUBLE_EQ(SwingRotation(-1), 0);
+
+    // 第14帧为最大角度，关键帧之间线性插值
+    const qint64 frameTime = SWING_DURATION / 60;
+    EXPECT_DOUBLE_EQ(SwingRotation(frameTime * 14), 8);
+    EXPECT_DOUBLE_EQ(SwingRotation(frameTime * 29), -8);
+    EXPECT_NEAR(SwingRotation(frameTime * 14 + frameTime / 2), (8 + 7.86164) / 2, 1e-6);
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "appiconresolver.h"
+
+#include <QIcon>
+#include <QTest>
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+class Ut_AppIconResolver : public ::testing::Test
+{
+};
+
+TEST_F(Ut_AppIconResolver, key_test)
+{
+    const AppIconKey key1 { "deepin-editor", 48, 1.25, "bloom" };
+    const AppIconKey key2 { "deepin-editor", 48, 1.25, "bloom" };
+    const AppIconKey key3 { "deepin-editor", 48, 2.0, "bloom" };
+
+    ASSERT_TRUE(key1 == key2);
+    ASSERT_EQ(qHash(key1), qHash(key2));
+    ASSERT_FALSE(key1 == key3);
+}
+
+TEST_F(Ut_AppIconResolver, resolve_test)
+{
+    AppIconResolver *resolver = AppIconResolver::instance();
+    QSignalSpy spy(resolver, &AppIconResolver::iconResolved);
+
+    // 同一个图标的并发请求只会查找一次
+    QFuture<QString> future1 = resolver->resolve("dde-dock-invalid-icon");
+    QFuture<QString> future2 = resolver->resolve("dde-dock-invalid-icon");
+    ASSERT_TRUE(future1 == future2);
+
+    ASSERT_TRUE(spy.wait(5000));
+    ASSERT_EQ(spy.count(), 1);
+    ASSERT_EQ(spy.first().first().toString(), QString("dde-dock-invalid-icon"));
+    ASSERT_FALSE(spy.first().at(1).toBool());
+
+    // 查找失败的图标在重试间隔内不会再次查找
+    QPixmap pix;
+    ASSERT_FALSE(resolver->pixmap(pix, AppIconKey { "dde-dock-invalid-icon", 48, 1.0, QIcon::themeName() }));
+    ASSERT_FALSE(resolver->m_pendingLookups.contains(resolver->lookupKey("dde-dock-invalid-icon")));
+}
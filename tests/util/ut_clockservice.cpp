@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "clockservice.h"
+
+#include <QTimer>
+
+#include <gtest/gtest.h>
+
+class Ut_ClockService : public ::testing::Test
+{
+};
+
+TEST_F(Ut_ClockService, msecsToNextMinute_test)
+{
+    const QDate date(2023, 6, 1);
+    EXPECT_EQ(ClockService::msecsToNextMinute(QDateTime(date, QTime(10, 0, 0))), 60 * 1000);
+    EXPECT_EQ(ClockService::msecsToNextMinute(QDateTime(date, QTime(10, 0, 59, 999))), 1);
+    EXPECT_EQ(ClockService::msecsToNextMinute(QDateTime(date, QTime(23, 59, 30, 500))), 29500);
+}
+
+TEST_F(Ut_ClockService, requestSeconds_test)
+{
+    ClockService *service = ClockService::instance();
+    ASSERT_TRUE(service->m_timer->isActive());
+    ASSERT_TRUE(service->m_secondRequesters.isEmpty());
+
+    // 有对象需要按秒刷新时，一秒内唤醒
+    QObject *requester = new QObject;
+    service->requestSeconds(requester);
+    EXPECT_LE(service->m_timer->remainingTime(), 1000);
+
+    service->requestSeconds(requester);
+    EXPECT_EQ(service->m_secondRequesters.size(), 1);
+
+    service->releaseSeconds(requester);
+    EXPECT_TRUE(service->m_secondRequesters.isEmpty());
+
+    // 对象销毁时自动取消
+    service->requestSeconds(requester);
+    delete requester;
+    EXPECT_TRUE(service->m_secondRequesters.isEmpty());
+    EXPECT_TRUE(service->m_timer->isActive());
+}
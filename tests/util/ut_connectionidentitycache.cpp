@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "connectionidentitycache.h"
+
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+class Ut_ConnectionIdentityCache : public ::testing::Test
+{
+};
+
+TEST_F(Ut_ConnectionIdentityCache, serviceName_test)
+{
+    EXPECT_EQ(ConnectionIdentityCache::serviceName(":1.23/StatusNotifierItem"), QString(":1.23"));
+    EXPECT_EQ(ConnectionIdentityCache::serviceName("org.kde.StatusNotifierItem-1-1/org/ayatana/NotificationItem/a"),
+              QString("org.kde.StatusNotifierItem-1-1"));
+    EXPECT_EQ(ConnectionIdentityCache::serviceName(":1.23"), QString(":1.23"));
+}
+
+TEST_F(Ut_ConnectionIdentityCache, fileNameByPid_test)
+{
+    EXPECT_TRUE(ConnectionIdentityCache::fileNameByPid(0).isEmpty());
+    EXPECT_FALSE(ConnectionIdentityCache::fileNameByPid(static_cast<uint>(getpid())).isEmpty());
+}
+
+TEST_F(Ut_ConnectionIdentityCache, request_test)
+{
+    QDBusConnection conn = QDBusConnection::sessionBus();
+    if (!conn.isConnected())
+        return;
+
+    ConnectionIdentityCache *cache = ConnectionIdentityCache::instance();
+    const QString &service = conn.baseService();
+
+    QSignalSpy spy(cache, &ConnectionIdentityCache::identityReady);
+    cache->request(service);
+    // 重复请求不会重复查询
+    cache->request(service);
+
+    ASSERT_TRUE(spy.wait(3000));
+    EXPECT_EQ(spy.count(), 1);
+    ASSERT_TRUE(cache->contains(service));
+    EXPECT_EQ(cache->identity(service).pid, static_cast<uint>(getpid()));
+}
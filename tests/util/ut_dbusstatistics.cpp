@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbusstatistics.h"
+#include "spantracer.h"
+
+#include <QDBusAbstractInterface>
+#include <QDBusConnection>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <gtest/gtest.h>
+
+class Ut_DBusStatistics : public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        SpanTracer::instance()->setEnabled(true);
+        DBusStatistics::instance()->reset();
+    }
+
+    virtual void TearDown() override
+    {
+        SpanTracer::instance()->setEnabled(false);
+    }
+};
+
+class TestInterface : public QDBusAbstractInterface
+{
+public:
+    TestInterface()
+        : QDBusAbstractInterface("org.test.Service", "/org/test/Service", "org.test.Service", QDBusConnection::sessionBus(), nullptr)
+    {
+    }
+};
+
+TEST_F(Ut_DBusStatistics, bucketIndex_test)
+{
+    EXPECT_EQ(DBusStatistics::bucketIndex(0), 0);
+    EXPECT_EQ(DBusStatistics::bucketIndex(3 * 1000000), 2);
+    EXPECT_EQ(DBusStatistics::bucketIndex(500 * 1000000ll), DBUS_HISTOGRAM_SIZE - 1);
+}
+
+TEST_F(Ut_DBusStatistics, record_test)
+{
+    DBusStatistics *statistics = DBusStatistics::instance();
+    statistics->recordCall("org.test.Service", "Method", DBusStatistics::SyncCall, 3 * 1000000, false);
+    statistics->recordCall("org.test.Service", "Method", DBusStatistics::AsyncCall, 7 * 1000000, true);
+    statistics->recordSignal("org.test.Service", "Changed");
+
+    const QHash<QString, DBusStatistics::Entry> &entries = statistics->entries();
+    ASSERT_TRUE(entries.contains(DBusStatistics::key("org.test.Service", "Method")));
+
+    const DBusStatistics::Entry &entry = entries.value(DBusStatistics::key("org.test.Service", "Method"));
+    EXPECT_EQ(entry.syncCalls, 1u);
+    EXPECT_EQ(entry.asyncCalls, 1u);
+    EXPECT_EQ(entry.errors, 1u);
+    // 单元测试在主线程中运行，同步调用会被记录为阻塞主线程
+    EXPECT_EQ(entry.guiBlockingCalls, 1u);
+    EXPECT_EQ(entry.maxNs, 7 * 1000000);
+    EXPECT_EQ(entries.value(DBusStatistics::key("org.test.Service", "Changed")).signalCount, 1u);
+
+    const QJsonArray &items = QJsonDocument::fromJson(statistics->report().toUtf8()).object().value("items").toArray();
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items.first().toObject().value("member").toString(), QString("Method"));
+
+    statistics->reset();
+    EXPECT_TRUE(statistics->entries().isEmpty());
+}
+
+TEST_F(Ut_DBusStatistics, disabled_test)
+{
+    SpanTracer::instance()->setEnabled(false);
+
+    DBusStatistics *statistics = DBusStatistics::instance();
+    statistics->recordCall("org.test.Service", "Method", DBusStatistics::SyncCall, 3 * 1000000, false);
+    statistics->recordSignal("org.test.Service", "Changed");
+    {
+        DBusCallScope scope("org.test.Service", "Scope");
+    }
+
+    EXPECT_TRUE(statistics->entries().isEmpty());
+}
+
+TEST_F(Ut_DBusStatistics, watchSignals_test)
+{
+    SpanTracer::instance()->setEnabled(false);
+
+    TestInterface inter;
+    DBusStatistics::watchSignals(&inter, true);
+    DBusSignalCounter *counter = inter.findChild<DBusSignalCounter *>();
+    ASSERT_TRUE(counter);
+    EXPECT_FALSE(counter->m_watching);
+
+    // 运行中开启跟踪时，已经创建的代理类也开始统计信号
+    SpanTracer::instance()->setEnabled(true);
+    DBusStatistics::instance()->onTraceEnabledChanged(true);
+    EXPECT_TRUE(counter->m_watching);
+
+    SpanTracer::instance()->setEnabled(false);
+    DBusStatistics::instance()->onTraceEnabledChanged(false);
+    EXPECT_FALSE(counter->m_watching);
+}
@@ -8,6 +8,7 @@
 #include <QObject>
 #include <QTouchEvent>
 #include <QTest>
+#include <QSignalSpy>
 #include <QDebug>
 
 #include <gtest/gtest.h>
@@ -69,6 +70,30 @@ TEST_F(Test_DockApplication, dockapplication_touchstate_test)
     ASSERT_FALSE(qApp->property(IS_TOUCH_STATE).toBool());
 }
 
+// 触屏状态只在变化时通知
+TEST_F(Test_DockApplication, dockapplication_touchstatechanged_test)
+{
+    DockApplication *app = qobject_cast<DockApplication *>(qApp);
+    ASSERT_TRUE(app);
+
+    QMouseEvent mouseEvent(QMouseEvent::MouseMove, QPoint(), QPoint(), QPoint(), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    qApp->sendEvent(qApp, &mouseEvent);
+    ASSERT_FALSE(DockApplication::isTouchState());
+
+    QSignalSpy spy(app, &DockApplication::touchStateChanged);
+
+    QMouseEvent touchMouseEvent(QMouseEvent::MouseMove, QPoint(), QPoint(), QPoint(), Qt::NoButton, Qt::NoButton, Qt::NoModifier, Qt::MouseEventSynthesizedByQt);
+    qApp->sendEvent(qApp, &touchMouseEvent);
+    qApp->sendEvent(qApp, &touchMouseEvent);
+
+    EXPECT_TRUE(DockApplication::isTouchState());
+    EXPECT_EQ(spy.count(), 1);
+
+    qApp->sendEvent(qApp, &mouseEvent);
+    EXPECT_FALSE(DockApplication::isTouchState());
+    EXPECT_EQ(spy.count(), 2);
+}
+
 // 检测触摸点数，如果是多点，就截获不到,如果是单点，可以正常截获
 TEST_F(Test_DockApplication, dockapplication_touchpoints_test)
 {
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "icondiskcache.h"
+
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+class Ut_IconDiskCache : public ::testing::Test
+{
+public:
+    virtual void TearDown() override
+    {
+        QFile::remove(IconDiskCache::instance()->cacheFile("ut-icondiskcache", QSize(16, 16), 1.0, QString()));
+    }
+};
+
+TEST_F(Ut_IconDiskCache, find_test)
+{
+    IconDiskCache *cache = IconDiskCache::instance();
+
+    QPixmap source(16, 16);
+    source.fill(Qt::red);
+    cache->insert("ut-icondiskcache", QSize(16, 16), 1.0, source);
+
+    QPixmap pixmap;
+    ASSERT_TRUE(cache->find("ut-icondiskcache", QSize(16, 16), 1.0, pixmap));
+    EXPECT_EQ(pixmap.size(), QSize(16, 16));
+}
+
+TEST_F(Ut_IconDiskCache, invalidHeader_test)
+{
+    IconDiskCache *cache = IconDiskCache::instance();
+
+    QPixmap source(16, 16);
+    source.fill(Qt::red);
+    cache->insert("ut-icondiskcache", QSize(16, 16), 1.0, source);
+
+    // 头部依次为magic、version、width、height、bytesPerLine、format
+    QFile file(cache->cacheFile("ut-icondiskcache", QSize(16, 16), 1.0, QString()));
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+
+    const qint32 format = QImage::Format_RGB16;
+    file.seek(5 * sizeof(qint32));
+    file.write(reinterpret_cast<const char *>(&format), sizeof(format));
+    file.flush();
+
+    QPixmap pixmap;
+    EXPECT_FALSE(cache->find("ut-icondiskcache", QSize(16, 16), 1.0, pixmap));
+
+    // 每行的字节数小于图像宽度时也不能使用
+    const qint32 validFormat = QImage::Format_ARGB32_Premultiplied;
+    const qint32 bytesPerLine = 16;
+    file.seek(4 * sizeof(qint32));
+    file.write(reinterpret_cast<const char *>(&bytesPerLine), sizeof(bytesPerLine));
+    file.write(reinterpret_cast<const char *>(&validFormat), sizeof(validFormat));
+    file.flush();
+
+    EXPECT_FALSE(cache->find("ut-icondiskcache", QSize(16, 16), 1.0, pixmap));
+}
@@ -7,6 +7,9 @@
 #include <QApplication>
 #include <QSignalSpy>
 #include <QTest>
+#include <QPixmapCache>
+#include <QTemporaryDir>
+#include <QDateTime>
 
 #include <gtest/gtest.h>
 
@@ -22,3 +25,35 @@ TEST_F(Test_ImageUtil, coverage_test)
     ASSERT_EQ(ImageUtil::loadSvg(":/res/dde-calendar.svg", "dde-printer", 100, 1.25).size(), QSize(125, 125));
     ASSERT_EQ(ImageUtil::loadSvg("123", "456", 100, 1.25).size(), QSize(125, 125));
 }
+
+TEST_F(Test_ImageUtil, memoryCache_test)
+{
+    const QPixmap &pixmap = ImageUtil::loadSvg(":/res/dde-calendar.svg", QSize(64, 64), 1.0);
+    ASSERT_FALSE(pixmap.isNull());
+
+    // 第二次加载直接从内存缓存中读取
+    QPixmap cached;
+    ASSERT_TRUE(QPixmapCache::find(ImageUtil::memoryCacheKey(":/res/dde-calendar.svg", QString(), QSize(64, 64), 1.0), &cached));
+    ASSERT_EQ(cached.cacheKey(), ImageUtil::loadSvg(":/res/dde-calendar.svg", QSize(64, 64), 1.0).cacheKey());
+}
+
+TEST_F(Test_ImageUtil, memoryCacheKey_test)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString &fileName = dir.filePath("icon.svg");
+    ASSERT_TRUE(QFile::copy(":/res/dde-calendar.svg", fileName));
+    // 从资源文件拷贝出来的文件是只读的
+    ASSERT_TRUE(QFile::setPermissions(fileName, QFile::ReadOwner | QFile::WriteOwner));
+
+    QFile file(fileName);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(QDateTime::fromSecsSinceEpoch(1000), QFileDevice::FileModificationTime));
+    const QString &key = ImageUtil::memoryCacheKey("dde-calendar", fileName, QSize(64, 64), 1.0);
+    EXPECT_EQ(key, ImageUtil::memoryCacheKey("dde-calendar", fileName, QSize(64, 64), 1.0));
+
+    // 本地图标修改后不再使用之前的内存缓存
+    ASSERT_TRUE(file.setFileTime(QDateTime::fromSecsSinceEpoch(2000), QFileDevice::FileModificationTime));
+    EXPECT_NE(key, ImageUtil::memoryCacheKey("dde-calendar", fileName, QSize(64, 64), 1.0));
+}
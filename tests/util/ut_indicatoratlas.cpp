@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "indicatoratlas.h"
+
+#include <gtest/gtest.h>
+
+class Ut_IndicatorAtlas : public ::testing::Test
+{
+};
+
+TEST_F(Ut_IndicatorAtlas, indicator_test)
+{
+    IndicatorAtlas *atlas = IndicatorAtlas::instance();
+
+    const QPixmap &horizontal = atlas->indicator(DGuiApplicationHelper::LightType, Dock::Bottom, false, 1);
+    ASSERT_FALSE(horizontal.isNull());
+
+    // 同一参数返回同一份缓存
+    EXPECT_EQ(atlas->indicator(DGuiApplicationHelper::LightType, Dock::Top, false, 1).cacheKey(), horizontal.cacheKey());
+
+    const QPixmap &vertical = atlas->indicator(DGuiApplicationHelper::LightType, Dock::Left, false, 1);
+    EXPECT_NE(vertical.cacheKey(), horizontal.cacheKey());
+
+    const QPixmap &scaled = atlas->indicator(DGuiApplicationHelper::LightType, Dock::Bottom, false, 2);
+    EXPECT_EQ(scaled.size(), horizontal.size() * 2);
+    EXPECT_EQ(scaled.devicePixelRatioF(), 2);
+}
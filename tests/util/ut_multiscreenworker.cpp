@@ -316,3 +316,23 @@ TEST_F(Test_MultiScreenWorker, screenworker_test3)
     delete worker;
     ASSERT_TRUE(true);
 }
+
+TEST_F(Test_MultiScreenWorker, edgeRects_test)
+{
+    const QList<QRect> screenRects = { QRect(0, 0, 1920, 1080), QRect(1920, 0, 1280, 1024) };
+
+    const QList<MonitRect> bottomRects = MultiScreenWorker::edgeRects(screenRects, Dock::Position::Bottom, 15);
+    ASSERT_EQ(bottomRects.size(), 2);
+    EXPECT_TRUE(bottomRects[0] == (MonitRect { 0, 1065, 1920, 1080 }));
+    EXPECT_TRUE(bottomRects[1] == (MonitRect { 1920, 1009, 3200, 1024 }));
+
+    const QList<MonitRect> leftRects = MultiScreenWorker::edgeRects(screenRects, Dock::Position::Left, 40);
+    EXPECT_TRUE(leftRects[0] == (MonitRect { 0, 0, 40, 1080 }));
+
+    const QList<MonitRect> rightRects = MultiScreenWorker::edgeRects(screenRects, Dock::Position::Right, 40);
+    EXPECT_TRUE(rightRects[1] == (MonitRect { 3160, 0, 3200, 1024 }));
+
+    // 复制模式下多个屏幕的区域相同，只注册一次
+    const QList<QRect> copyRects = { QRect(0, 0, 1920, 1080), QRect(0, 0, 1920, 1080) };
+    EXPECT_EQ(MultiScreenWorker::edgeRects(copyRects, Dock::Position::Top, 15).size(), 1);
+}
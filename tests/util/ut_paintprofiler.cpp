@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "paintprofiler.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <gtest/gtest.h>
+
+class Ut_PaintProfiler : public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        PaintProfiler::instance()->reset();
+    }
+
+    static QJsonObject item(const QString &key)
+    {
+        const QJsonArray &items = QJsonDocument::fromJson(PaintProfiler::instance()->report().toUtf8()).object().value("items").toArray();
+        for (const QJsonValue &value : items) {
+            if (value.toObject().value("key").toString() == key)
+                return value.toObject();
+        }
+        return QJsonObject();
+    }
+};
+
+TEST_F(Ut_PaintProfiler, bucketIndex_test)
+{
+    EXPECT_EQ(PaintProfiler::bucketIndex(0), 0);
+    EXPECT_EQ(PaintProfiler::bucketIndex(49 * 1000), 0);
+    EXPECT_EQ(PaintProfiler::bucketIndex(50 * 1000), 1);
+    EXPECT_EQ(PaintProfiler::bucketIndex(1500 * 1000), 5);
+    EXPECT_EQ(PaintProfiler::bucketIndex(100 * 1000 * 1000), PAINT_HISTOGRAM_SIZE - 1);
+}
+
+TEST_F(Ut_PaintProfiler, record_test)
+{
+    PaintProfiler *profiler = PaintProfiler::instance();
+    PaintProfiler::Stats *stats = profiler->stats("ut_item");
+    EXPECT_EQ(stats, profiler->stats("ut_item"));
+
+    profiler->recordPaint(stats, 20 * 1000);
+    profiler->recordPaint(stats, 3000 * 1000);
+    profiler->recordRepaint(stats);
+    profiler->recordLayout(stats);
+
+    const QJsonObject &result = item("ut_item");
+    ASSERT_FALSE(result.isEmpty());
+    EXPECT_EQ(result.value("paints").toInt(), 3);
+    EXPECT_EQ(result.value("layouts").toInt(), 1);
+    EXPECT_DOUBLE_EQ(result.value("maxUs").toDouble(), 3000.0);
+    EXPECT_DOUBLE_EQ(result.value("avgUs").toDouble(), 1510.0);
+
+    const QJsonArray &histogram = result.value("histogram").toArray();
+    ASSERT_EQ(histogram.size(), PAINT_HISTOGRAM_SIZE);
+    EXPECT_EQ(histogram.at(0).toInt(), 1);
+    EXPECT_EQ(histogram.at(6).toInt(), 1);
+
+    profiler->reset();
+    EXPECT_TRUE(item("ut_item").isEmpty());
+}
+
+TEST_F(Ut_PaintProfiler, release_test)
+{
+    PaintProfiler *profiler = PaintProfiler::instance();
+    PaintProfiler::Stats *stats = profiler->stats("ut_release");
+    profiler->stats("ut_release");
+    profiler->recordLayout(stats);
+
+    // 还有一个使用者时统计项仍然保留
+    profiler->release(stats);
+    EXPECT_FALSE(item("ut_release").isEmpty());
+
+    profiler->release(stats);
+    EXPECT_TRUE(item("ut_release").isEmpty());
+}
@@ -7,10 +7,14 @@
 #include <QApplication>
 #include <QSignalSpy>
 #include <QTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRegExp>
 
 #include <gtest/gtest.h>
 
 #include "pluginloader.h"
+#include "constants.h"
 
 class Test_PluginLoader : public QObject, public ::testing::Test
 {
@@ -36,3 +40,61 @@ TEST_F(Test_PluginLoader, loader_test)
 {
     loader->start();
 }
+
+TEST_F(Test_PluginLoader, sortPlugins_test)
+{
+    QMap<QString, QJsonObject> pluginMetaData;
+    pluginMetaData.insert("/plugins/libb.so", QJsonObject());
+    pluginMetaData.insert("/plugins/liba.so", QJsonObject());
+    pluginMetaData.insert("/plugins/libsound.so", QJsonObject {{"order", 2}});
+    pluginMetaData.insert("/plugins/libpluginmanager.so", QJsonObject {{"order", 0}});
+
+    const QStringList plugins = PluginLoader::sortPlugins(pluginMetaData);
+    const QStringList expected { "/plugins/libpluginmanager.so", "/plugins/libsound.so", "/plugins/liba.so", "/plugins/libb.so" };
+    ASSERT_EQ(plugins, expected);
+}
+
+TEST_F(Test_PluginLoader, timings_test)
+{
+    PluginLoader::recordInitTime("/plugins/libtest.so", 5);
+
+    const PluginTiming &timing = PluginLoader::timings().value("/plugins/libtest.so");
+    ASSERT_EQ(timing.initMSecs, 5);
+    ASSERT_EQ(timing.loadMSecs, -1);
+}
+
+TEST_F(Test_PluginLoader, timingReport_test)
+{
+    PluginLoader::recordInitTime("/plugins/libreport.so", 3);
+
+    const QJsonArray &items = QJsonDocument::fromJson(PluginLoader::timingReport().toUtf8()).object().value("plugins").toArray();
+    bool found = false;
+    for (const QJsonValue &value : items) {
+        const QJsonObject &item = value.toObject();
+        if (item.value("plugin").toString() != "/plugins/libreport.so")
+            continue;
+
+        found = true;
+        ASSERT_EQ(item.value("initMs").toInt(), 3);
+        ASSERT_EQ(item.value("loadMs").toInt(), -1);
+    }
+
+    ASSERT_TRUE(found);
+}
+
+TEST_F(Test_PluginLoader, isCompatibleApi_test)
+{
+    ASSERT_TRUE(PluginLoader::isCompatibleApi(DOCK_PLUGIN_API_VERSION));
+    ASSERT_TRUE(PluginLoader::isCompatibleApi("1.2"));
+    ASSERT_FALSE(PluginLoader::isCompatibleApi(QString()));
+    ASSERT_FALSE(PluginLoader::isCompatibleApi("0.9"));
+}
+
+TEST_F(Test_PluginLoader, neededLibraries_test)
+{
+    // 测试程序本身链接了QtCore，读取依赖时不加载动态库
+    const QStringList &libraries = PluginLoader::neededLibraries(QCoreApplication::applicationFilePath());
+    ASSERT_FALSE(libraries.filter(QRegExp("^libQt5Core\\.so")).isEmpty());
+
+    ASSERT_TRUE(PluginLoader::neededLibraries(QString()).isEmpty());
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "sharedinstance.h"
+
+#include <gtest/gtest.h>
+
+#define TEST_SHARED_INSTANCE_PROPERTY "_dock_ut_shared_instance"
+
+class Ut_SharedInstance : public ::testing::Test
+{
+};
+
+TEST_F(Ut_SharedInstance, sharedInstance_test)
+{
+    int created = 0;
+    auto create = [ & ] { ++created; return new int(42); };
+
+    // 第二次获取(相当于插件中的另一份代码)时使用第一次创建的实例
+    int *first = Utils::sharedInstance<int>(TEST_SHARED_INSTANCE_PROPERTY, create);
+    int *second = Utils::sharedInstance<int>(TEST_SHARED_INSTANCE_PROPERTY, create);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(created, 1);
+
+    qApp->setProperty(TEST_SHARED_INSTANCE_PROPERTY, QVariant());
+    delete first;
+}
+
+TEST_F(Ut_SharedInstance, monotonicNs_test)
+{
+    const qint64 first = Utils::monotonicNs();
+    const qint64 second = Utils::monotonicNs();
+    EXPECT_GT(first, 0);
+    EXPECT_GE(second, first);
+}
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "spantracer.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+class Ut_SpanTracer : public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        SpanTracer::instance()->clear();
+    }
+
+    virtual void TearDown() override
+    {
+        SpanTracer::instance()->setEnabled(false);
+        SpanTracer::instance()->clear();
+    }
+
+    static QJsonArray events(const QString &name)
+    {
+        QJsonArray result;
+        const QJsonArray &traceEvents = QJsonDocument::fromJson(SpanTracer::instance()->toChromeTrace()).object().value("traceEvents").toArray();
+        for (const QJsonValue &value : traceEvents) {
+            if (value.toObject().value("name").toString() == name)
+                result << value;
+        }
+        return result;
+    }
+};
+
+TEST_F(Ut_SpanTracer, disabled_test)
+{
+    SpanTracer::instance()->setEnabled(false);
+    {
+        DOCK_TRACE_SCOPE("disabledScope");
+    }
+
+    EXPECT_TRUE(events("disabledScope").isEmpty());
+}
+
+TEST_F(Ut_SpanTracer, scope_test)
+{
+    SpanTracer::instance()->setEnabled(true);
+    {
+        DOCK_TRACE_SCOPE_ARG("scope", QString("plugin"));
+    }
+    SpanTracer::instance()->addInstant("instant");
+
+    const QJsonArray &scopes = events("scope");
+    ASSERT_EQ(scopes.size(), 1);
+    const QJsonObject &scope = scopes.first().toObject();
+    EXPECT_EQ(scope.value("ph").toString(), QString("X"));
+    EXPECT_GE(scope.value("dur").toDouble(), 0.0);
+    EXPECT_EQ(scope.value("args").toObject().value("arg").toString(), QString("plugin"));
+
+    const QJsonArray &instants = events("instant");
+    ASSERT_EQ(instants.size(), 1);
+    EXPECT_EQ(instants.first().toObject().value("ph").toString(), QString("i"));
+}
+
+TEST_F(Ut_SpanTracer, ringbuffer_test)
+{
+    SpanTracer::instance()->setEnabled(true);
+    for (int i = 0; i < 5000; ++i)
+        SpanTracer::instance()->addInstant("ring");
+
+    // 每个线程最多保留4096条记录
+    EXPECT_EQ(events("ring").size(), 4096);
+}
+
+TEST_F(Ut_SpanTracer, threadExit_test)
+{
+    SpanTracer *tracer = SpanTracer::instance();
+    tracer->setEnabled(true);
+
+    const int liveCount = tracer->m_threadBuffers.size();
+    for (int i = 0; i < 20; ++i) {
+        std::thread thread([ tracer ] { tracer->addInstant("worker"); });
+        thread.join();
+    }
+
+    // 线程退出后不再按线程id索引，已退出线程的缓冲区个数有上限，但最近的记录仍然可以导出
+    EXPECT_EQ(tracer->m_threadBuffers.size(), liveCount);
+    EXPECT_LE(tracer->m_buffers.size(), liveCount + 8);
+    EXPECT_EQ(events("worker").size(), 8);
+}
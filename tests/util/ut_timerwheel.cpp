@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "timerwheel.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+#include <QTimer>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+class Ut_TimerWheel : public ::testing::Test
+{
+};
+
+TEST_F(Ut_TimerWheel, schedule_test)
+{
+    TimerWheel *wheel = TimerWheel::instance();
+    QObject context;
+
+    QList<int> fired;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    wheel->schedule(20, &context, [ & ] { fired << 1; });
+    wheel->schedule(20, &context, [ & ] { fired << 2; });
+    wheel->schedule(800, &context, [ & ] { fired << 3; });
+
+    // 所有任务共用同一个定时器
+    ASSERT_TRUE(wheel->m_timer->isActive());
+    EXPECT_EQ(wheel->pendingCount(), 3);
+
+    QTRY_COMPARE_WITH_TIMEOUT(fired.size(), 2, 1000);
+    EXPECT_TRUE(fired.contains(1));
+    EXPECT_TRUE(fired.contains(2));
+
+    // 超过第0层范围的任务降级后按时触发
+    QTRY_COMPARE_WITH_TIMEOUT(fired.size(), 3, 2000);
+    EXPECT_GE(elapsed.elapsed(), 800);
+
+    // 没有任务时定时器停止
+    EXPECT_EQ(wheel->pendingCount(), 0);
+    EXPECT_FALSE(wheel->m_timer->isActive());
+}
+
+TEST_F(Ut_TimerWheel, cancel_test)
+{
+    TimerWheel *wheel = TimerWheel::instance();
+
+    bool fired = false;
+    QObject *context = new QObject;
+    const int id = wheel->schedule(20, context, [ & ] { fired = true; });
+    EXPECT_TRUE(wheel->isPending(id));
+
+    wheel->cancel(id);
+    EXPECT_FALSE(wheel->isPending(id));
+    EXPECT_FALSE(wheel->m_timer->isActive());
+
+    // 对象销毁后任务不再执行
+    wheel->schedule(20, context, [ & ] { fired = true; });
+    delete context;
+
+    QTest::qWait(100);
+    EXPECT_FALSE(fired);
+    EXPECT_EQ(wheel->pendingCount(), 0);
+}
+
+TEST_F(Ut_TimerWheel, wheelTimer_test)
+{
+    QObject context;
+    int count = 0;
+    WheelTimer timer(&context, 50, [ & ] { ++count; });
+
+    EXPECT_FALSE(timer.isActive());
+    timer.start();
+    EXPECT_TRUE(timer.isActive());
+
+    // 重新开始时只触发一次
+    timer.start();
+    QTRY_COMPARE_WITH_TIMEOUT(count, 1, 1000);
+    EXPECT_FALSE(timer.isActive());
+
+    timer.start();
+    timer.stop();
+    QTest::qWait(100);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(Ut_TimerWheel, queuedCallback_test)
+{
+    TimerWheel *wheel = TimerWheel::instance();
+    QObject context;
+
+    // 到期的任务投递到事件队列，执行之前仍然可以取消
+    bool fired = false;
+    const int id = wheel->schedule(0, &context, [ & ] { fired = true; });
+    wheel->expire(QSet<int> { id });
+    EXPECT_FALSE(fired);
+    EXPECT_TRUE(wheel->isPending(id));
+
+    wheel->cancel(id);
+    QTest::qWait(50);
+    EXPECT_FALSE(fired);
+    EXPECT_FALSE(wheel->isPending(id));
+
+    const int nextId = wheel->schedule(0, &context, [ & ] { fired = true; });
+    wheel->expire(QSet<int> { nextId });
+    QTRY_VERIFY_WITH_TIMEOUT(fired, 1000);
+    EXPECT_FALSE(wheel->isPending(nextId));
+}
+
+TEST_F(Ut_TimerWheel, nextIdWrap_test)
+{
+    TimerWheel *wheel = TimerWheel::instance();
+    QObject context;
+
+    // id达到最大值后从1重新开始
+    wheel->m_nextId = std::numeric_limits<int>::max();
+    const int id = wheel->schedule(1000, &context, [] {});
+    EXPECT_EQ(id, 1);
+    wheel->cancel(id);
+}
@@ -63,4 +63,11 @@ TEST_F(Ut_Utils, renderSVG_test)
 TEST_F(Ut_Utils, gsettings_test)
 {
     ASSERT_FALSE(Utils::SettingValue("", "").isValid());
+    ASSERT_EQ(Utils::SettingValue("", "", "key", 1).toInt(), 1);
+    ASSERT_FALSE(Utils::SettingSaveValue("", "", "key", 1));
+
+    // 未安装的schema同样只查询一次
+    ASSERT_EQ(Utils::SettingsRegistry::instance()->settings(""), nullptr);
+    ASSERT_FALSE(Utils::SettingsRegistry::instance()->contains("", "", "key"));
+    ASSERT_EQ(Utils::SettingsRegistry::instance()->value<int>("", "", "key", 2), 2);
 }
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "windowthumbnailmanager.h"
+
+#include <QImage>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+class Ut_WindowThumbnailManager : public ::testing::Test
+{
+};
+
+TEST_F(Ut_WindowThumbnailManager, readThumbnail_test)
+{
+    QImage source(800, 600, QImage::Format_ARGB32);
+    source.fill(Qt::red);
+
+    int fd[2];
+    ASSERT_EQ(pipe(fd), 0);
+    ASSERT_EQ(write(fd[1], source.constBits(), static_cast<size_t>(source.sizeInBytes())), source.sizeInBytes());
+    close(fd[1]);
+
+    QVariantMap imageInfo;
+    imageInfo["width"] = source.width();
+    imageInfo["height"] = source.height();
+    imageInfo["stride"] = source.bytesPerLine();
+    imageInfo["format"] = static_cast<uint>(source.format());
+
+    // 缩放到预览图大小，并保持宽高比
+    const QImage thumbnail = WindowThumbnailManager::readThumbnail(fd[0], imageInfo, QSize(200, 130));
+    ASSERT_FALSE(thumbnail.isNull());
+    ASSERT_EQ(thumbnail.size(), QSize(173, 130));
+    ASSERT_EQ(thumbnail.pixelColor(10, 10), QColor(Qt::red));
+}
+
+TEST_F(Ut_WindowThumbnailManager, readThumbnail_invalid_test)
+{
+    int fd[2];
+    ASSERT_EQ(pipe(fd), 0);
+    close(fd[1]);
+
+    // 数据不完整时返回空图像
+    QVariantMap imageInfo;
+    imageInfo["width"] = 100;
+    imageInfo["height"] = 100;
+    imageInfo["stride"] = 400;
+    imageInfo["format"] = static_cast<uint>(QImage::Format_ARGB32);
+    ASSERT_TRUE(WindowThumbnailManager::readThumbnail(fd[0], imageInfo, QSize(200, 130)).isNull());
+}
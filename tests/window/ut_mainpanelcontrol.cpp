@@ -328,3 +328,35 @@ TEST_F(Test_MainPanelControl, addItem)
 
     ASSERT_TRUE(true);
 }
+
+TEST_F(Test_MainPanelControl, requestResizeDockIcon)
+{
+    MainPanelControl panel;
+    QCoreApplication::processEvents();
+    ASSERT_FALSE(panel.m_resizeIconRequested);
+
+    // 连续请求只会在下一次事件循环中计算一次
+    for (int i = 0; i < 40; ++i)
+        panel.requestResizeDockIcon();
+
+    ASSERT_TRUE(panel.m_resizeIconRequested);
+    QCoreApplication::processEvents();
+    ASSERT_FALSE(panel.m_resizeIconRequested);
+
+    // 立即计算后，之前合并的请求不再重复计算
+    panel.requestResizeDockIcon();
+    panel.resizeDockIcon();
+    ASSERT_FALSE(panel.m_resizeIconRequested);
+}
+
+TEST_F(Test_MainPanelControl, setItemFixedSize)
+{
+    QWidget widget;
+    ASSERT_TRUE(MainPanelControl::setItemFixedSize(&widget, QSize(40, 40)));
+    ASSERT_EQ(widget.size(), QSize(40, 40));
+
+    // 大小没有变化时不重新设置
+    ASSERT_FALSE(MainPanelControl::setItemFixedSize(&widget, QSize(40, 40)));
+    ASSERT_TRUE(MainPanelControl::setItemFixedSize(&widget, QSize(36, 36)));
+    ASSERT_FALSE(MainPanelControl::setItemFixedSize(nullptr, QSize(36, 36)));
+}